@@ -1,281 +1,5362 @@
 #include "discorde.h"
+#include "discorde_internal.h"
 #include <stdlib.h>
 #include <stdbool.h>
-#include <time.h>
 #include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
 #include <concorde.h>
 
 
-int concorde(int n_nodes, int n_edges, int* edges, int* edges_costs,
-             int* out_tour, double* out_cost, int* out_status,
-             int* in_tour, bool verbose, double* time_limit, double* target)
-{
-
-    /* Auxiliary variables */
-    time_t timestamp;
-    int return_value;
-
-    /* Variables and structures used by Concorde solver */
-    double* in_cost;    /* Initial upper bound (optional) */
-    char* filename;     /* Name of temporary files created by Concorde */
-    int silent;         /* Verbosity level */
-    int success;        /* Output flag: set to 1 if a feasible tour is found */
-    int optimal;        /* Output flag: set to 1 if tour found is optimal */
-    int hit_timelimit;  /* Output flag: set to 1 if the time limit is reached */
-    CCrandstate rstate; /* Rand state structure defined by Concorde library */
-
-    /* Initialize Concorde structures */
-    CCutil_sprand(rand(), &rstate);
-
-    /* Initial upper bound as NULL (a feasible tour may be set in its place) */
-    in_cost = NULL;
-
-    /* Set a name for temporary files created by Concorde */
-    filename = (char*) malloc(sizeof(char) * 1024);
-    timestamp = time(NULL);
-    sprintf(filename, "concorde_%ld", timestamp);
+/*
+ * Largest number of edges of a list given to Concorde. Concorde stores the 2 * n_edges endpoints of a list of edges in
+ * an array indexed by {@code int}.
+ */
+#define EDGES_MAX (INT_MAX / 2)
 
-    /* Verbosity level */
-    silent = verbose ? 0 : 1;
+/*
+ * Allocate an array of {@code count} elements of {@code size} bytes. Returns NULL if the allocation fails or if its
+ * size in bytes does not fit in {@code size_t}. An empty array is allocated as a single element, so NULL always means
+ * failure.
+ */
+static void* alloc_array(size_t count, size_t size)
+{
+    if (count == 0) {
+        count = 1;
+    }
+    if (count > ((size_t) -1) / size) {
+        return NULL;
+    }
 
-    /* Call Concorde solver */
-    CCtsp_solve_sparse(n_nodes, n_edges, edges, edges_costs, in_tour,
-                       out_tour, in_cost, out_cost, &optimal, &success, filename, time_limit,
-                       &hit_timelimit, silent, &rstate);
+    return malloc(count * size);
+}
 
-    /* Set solver status */
+/*
+ * Translate the output flags of Concorde solver into Discorde status code and return value. Concorde reports a run
+ * cancelled by its monitor (if any) as having reached its time limit.
+ */
+static int concorde_result(int success, int optimal, int hit_timelimit, double* out_cost,
+                           int* out_status, double* target, discorde_monitor* monitor)
+{
     if (out_status != NULL) {
         if (success == 1 && optimal != 0) {
             *out_status = DISCORDE_STATUS_OPTIMAL;
+        } else if (hit_timelimit == 1 && discorde_monitor_cancelled(monitor)) {
+            *out_status = DISCORDE_STATUS_CANCELLED;
         } else if (hit_timelimit == 1) {
             *out_status = DISCORDE_STATUS_TIMELIMIT;
-        } else if (success == 1 && *out_cost <= *target) {
+        } else if (success == 1 && target != NULL && *out_cost <= *target) {
             *out_status = DISCORDE_STATUS_TARGET;
         } else {
             *out_status = DISCORDE_STATUS_UNKNOWN;
         }
     }
 
-    /* Set the return value */
-    if (success == 1) {
-        return_value = DISCORDE_RETURN_OK;
-    } else {
-        return_value = DISCORDE_RETURN_FAILURE;
-    }
+    return (success == 1) ? DISCORDE_RETURN_OK : DISCORDE_RETURN_FAILURE;
+}
 
-    /* Free resources */
-    free(filename);
+/*
+ * Number of solver calls started so far by the process. It tells apart the temporary files and the random streams of
+ * calls running concurrently, so it is guarded by a mutex (as is the scratch directory, see discorde_scratch.c).
+ */
+static unsigned long call_counter = 0;
+static pthread_mutex_t call_counter_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Concorde branch-and-cut runs on top of the LP solver it has been built with. If that LP solver is not reentrant,
+ * define DISCORDE_SERIALIZE_CONCORDE (CMake option of the same name) so branch-and-cut calls run one at a time. The
+ * Lin-Kernighan heuristic does not use the LP solver and is never serialized.
+ */
+#ifdef DISCORDE_SERIALIZE_CONCORDE
+static pthread_mutex_t concorde_lock = PTHREAD_MUTEX_INITIALIZER;
+#define CONCORDE_LOCK()   pthread_mutex_lock(&concorde_lock)
+#define CONCORDE_UNLOCK() pthread_mutex_unlock(&concorde_lock)
+#else
+#define CONCORDE_LOCK()
+#define CONCORDE_UNLOCK()
+#endif
+
+/*
+ * Return a number unique to this call within the process.
+ */
+static unsigned long next_call_id(void)
+{
+    unsigned long call_id;
+
+    pthread_mutex_lock(&call_counter_lock);
+    call_id = ++call_counter;
+    pthread_mutex_unlock(&call_counter_lock);
+
+    return call_id;
+}
+
+/*
+ * Seed of the random number generator of a call, mixed from its call id. Each call owns its random state, so calls
+ * running concurrently never share (nor race on) the global state of {@code rand()}, and a program that makes the same
+ * sequence of calls gets the same seeds on every run.
+ */
+static int call_seed(unsigned long call_id)
+{
+    unsigned long z;
+
+    z = call_id * 0x9E3779B9UL;
+    z = ((z >> 16) ^ z) * 0x45D9F3BUL;
+    z = ((z >> 16) ^ z) * 0x45D9F3BUL;
+    z = (z >> 16) ^ z;
+
+    return (int) (z & 0x7FFFFFFFUL);
+}
+
+/*
+ * Set the solver status of a call that failed before (or without) running the solver, and return its error code.
+ */
+static int concorde_error(int return_value, int* out_status)
+{
+    if (out_status != NULL) {
+        *out_status = DISCORDE_STATUS_UNKNOWN;
+    }
 
     return return_value;
 }
 
-int concorde_sparse(int n_nodes, int n_edges, int** edges, int* edges_costs,
-                    int* out_tour, double* out_cost, int* out_status,
-                    int* in_tour, bool verbose, double* time_limit, double* target)
+/*
+ * Translate a Discorde norm into the corresponding Concorde norm. Returns 0 if the norm is not supported.
+ */
+static int concorde_norm(int norm)
 {
+    switch (norm) {
+        case DISCORDE_NORM_EUCLIDEAN:      return CC_EUCLIDEAN;
+        case DISCORDE_NORM_EUCLIDEAN_CEIL: return CC_EUCLIDEAN_CEIL;
+        case DISCORDE_NORM_EUCLIDEAN_3D:   return CC_EUCLIDEAN_3D;
+        case DISCORDE_NORM_MAX:            return CC_MAXNORM;
+        case DISCORDE_NORM_MANHATTAN:      return CC_MANNORM;
+        case DISCORDE_NORM_ATT:            return CC_ATT;
+        case DISCORDE_NORM_GEOGRAPHIC:     return CC_GEOGRAPHIC;
+        case DISCORDE_NORM_GEOM:           return CC_GEOM;
+        default:                           return 0;
+    }
+}
 
-    /* Auxiliary variables */
-    int i, index_edge;
-    int return_value;
+/*
+ * Initialize a Concorde datagroup over the coordinates given by the caller. The coordinate arrays are borrowed, not
+ * copied, so the datagroup must be released with {@code coords_dat_free}. Returns 0 on success.
+ */
+static int coords_dat_init(int n_nodes, double* x, double* y, double* z, int norm, CCdatagroup* dat)
+{
+    int cc_norm;
 
-    /* Variables to format data as required by Concorde solver */
-    int* edges_list;
+    CCutil_init_datagroup(dat);
 
-    /* Create a list of edges as used by Concorde solver */
-    edges_list = (int*) malloc(sizeof(int) * n_edges * 2);
-    index_edge = 0;
-    for (i = 0; i < n_edges; ++i) {
-        edges_list[index_edge++] = edges[i][0];
-        edges_list[index_edge++] = edges[i][1];
+    cc_norm = concorde_norm(norm);
+    if (cc_norm == 0 || n_nodes < 3 || x == NULL || y == NULL) {
+        return 1;
+    }
+    if ((cc_norm & CC_NORM_SIZE_BITS) == CC_D3_NORM_SIZE && z == NULL) {
+        return 1;
     }
 
-    /* Call Concorde solver */
-    return_value = concorde(n_nodes, n_edges, edges_list, edges_costs, out_tour,
-                            out_cost, out_status, in_tour, verbose, time_limit, target);
+    dat->x = x;
+    dat->y = y;
+    dat->z = ((cc_norm & CC_NORM_SIZE_BITS) == CC_D3_NORM_SIZE) ? z : NULL;
 
-    /* Free resources */
-    free(edges_list);
+    return CCutil_dat_setnorm(dat, cc_norm);
+}
 
-    return return_value;
+/*
+ * Release a datagroup created by {@code coords_dat_init} without freeing the caller's coordinates.
+ */
+static void coords_dat_free(CCdatagroup* dat)
+{
+    dat->x = NULL;
+    dat->y = NULL;
+    dat->z = NULL;
+    CCutil_freedatagroup(dat);
 }
 
-int concorde_full(int n_nodes, int** cost_matrix,
-                  int* out_tour, double* out_cost, int* out_status,
-                  int* in_tour, bool verbose, double* time_limit, double* target)
+/*
+ * Layouts of the cost matrices given by the caller.
+ */
+#define MATRIX_ROWS   0     /* Array of row pointers */
+#define MATRIX_FLAT   1     /* Contiguous row-major buffer of n * n entries */
+#define MATRIX_PACKED 2     /* Upper triangle packed row by row into n(n-1)/2 entries */
+
+/*
+ * Read-only view over a cost matrix given by the caller. Only the upper triangle (i < j) is ever read.
+ */
+typedef struct matrix_view {
+    int layout;
+    int n_nodes;
+    int** rows;         /* Used by MATRIX_ROWS */
+    const int* data;    /* Used by MATRIX_FLAT and MATRIX_PACKED */
+} matrix_view;
+
+/*
+ * Return the upper part of row {@code i} (columns j > i) of the matrix. The cost of edge (i,j) is
+ * {@code row[j - *shift]}, so the row can be scanned without any per-element index computation.
+ */
+static const int* matrix_row(const matrix_view* matrix, int i, size_t* shift)
 {
+    size_t n;
 
-    /* Auxiliary variables */
-    int i, j, index_edge, index_cost;
-    int return_value;
+    n = (size_t) matrix->n_nodes;
+    switch (matrix->layout) {
+        case MATRIX_FLAT:
+            *shift = 0;
+            return matrix->data + (size_t) i * n;
+        case MATRIX_PACKED:
+            *shift = (size_t) i + 1;
+            return matrix->data + (size_t) i * n - ((size_t) i * ((size_t) i + 1)) / 2;
+        default:
+            *shift = 0;
+            return matrix->rows[i];
+    }
+}
 
-    /* Variables to format data as required by Concorde solver */
-    int n_edges;            /* Number of edges */
-    int* edges_list;        /* List of edges (unidimensional) */
-    int* edges_costs;       /* Edges costs */
+/*
+ * Side of the square tiles used to transpose the upper triangle given by the caller into the lower triangle used by
+ * Concorde. A tile of 64 by 64 entries of each matrix fits in L1/L2 caches.
+ */
+#define MATRIX_TILE 64
 
-    /* Calculate the number of edges */
-    n_edges = ((n_nodes * (n_nodes + 1)) / 2) - n_nodes;
+/*
+ * Work shared by the threads that copy a cost matrix into a Concorde datagroup.
+ */
+typedef struct matrix_copy {
+    const matrix_view* matrix;
+    CCdatagroup* dat;
+} matrix_copy;
 
-    /* Allocate resources */
-    edges_costs = (int*) malloc(sizeof(int) * n_edges);
-    edges_list = (int*) malloc(sizeof(int) * 2 * n_edges);
+/*
+ * Copy the tile rows {@code [begin, end)} of the lower triangular matrix used by Concorde. The transposition is done
+ * tile by tile, so both the rows read from the caller's matrix and the rows written into the datagroup stay in cache.
+ */
+static void matrix_dat_tiles(void* arg, int begin, int end)
+{
+    matrix_copy* copy;
+    const int* row;
+    size_t shift;
+    int n, t, i, j, i_begin, i_end, j_begin, j_end;
 
-    /* Initialize the list of edges and costs as used by Concorde solver */
-    index_edge = 0;
-    index_cost = 0;
-    for (i = 0; i < n_nodes; ++i) {
-        for (j = i + 1; j < n_nodes; ++j) {
-            edges_costs[index_cost++] = cost_matrix[i][j];
-            edges_list[index_edge++] = i;
-            edges_list[index_edge++] = j;
+    copy = (matrix_copy*) arg;
+    n = copy->matrix->n_nodes;
+    for (t = begin; t < end; ++t) {
+        i_begin = t * MATRIX_TILE;
+        i_end = (i_begin + MATRIX_TILE < n) ? i_begin + MATRIX_TILE : n;
+        for (j_begin = 0; j_begin < i_end; j_begin += MATRIX_TILE) {
+            j_end = (j_begin + MATRIX_TILE < i_end) ? j_begin + MATRIX_TILE : i_end;
+            for (j = j_begin; j < j_end; ++j) {
+                row = matrix_row(copy->matrix, j, &shift);
+                for (i = (j + 1 > i_begin) ? j + 1 : i_begin; i < i_end; ++i) {
+                    copy->dat->adj[i][j] = row[i - shift];
+                }
+            }
+        }
+        for (i = i_begin; i < i_end; ++i) {
+            copy->dat->adj[i][i] = 0;
         }
     }
+}
 
-    /* Call Concorde solver */
-    return_value = concorde(n_nodes, n_edges, edges_list, edges_costs, out_tour,
-                            out_cost, out_status, in_tour, verbose, time_limit, target);
+/*
+ * Allocate a Concorde datagroup with matrix norm for {@code n_nodes} nodes. The datagroup stores only the n(n+1)/2
+ * entries of a triangular matrix, so edge lengths are queried in constant time and no edge list is required. Returns
+ * {@code DISCORDE_RETURN_OK} on success, or an error code otherwise.
+ */
+static int matrix_dat_alloc(int n_nodes, CCdatagroup* dat)
+{
+    size_t i, n, n_entries;
 
-    /* Free resources */
-    free(edges_list);
-    free(edges_costs);
+    CCutil_init_datagroup(dat);
 
-    return return_value;
+    n = (size_t) n_nodes;
+    n_entries = (n * (n + 1)) / 2;
+    dat->adj = (int**) alloc_array(n, sizeof(int*));
+    dat->adjspace = (int*) alloc_array(n_entries, sizeof(int));
+    if (dat->adj == NULL || dat->adjspace == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    for (i = 0; i < n; ++i) {
+        dat->adj[i] = dat->adjspace + (i * (i + 1)) / 2;
+    }
+
+    if (CCutil_dat_setnorm(dat, CC_MATRIXNORM) != 0) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    return DISCORDE_RETURN_OK;
 }
 
-int linkernighan(int n_nodes, int n_edges, int* edges, int* edges_costs,
-                 int* out_tour, double* out_cost, int* in_tour,
-                 bool verbose, double* time_limit, double* target)
+/*
+ * Copy the upper triangle of a cost matrix into a datagroup allocated by {@code matrix_dat_alloc} for as many nodes.
+ */
+static void matrix_dat_fill(const matrix_view* matrix, CCdatagroup* dat)
 {
+    matrix_copy copy;
 
-    /* Auxiliary variables */
+    copy.matrix = matrix;
+    copy.dat = dat;
+    discorde_parallel_for((matrix->n_nodes + MATRIX_TILE - 1) / MATRIX_TILE, 1, matrix_dat_tiles, &copy);
+}
+
+/*
+ * Initialize a Concorde datagroup with matrix norm from the upper triangle of a cost matrix. Returns
+ * {@code DISCORDE_RETURN_OK} on success, or an error code otherwise.
+ */
+static int matrix_dat_init(const matrix_view* matrix, CCdatagroup* dat)
+{
     int return_value;
 
-    /* Variables and structures used by Lin-Kernighan heuristic */
-    double time_limit_value; /* Time limit */
-    double target_value;     /* target value */
-    int silent;              /* Verbosity level */
-    CCrandstate rstate;      /* Rand state structure (in Concorde library) */
-    CCdatagroup data;        /* Coordinate data defined by Concorde library */
-    int kicktype;            /* Type of kick */
-    int stallcount;          /* Maximum number of 4-swaps without progress */
-    int repeatcount;         /* Number of 4-swap kicks */
+    return_value = matrix_dat_alloc(matrix->n_nodes, dat);
+    if (return_value == DISCORDE_RETURN_OK) {
+        matrix_dat_fill(matrix, dat);
+    }
 
-    /*
-     * Available values for type of kick are:
-     *  - CC_LK_RANDOM_KICK
-     *  - CC_LK_GEOMETRIC_KICK
-     *  - CC_LK_CLOSE_KICK
-     *  - CC_LK_WALK_KICK
-     */
+    return return_value;
+}
 
-    /* Initialize Lin-Kernighan structures */
-    CCutil_sprand(rand(), &rstate);
-    kicktype = CC_LK_RANDOM_KICK;
-    stallcount = 100000000;
-    repeatcount = -1;
+/*
+ * Work shared by the threads that fill the complete list of edges.
+ */
+typedef struct complete_fill {
+    int n_nodes;
+    int* edges;
+} complete_fill;
 
-    /* Initialize the coordinate data */
-    CCutil_init_datagroup (&data);
-    CCutil_graph2dat_sparse(n_nodes, n_edges, edges, edges_costs, 0, &data);
+/*
+ * Fill the rows {@code [begin, end)} of the complete list of edges. The edges of row i start at the same position of
+ * the packed upper triangle, so each row is written independently of the others.
+ */
+static void complete_edges_rows(void* arg, int begin, int end)
+{
+    complete_fill* fill;
+    int* edge;
+    int i, j;
 
-    /* Verbosity */
-    silent = verbose ? 0 : 1;
+    fill = (complete_fill*) arg;
+    for (i = begin; i < end; ++i) {
+        edge = fill->edges + 2 * ((size_t) i * fill->n_nodes - ((size_t) i * ((size_t) i + 1)) / 2);
+        for (j = i + 1; j < fill->n_nodes; ++j) {
+            *edge++ = i;
+            *edge++ = j;
+        }
+    }
+}
 
-    /* Set time limit value */
-    time_limit_value = -1;
-    if (time_limit != NULL) {
-        time_limit_value = *time_limit;
+/*
+ * Build the list of the n(n-1)/2 edges of the complete graph. Returns {@code DISCORDE_RETURN_OK} on success, or an
+ * error code otherwise.
+ */
+static int complete_edges(int n_nodes, int* out_n_edges, int** out_edges)
+{
+    size_t n_edges;
+    complete_fill fill;
+
+    n_edges = ((size_t) n_nodes * ((size_t) n_nodes - 1)) / 2;
+    if (n_edges > EDGES_MAX) {
+        return DISCORDE_RETURN_TOO_LARGE;
     }
 
-    /* Set target value */
-    target_value = -1;
-    if (target != NULL) {
-        target_value = *target;
+    fill.n_nodes = n_nodes;
+    fill.edges = (int*) alloc_array(2 * n_edges, sizeof(int));
+    if (fill.edges == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
     }
 
-    /* Call Lin-Kernighan heuristic */
-    CClinkern_tour(n_nodes, &data, n_edges, edges, stallcount, repeatcount,
-                   in_tour, out_tour, out_cost, silent, time_limit_value, target_value,
-                   NULL, kicktype, &rstate);
+    discorde_parallel_for(n_nodes, 64, complete_edges_rows, &fill);
 
-    /* Deallocate some data structures */
-    CCutil_freedatagroup(&data);
+    *out_n_edges = (int) n_edges;
+    *out_edges = fill.edges;
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Create a view over a cost matrix given by the caller.
+ */
+static matrix_view matrix_view_of(int layout, int n_nodes, int** rows, const int* data)
+{
+    matrix_view matrix;
+
+    matrix.layout = layout;
+    matrix.n_nodes = n_nodes;
+    matrix.rows = rows;
+    matrix.data = data;
+
+    return matrix;
+}
+
+/*
+ * Number of nodes per chunk of the parallel search of the nearest neighbors.
+ */
+#define KNN_GRAIN 16
+
+/*
+ * Work shared by the threads that search the nearest neighbors of each node.
+ */
+typedef struct knn_search {
+    int n_nodes;
+    int k;
+    const matrix_view* matrix;
+    CCdatagroup* dat;
+    int* neighbors;     /* k nearest neighbors of node i at [i * k, (i + 1) * k) */
+    char* failed;       /* Set for each chunk of KNN_GRAIN nodes whose buffer could not be allocated */
+} knn_search;
+
+/*
+ * Restore the max-heap property of the heap given by the arrays of costs and nodes, starting from position {@code i}.
+ */
+static void knn_sift_down(int* costs, int* nodes, int size, int i)
+{
+    int child, cost, node;
+
+    cost = costs[i];
+    node = nodes[i];
+    while ((child = 2 * i + 1) < size) {
+        if (child + 1 < size && costs[child + 1] > costs[child]) {
+            ++child;
+        }
+        if (costs[child] <= cost) {
+            break;
+        }
+        costs[i] = costs[child];
+        nodes[i] = nodes[child];
+        i = child;
+    }
+    costs[i] = cost;
+    nodes[i] = node;
+}
+
+/*
+ * Partial sort of the rows {@code [begin, end)} of the cost matrix: a bounded max-heap keeps the k cheapest edges
+ * incident to each node.
+ */
+static void knn_rows(void* arg, int begin, int end)
+{
+    knn_search* search;
+    const int* row;
+    size_t shift;
+    int i, j, h, size, cost;
+    int* costs;
+    int* nodes;
+
+    search = (knn_search*) arg;
+    costs = (int*) alloc_array((size_t) search->k, sizeof(int));
+    if (costs == NULL) {
+        search->failed[begin / KNN_GRAIN] = 1;
+        return;
+    }
+
+    for (i = begin; i < end; ++i) {
+        nodes = search->neighbors + (size_t) i * search->k;
+        row = matrix_row(search->matrix, i, &shift);
+        size = 0;
+        for (j = 0; j < search->n_nodes; ++j) {
+            if (j == i) {
+                continue;
+            }
+
+            /* Both halves of the row are contiguous: the lower one in the datagroup, the upper one in the input */
+            cost = (j < i) ? search->dat->adj[i][j] : row[j - shift];
+
+            if (size < search->k) {
+                costs[size] = cost;
+                nodes[size] = j;
+                if (++size == search->k) {
+                    for (h = search->k / 2 - 1; h >= 0; --h) {
+                        knn_sift_down(costs, nodes, search->k, h);
+                    }
+                }
+            } else if (cost < costs[0]) {
+                costs[0] = cost;
+                nodes[0] = j;
+                knn_sift_down(costs, nodes, search->k, 0);
+            }
+        }
+    }
+
+    free(costs);
+}
+
+/*
+ * Find the k nearest neighbors of each node of a cost matrix, whose lower triangle has been copied into {@code dat}.
+ * The neighbors of node i are stored at {@code [i * k, (i + 1) * k)} of an array allocated for the caller. Returns
+ * {@code DISCORDE_RETURN_OK} on success, or {@code DISCORDE_RETURN_NO_MEMORY} otherwise.
+ */
+static int knn_neighbors(const matrix_view* matrix, CCdatagroup* dat, int k, int** out_neighbors)
+{
+    int i, n_chunks, failed;
+    knn_search search;
+
+    /* Each chunk has a flag of its own, read once all the threads have joined */
+    n_chunks = (matrix->n_nodes + KNN_GRAIN - 1) / KNN_GRAIN;
+    search.n_nodes = matrix->n_nodes;
+    search.k = k;
+    search.matrix = matrix;
+    search.dat = dat;
+    search.failed = (char*) calloc((size_t) n_chunks, sizeof(char));
+    search.neighbors = (int*) alloc_array((size_t) matrix->n_nodes * k, sizeof(int));
+    if (search.failed == NULL || search.neighbors == NULL) {
+        free(search.failed);
+        free(search.neighbors);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    discorde_parallel_for(matrix->n_nodes, KNN_GRAIN, knn_rows, &search);
+    failed = 0;
+    for (i = 0; i < n_chunks; ++i) {
+        failed = failed || search.failed[i];
+    }
+    free(search.failed);
+    if (failed) {
+        free(search.neighbors);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    *out_neighbors = search.neighbors;
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * List the union of the neighbors of each node, {@code k} per node at {@code [i * k, (i + 1) * k)} of
+ * {@code neighbors}, as a candidate set of Lin-Kernighan heuristic. Each undirected edge is listed only once. Returns
+ * {@code DISCORDE_RETURN_OK} on success, or {@code DISCORDE_RETURN_NO_MEMORY} otherwise.
+ */
+static int neighbors_edges(int n_nodes, int k, const int* neighbors, int* out_n_edges, int** out_edges)
+{
+    int i, j, l, m, n_edges;
+    const int* row;
+    int* edges;
+
+    /* The list holds at most k edges per node */
+    edges = (int*) alloc_array(2 * (size_t) n_nodes * k, sizeof(int));
+    if (edges == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    /* Edge (i,j) is listed by node i unless j < i and it has already been listed by node j */
+    n_edges = 0;
+    for (i = 0; i < n_nodes; ++i) {
+        for (l = 0; l < k; ++l) {
+            j = neighbors[(size_t) i * k + l];
+            if (j < i) {
+                row = neighbors + (size_t) j * k;
+                for (m = 0; m < k && row[m] != i; ++m);
+                if (m < k) {
+                    continue;
+                }
+            }
+            edges[2 * (size_t) n_edges] = i;
+            edges[2 * (size_t) n_edges + 1] = j;
+            ++n_edges;
+        }
+    }
+
+    *out_n_edges = n_edges;
+    *out_edges = edges;
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Build the candidate set of Lin-Kernighan heuristic as the union of the k nearest neighbors of each node. Each
+ * undirected edge is listed only once. Returns {@code DISCORDE_RETURN_OK} on success, or an error code otherwise.
+ */
+static int knn_edges(const matrix_view* matrix, CCdatagroup* dat, int k,
+                     int* out_n_edges, int** out_edges)
+{
+    int return_value;
+    int* neighbors;
 
-    /* Set return value */
-    return_value = DISCORDE_RETURN_OK;
+    /* The list holds at most k edges per node */
+    if ((size_t) matrix->n_nodes * (size_t) k > EDGES_MAX) {
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
+
+    return_value = knn_neighbors(matrix, dat, k, &neighbors);
+    if (return_value == DISCORDE_RETURN_OK) {
+        return_value = neighbors_edges(matrix->n_nodes, k, neighbors, out_n_edges, out_edges);
+        free(neighbors);
+    }
 
     return return_value;
 }
 
-int linkernighan_sparse(int n_nodes, int n_edges, int** edges, int* edges_costs,
-                        int* out_tour, double* out_cost, int* in_tour,
-                        bool verbose, double* time_limit, double* target)
+
+/*
+ * Sparse graph handle. The edges are kept in the format used by Concorde (a list of node pairs and a list of costs), so
+ * the solvers read them in place. When the layout given by the caller already matches that format the arrays are
+ * borrowed, otherwise they are converted once when the handle is created.
+ */
+struct discorde_graph {
+    int n_nodes;
+    int n_edges;
+    int* edges;             /* Array of 2 * n_edges endpoints */
+    int* edges_costs;       /* Array of n_edges costs */
+    int owns_edges;         /* Set to 1 if edges was allocated by the handle */
+    int owns_costs;         /* Set to 1 if edges_costs was allocated by the handle */
+    CCdatagroup* data;      /* Sparse datagroup used by Lin-Kernighan heuristic, built on first use */
+    pthread_mutex_t lock;   /* Guards the construction of data */
+};
+
+static discorde_graph* graph_alloc(int n_nodes, int n_edges)
+{
+    discorde_graph* graph;
+
+    graph = (discorde_graph*) malloc(sizeof(discorde_graph));
+    if (graph == NULL) {
+        return NULL;
+    }
+
+    graph->n_nodes = n_nodes;
+    graph->n_edges = n_edges;
+    graph->edges = NULL;
+    graph->edges_costs = NULL;
+    graph->owns_edges = 0;
+    graph->owns_costs = 0;
+    graph->data = NULL;
+    pthread_mutex_init(&graph->lock, NULL);
+
+    return graph;
+}
+
+int discorde_graph_strided(int n_nodes, int n_edges, const int* edges, size_t edges_stride,
+                           const int* edges_costs, size_t costs_stride, discorde_graph** out_graph)
 {
 
     /* Auxiliary variables */
-    int i, index_edge;
-    int return_value;
+    size_t i;
+    const char* edge;
+    const char* cost;
+    discorde_graph* graph;
 
-    /* Variables to format data as required by Concorde solver */
-    int* edges_list;
+    *out_graph = NULL;
+    if (n_nodes <= 0 || n_edges < 0) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+    if (n_edges > EDGES_MAX) {
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
 
-    /* Create a list of edges as used by Concorde solver */
-    edges_list = (int*) malloc(sizeof(int) * n_edges * 2);
-    index_edge = 0;
-    for (i = 0; i < n_edges; ++i) {
-        edges_list[index_edge++] = edges[i][0];
-        edges_list[index_edge++] = edges[i][1];
+    /* A stride of zero means the arrays are packed */
+    if (edges_stride == 0) {
+        edges_stride = 2 * sizeof(int);
+    }
+    if (costs_stride == 0) {
+        costs_stride = sizeof(int);
     }
 
-    /* Call Lin-Kernighan heuristic */
-    return_value = linkernighan(n_nodes, n_edges, edges_list, edges_costs,
-                                out_tour, out_cost, in_tour, verbose, time_limit, target);
+    graph = graph_alloc(n_nodes, n_edges);
+    if (graph == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
 
-    /* Free resources */
-    free(edges_list);
+    /* Borrow the endpoints if they are already packed as Concorde expects, or gather them otherwise */
+    if (edges_stride == 2 * sizeof(int)) {
+        graph->edges = (int*) edges;
+    } else {
+        graph->edges = (int*) alloc_array(2 * (size_t) n_edges, sizeof(int));
+        graph->owns_edges = 1;
+        if (graph->edges != NULL) {
+            edge = (const char*) edges;
+            for (i = 0; i < (size_t) n_edges; ++i, edge += edges_stride) {
+                graph->edges[2 * i] = ((const int*) edge)[0];
+                graph->edges[2 * i + 1] = ((const int*) edge)[1];
+            }
+        }
+    }
 
-    return return_value;
+    /* The same for the costs */
+    if (costs_stride == sizeof(int)) {
+        graph->edges_costs = (int*) edges_costs;
+    } else {
+        graph->edges_costs = (int*) alloc_array((size_t) n_edges, sizeof(int));
+        graph->owns_costs = 1;
+        if (graph->edges_costs != NULL) {
+            cost = (const char*) edges_costs;
+            for (i = 0; i < (size_t) n_edges; ++i, cost += costs_stride) {
+                graph->edges_costs[i] = *((const int*) cost);
+            }
+        }
+    }
+
+    if (graph->edges == NULL || graph->edges_costs == NULL) {
+        discorde_graph_free(graph);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    *out_graph = graph;
+    return DISCORDE_RETURN_OK;
 }
 
-int linkernighan_full(int n_nodes, int** cost_matrix,
-                      int* out_tour, double* out_cost, int* in_tour, bool verbose,
-                      double* time_limit, double* target)
+int discorde_graph_csr(int n_nodes, const int* offsets, const int* targets, const int* weights,
+                       discorde_graph** out_graph)
 {
 
     /* Auxiliary variables */
-    int i, j, index_edge, index_cost;
-    int return_value;
+    int i, k;
+    size_t n_edges, index_edge;
+    discorde_graph* graph;
 
-    /* Variables to format data as required by Concorde solver */
-    int n_edges;            /* Number of edges */
-    int* edges_list;        /* List of edges (unidimensional) */
-    int* edges_costs;       /* Edges costs */
+    *out_graph = NULL;
+    if (n_nodes <= 0) {
+        return DISCORDE_RETURN_FAILURE;
+    }
 
-    /* Calculate the number of edges */
-    n_edges = ((n_nodes * (n_nodes + 1)) / 2) - n_nodes;
+    /* Each edge of a symmetric adjacency is stored twice: only entries (i,j) with i < j are kept */
+    n_edges = 0;
+    for (i = 0; i < n_nodes; ++i) {
+        for (k = offsets[i]; k < offsets[i + 1]; ++k) {
+            if (targets[k] > i) {
+                ++n_edges;
+            }
+        }
+    }
+
+    if (n_edges > EDGES_MAX) {
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
+
+    graph = graph_alloc(n_nodes, (int) n_edges);
+    if (graph == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
 
-    /* Allocate resources */
-    edges_costs = (int*) malloc(sizeof(int) * n_edges);
-    edges_list = (int*) malloc(sizeof(int) * 2 * n_edges);
+    graph->edges = (int*) alloc_array(2 * n_edges, sizeof(int));
+    graph->edges_costs = (int*) alloc_array(n_edges, sizeof(int));
+    graph->owns_edges = 1;
+    graph->owns_costs = 1;
+    if (graph->edges == NULL || graph->edges_costs == NULL) {
+        discorde_graph_free(graph);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
 
-    /* Initialize the list of edges and costs as used by Concorde solver */
     index_edge = 0;
-    index_cost = 0;
     for (i = 0; i < n_nodes; ++i) {
-        for (j = i + 1; j < n_nodes; ++j) {
-            edges_costs[index_cost++] = cost_matrix[i][j];
-            edges_list[index_edge++] = i;
-            edges_list[index_edge++] = j;
+        for (k = offsets[i]; k < offsets[i + 1]; ++k) {
+            if (targets[k] > i) {
+                graph->edges[2 * index_edge] = i;
+                graph->edges[2 * index_edge + 1] = targets[k];
+                graph->edges_costs[index_edge] = weights[k];
+                ++index_edge;
+            }
         }
     }
 
-    /* Call Lin-Kernighan heuristic */
-    return_value = linkernighan(n_nodes, n_edges, edges_list, edges_costs,
-                                out_tour, out_cost, in_tour, verbose, time_limit, target);
+    *out_graph = graph;
+    return DISCORDE_RETURN_OK;
+}
+
+void discorde_graph_free(discorde_graph* graph)
+{
+    if (graph == NULL) {
+        return;
+    }
+
+    if (graph->owns_edges) {
+        free(graph->edges);
+    }
+    if (graph->owns_costs) {
+        free(graph->edges_costs);
+    }
+    if (graph->data != NULL) {
+        CCutil_freedatagroup(graph->data);
+        free(graph->data);
+    }
+    pthread_mutex_destroy(&graph->lock);
+    free(graph);
+}
+
+/*
+ * Return the sparse datagroup of the graph, building it on the first call. The datagroup is only read afterwards, so
+ * it may be shared by concurrent calls of the Lin-Kernighan heuristic over the same graph.
+ */
+static CCdatagroup* graph_dat(discorde_graph* graph)
+{
+    CCdatagroup* data;
+
+    pthread_mutex_lock(&graph->lock);
+    if (graph->data == NULL) {
+        data = (CCdatagroup*) malloc(sizeof(CCdatagroup));
+        if (data != NULL) {
+            CCutil_init_datagroup(data);
+            if (CCutil_graph2dat_sparse(graph->n_nodes, graph->n_edges, graph->edges, graph->edges_costs,
+                                        0, data) != 0) {
+                CCutil_freedatagroup(data);
+                free(data);
+                data = NULL;
+            }
+        }
+        graph->data = data;
+    }
+    data = graph->data;
+    pthread_mutex_unlock(&graph->lock);
+
+    return data;
+}
+
+
+/*
+ * Time bound given to Concorde when the caller sets no time limit but may need to stop it: Concorde checks its time
+ * bound between the nodes of its branch-and-bound, so setting it to zero makes it return its best tour at the next one,
+ * once its root LP is done (see {@code discorde_watch}).
+ */
+#define CONCORDE_NO_BOUND 1e30
+
+/*
+ * Largest instance solved by the dynamic program of {@code exact_solve} instead of Concorde branch-and-cut. Up to this
+ * size the program takes well under a millisecond, far less than setting up the LP and the files of Concorde.
+ */
+#define EXACT_NODES_MAX 12
+
+/*
+ * Cost of a missing edge (or of a path through one) in the dynamic program.
+ */
+#define EXACT_NO_EDGE 1e300
+
+/*
+ * Solve an instance of at most EXACT_NODES_MAX nodes to optimality with the dynamic program of Held and Karp, over a
+ * datagroup if {@code edges_costs} is NULL or over a list of edges otherwise. Returns {@code DISCORDE_RETURN_OK} if a
+ * tour has been found, {@code DISCORDE_RETURN_FAILURE} if the edges form no tour, or {@code DISCORDE_RETURN_NO_MEMORY}
+ * if memory could not be allocated.
+ */
+static int exact_solve(int n_nodes, CCdatagroup* data, int n_edges, int* edges, int* edges_costs,
+                       int* out_tour, double* out_cost)
+{
+
+    /* Auxiliary variables */
+    int i, j, k, e, m, a, b, best_k, n_members;
+    int members[EXACT_NODES_MAX];   /* Nodes of the current set */
+    size_t set, prev, n_sets;
+    double cost, value;
+
+    /* Structures of the dynamic program, whose paths start at node m = n_nodes - 1 */
+    double costs[EXACT_NODES_MAX][EXACT_NODES_MAX];
+    double* best;           /* best[set * m + j]: cheapest path from node m through the nodes of set, ending at j */
+    signed char* last;      /* last[set * m + j]: node before j on that path, or -1 if it comes right after node m */
+
+    for (i = 0; i < n_nodes; ++i) {
+        for (j = 0; j < n_nodes; ++j) {
+            costs[i][j] = (edges_costs == NULL && i != j) ? CCutil_dat_edgelen(i, j, data) : EXACT_NO_EDGE;
+        }
+    }
+    if (edges_costs != NULL) {
+        for (e = 0; e < n_edges; ++e) {
+            i = edges[2 * e];
+            j = edges[2 * e + 1];
+            if (i >= 0 && i < n_nodes && j >= 0 && j < n_nodes && i != j && edges_costs[e] < costs[i][j]) {
+                costs[i][j] = edges_costs[e];
+                costs[j][i] = edges_costs[e];
+            }
+        }
+    }
+
+    m = n_nodes - 1;
+    n_sets = (size_t) 1 << m;
+    best = (double*) alloc_array(n_sets * (size_t) m, sizeof(double));
+    last = (signed char*) alloc_array(n_sets * (size_t) m, sizeof(signed char));
+    if (best == NULL || last == NULL) {
+        free(best);
+        free(last);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    /* Each set extends the paths of the sets with one node less */
+    for (set = 1; set < n_sets; ++set) {
+        n_members = 0;
+        for (j = 0; j < m; ++j) {
+            if ((set & ((size_t) 1 << j)) != 0) {
+                members[n_members++] = j;
+            }
+        }
+        for (a = 0; a < n_members; ++a) {
+            j = members[a];
+            prev = (set ^ ((size_t) 1 << j)) * (size_t) m;
+            value = (n_members == 1) ? costs[m][j] : EXACT_NO_EDGE;
+            best_k = -1;
+            for (b = 0; b < n_members; ++b) {
+                k = members[b];
+                if (k == j) {
+                    continue;
+                }
+                cost = best[prev + (size_t) k] + costs[k][j];
+                if (cost < value) {
+                    value = cost;
+                    best_k = k;
+                }
+            }
+            best[set * (size_t) m + (size_t) j] = value;
+            last[set * (size_t) m + (size_t) j] = (signed char) best_k;
+        }
+    }
+
+    /* Close the cheapest path through all nodes back to node m */
+    set = n_sets - 1;
+    value = EXACT_NO_EDGE;
+    best_k = -1;
+    for (j = 0; j < m; ++j) {
+        cost = best[set * (size_t) m + (size_t) j] + costs[j][m];
+        if (cost < value) {
+            value = cost;
+            best_k = j;
+        }
+    }
+
+    if (best_k >= 0) {
+        out_tour[0] = m;
+        for (i = m, j = best_k; i >= 1; --i) {
+            out_tour[i] = j;
+            k = last[set * (size_t) m + (size_t) j];
+            set ^= (size_t) 1 << j;
+            j = k;
+        }
+        *out_cost = value;
+    }
+
+    /* Free resources */
+    free(best);
+    free(last);
+
+    return (best_k >= 0) ? DISCORDE_RETURN_OK : DISCORDE_RETURN_FAILURE;
+}
+
+/*
+ * Run Concorde solver once, over a datagroup if {@code edges_costs} is NULL or over a list of edges otherwise, and set
+ * its output flags. The tour {@code in_tour} and its cost {@code in_cost} (both optional) give the initial upper bound.
+ * If {@code monitor} is not NULL, the run is cancelled with it and its tour is reported to it. The random state of the
+ * caller is used if {@code rstate} is not NULL, or a new one seeded for this call otherwise.
+ */
+static void concorde_call(int n_nodes, CCdatagroup* data, int n_edges, int* edges, int* edges_costs,
+                          CCrandstate* rstate, int* in_tour, double* in_cost, int* out_tour, double* out_cost,
+                          bool verbose, double* time_limit, discorde_monitor* monitor, int* success, int* optimal,
+                          int* hit_timelimit)
+{
+
+    /* Auxiliary variables */
+    unsigned long call_id;
+    int exact;
+    double start;
+    double time_bound;      /* Copy of the time limit, zeroed by the monitor to cancel the run */
+    discorde_watch watch;
+
+    /* Variables and structures used by Concorde solver */
+    discorde_scratch scratch;   /* Scratch directory of the run, removed with its files afterwards */
+    int silent;         /* Verbosity level */
+    CCrandstate own_rstate; /* Rand state structure defined by Concorde library */
+
+    /* Small instances are solved at once by a dynamic program, without the LP machinery of Concorde */
+    start = discorde_wall_time();
+    if (n_nodes >= 3 && n_nodes <= EXACT_NODES_MAX) {
+        exact = exact_solve(n_nodes, data, n_edges, edges, edges_costs, out_tour, out_cost);
+        if (exact != DISCORDE_RETURN_NO_MEMORY) {
+            *success = (exact == DISCORDE_RETURN_OK) ? 1 : 0;
+            *optimal = *success;
+            *hit_timelimit = 0;
+            if (monitor != NULL && *success == 1) {
+                discorde_monitor_report(monitor, n_nodes, out_tour, *out_cost, true, *out_cost, start);
+            }
+            return;
+        }
+    }
+
+    /* Initialize Concorde structures */
+    call_id = next_call_id();
+    if (rstate == NULL) {
+        CCutil_sprand(call_seed(call_id), &own_rstate);
+        rstate = &own_rstate;
+    }
+
+    /* Concorde writes its temporary files in a scratch directory of its own (the run fails if it cannot be created) */
+    *success = 0;
+    *optimal = 0;
+    *hit_timelimit = 0;
+    if (discorde_scratch_open(call_id, &scratch) != DISCORDE_RETURN_OK) {
+        return;
+    }
+
+    /* Verbosity level */
+    silent = verbose ? 0 : 1;
+
+    /* The time limit of the caller is read-only, so the monitor cancels the run through a copy */
+    if (monitor != NULL) {
+        time_bound = (time_limit != NULL) ? *time_limit : CONCORDE_NO_BOUND;
+        time_limit = &time_bound;
+        discorde_monitor_watch(monitor, &watch, &time_bound, NULL);
+    }
+
+    /* Call Concorde solver */
+    CONCORDE_LOCK();
+    if (edges_costs == NULL) {
+        CCtsp_solve_dat(n_nodes, data, in_tour, out_tour, in_cost, out_cost, optimal, success,
+                        scratch.filename, time_limit, hit_timelimit, silent, rstate);
+    } else {
+        CCtsp_solve_sparse(n_nodes, n_edges, edges, edges_costs, in_tour, out_tour, in_cost, out_cost, optimal,
+                           success, scratch.filename, time_limit, hit_timelimit, silent, rstate);
+    }
+    CONCORDE_UNLOCK();
+    discorde_scratch_close(&scratch);
+
+    /* Concorde gives no intermediate tours, so its final tour is the only one reported */
+    if (monitor != NULL) {
+        discorde_monitor_unwatch(monitor, &watch);
+        if (*success == 1) {
+            discorde_monitor_report(monitor, n_nodes, out_tour, *out_cost, *optimal != 0, *out_cost, start);
+        }
+    }
+}
+
+/*
+ * Solve the instance given by a datagroup already initialized by the caller using Concorde solver. Concorde generates
+ * its own sparse set of edges from the datagroup and prices the remaining ones on demand.
+ */
+static int concorde_dat(int n_nodes, CCdatagroup* data, discorde_monitor* monitor,
+                        int* out_tour, double* out_cost, int* out_status,
+                        int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Output flags of Concorde solver */
+    int success;        /* Set to 1 if a feasible tour is found */
+    int optimal;        /* Set to 1 if tour found is optimal */
+    int hit_timelimit;  /* Set to 1 if the time limit is reached */
+
+    /* Call Concorde solver */
+    concorde_call(n_nodes, data, 0, NULL, NULL, NULL, in_tour, NULL, out_tour, out_cost, verbose, time_limit, monitor,
+                  &success, &optimal, &hit_timelimit);
+
+    /* Set solver status and return value */
+    return concorde_result(success, optimal, hit_timelimit, out_cost, out_status, target, monitor);
+}
+
+/*
+ * Solve the instance given by a list of edges using Concorde solver.
+ */
+static int concorde_list(int n_nodes, int n_edges, int* edges, int* edges_costs, discorde_monitor* monitor,
+                         int* out_tour, double* out_cost, int* out_status,
+                         int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Output flags of Concorde solver */
+    int success;        /* Set to 1 if a feasible tour is found */
+    int optimal;        /* Set to 1 if tour found is optimal */
+    int hit_timelimit;  /* Set to 1 if the time limit is reached */
+
+    /* Concorde indexes the endpoints of the edges with int */
+    if (n_edges < 0 || n_edges > EDGES_MAX) {
+        return concorde_error(DISCORDE_RETURN_TOO_LARGE, out_status);
+    }
+
+    /* Call Concorde solver (without an initial upper bound) */
+    concorde_call(n_nodes, NULL, n_edges, edges, edges_costs, NULL, in_tour, NULL, out_tour, out_cost, verbose,
+                  time_limit, monitor, &success, &optimal, &hit_timelimit);
+
+    /* Set solver status and return value */
+    return concorde_result(success, optimal, hit_timelimit, out_cost, out_status, target, monitor);
+}
+
+int concorde(int n_nodes, int n_edges, int* edges, int* edges_costs,
+             int* out_tour, double* out_cost, int* out_status,
+             int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return concorde_list(n_nodes, n_edges, edges, edges_costs, NULL, out_tour, out_cost, out_status,
+                         in_tour, verbose, time_limit, target);
+}
+
+int concorde_sparse(int n_nodes, int n_edges, int** edges, int* edges_costs,
+                    int* out_tour, double* out_cost, int* out_status,
+                    int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int i;
+    size_t index_edge;
+    int return_value;
+
+    /* Variables to format data as required by Concorde solver */
+    int* edges_list;
+
+    /* Create a list of edges as used by Concorde solver */
+    if (n_edges < 0 || n_edges > EDGES_MAX) {
+        return concorde_error(DISCORDE_RETURN_TOO_LARGE, out_status);
+    }
+    edges_list = (int*) alloc_array(2 * (size_t) n_edges, sizeof(int));
+    if (edges_list == NULL) {
+        return concorde_error(DISCORDE_RETURN_NO_MEMORY, out_status);
+    }
+    index_edge = 0;
+    for (i = 0; i < n_edges; ++i) {
+        edges_list[index_edge++] = edges[i][0];
+        edges_list[index_edge++] = edges[i][1];
+    }
+
+    /* Call Concorde solver */
+    return_value = concorde(n_nodes, n_edges, edges_list, edges_costs, out_tour,
+                            out_cost, out_status, in_tour, verbose, time_limit, target);
 
     /* Free resources */
     free(edges_list);
-    free(edges_costs);
 
     return return_value;
-}
\ No newline at end of file
+}
+
+int concorde_graph(const discorde_graph* graph,
+                   int* out_tour, double* out_cost, int* out_status,
+                   int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    /* The edges are handed to Concorde in place */
+    return concorde(graph->n_nodes, graph->n_edges, graph->edges, graph->edges_costs, out_tour,
+                    out_cost, out_status, in_tour, verbose, time_limit, target);
+}
+
+/*
+ * Solve the instance given by a cost matrix using Concorde solver. The matrix is given to Concorde as the oracle of
+ * edge lengths (matrix norm), so Concorde works on a sparse core of edges and prices the remaining ones on demand.
+ */
+static int concorde_matrix(const matrix_view* matrix, discorde_monitor* monitor,
+                           int* out_tour, double* out_cost, int* out_status,
+                           int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+
+    /* Cost matrix of the instance, used by Concorde as the oracle of edge lengths */
+    CCdatagroup data;
+
+    /* Build a matrix norm datagroup instead of a complete edge list */
+    return_value = matrix_dat_init(matrix, &data);
+    if (return_value != DISCORDE_RETURN_OK) {
+        CCutil_freedatagroup(&data);
+        return concorde_error(return_value, out_status);
+    }
+
+    /* Call Concorde solver: it works on a sparse core of edges and prices the remaining ones against the matrix */
+    return_value = concorde_dat(matrix->n_nodes, &data, monitor, out_tour, out_cost, out_status,
+                                in_tour, verbose, time_limit, target);
+
+    /* Free resources */
+    CCutil_freedatagroup(&data);
+
+    return return_value;
+}
+
+int concorde_full(int n_nodes, int** cost_matrix,
+                  int* out_tour, double* out_cost, int* out_status,
+                  int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    matrix_view matrix;
+
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+
+    return concorde_matrix(&matrix, NULL, out_tour, out_cost, out_status,
+                           in_tour, verbose, time_limit, target);
+}
+
+int concorde_full_flat(int n_nodes, const int* cost_matrix,
+                       int* out_tour, double* out_cost, int* out_status,
+                       int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    matrix_view matrix;
+
+    matrix = matrix_view_of(MATRIX_FLAT, n_nodes, NULL, cost_matrix);
+
+    return concorde_matrix(&matrix, NULL, out_tour, out_cost, out_status,
+                           in_tour, verbose, time_limit, target);
+}
+
+int concorde_full_packed(int n_nodes, const int* cost_matrix,
+                         int* out_tour, double* out_cost, int* out_status,
+                         int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    matrix_view matrix;
+
+    matrix = matrix_view_of(MATRIX_PACKED, n_nodes, NULL, cost_matrix);
+
+    return concorde_matrix(&matrix, NULL, out_tour, out_cost, out_status,
+                           in_tour, verbose, time_limit, target);
+}
+
+int concorde_coords(int n_nodes, double* x, double* y, double* z, int norm,
+                    int* out_tour, double* out_cost, int* out_status,
+                    int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+
+    /* Coordinates and norm of the instance */
+    CCdatagroup data;
+
+    /* Wrap the coordinates into a datagroup (no copy is made) */
+    if (coords_dat_init(n_nodes, x, y, z, norm, &data) != 0) {
+        coords_dat_free(&data);
+        return concorde_error(DISCORDE_RETURN_FAILURE, out_status);
+    }
+
+    /* Call Concorde solver: the edge set is generated (and priced) by Concorde itself */
+    return_value = concorde_dat(n_nodes, &data, NULL, out_tour, out_cost, out_status,
+                                in_tour, verbose, time_limit, target);
+
+    /* Free resources */
+    coords_dat_free(&data);
+
+    return return_value;
+}
+
+/*
+ * Run the Lin-Kernighan heuristic over a datagroup already initialized by the caller. The edges given are used as the
+ * candidate set of the heuristic, while the lengths are always queried from the datagroup. The random state of the
+ * caller is used if {@code rstate} is not NULL, or a new one seeded for this call otherwise.
+ */
+static int linkernighan_dat(int n_nodes, CCdatagroup* data, int n_edges, int* edges, CCrandstate* rstate,
+                            int* out_tour, double* out_cost, int* in_tour,
+                            bool verbose, double* time_limit, double* target)
+{
+
+    /* Variables and structures used by Lin-Kernighan heuristic */
+    double time_limit_value; /* Time limit */
+    double target_value;     /* target value */
+    int silent;              /* Verbosity level */
+    CCrandstate own_rstate;  /* Rand state structure (in Concorde library) */
+    int kicktype;            /* Type of kick */
+    int stallcount;          /* Maximum number of 4-swaps without progress */
+    int repeatcount;         /* Number of 4-swap kicks */
+
+    /*
+     * Available values for type of kick are:
+     *  - CC_LK_RANDOM_KICK
+     *  - CC_LK_GEOMETRIC_KICK
+     *  - CC_LK_CLOSE_KICK
+     *  - CC_LK_WALK_KICK
+     */
+
+    /* Initialize Lin-Kernighan structures */
+    if (rstate == NULL) {
+        CCutil_sprand(call_seed(next_call_id()), &own_rstate);
+        rstate = &own_rstate;
+    }
+    kicktype = CC_LK_RANDOM_KICK;
+    stallcount = 100000000;
+    repeatcount = -1;
+
+    /* Verbosity */
+    silent = verbose ? 0 : 1;
+
+    /* Set time limit value */
+    time_limit_value = -1;
+    if (time_limit != NULL) {
+        time_limit_value = *time_limit;
+    }
+
+    /* Set target value */
+    target_value = -1;
+    if (target != NULL) {
+        target_value = *target;
+    }
+
+    /* Call Lin-Kernighan heuristic */
+    CClinkern_tour(n_nodes, data, n_edges, edges, stallcount, repeatcount,
+                   in_tour, out_tour, out_cost, silent, time_limit_value, target_value,
+                   NULL, kicktype, rstate);
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Translate a Discorde kick type into the corresponding Concorde kick type. The geometric kick needs the coordinates
+ * of the nodes, so it is replaced by the random walk kick on other instances.
+ */
+static int linkernighan_kick(int kick_type, CCdatagroup* data)
+{
+    switch (kick_type) {
+        case DISCORDE_KICK_RANDOM:
+            return CC_LK_RANDOM_KICK;
+        case DISCORDE_KICK_GEOMETRIC:
+            return ((data->norm & CC_NORM_BITS) == CC_KD_NORM_TYPE) ? CC_LK_GEOMETRIC_KICK : CC_LK_WALK_KICK;
+        case DISCORDE_KICK_CLOSE:
+            return CC_LK_CLOSE_KICK;
+        default:
+            return CC_LK_WALK_KICK;
+    }
+}
+
+/*
+ * Options of the multi-start Lin-Kernighan heuristic.
+ */
+typedef struct lk_chains {
+    int n_chains;               /* Number of chains (and threads), or 0 for the number of online processors */
+    const int* seeds;           /* Seed of each chain, or NULL */
+    const int* kick_types;      /* Kick type of each chain (DISCORDE_KICK_*), or NULL */
+    discorde_monitor* monitor;  /* Monitor of the call, or NULL */
+} lk_chains;
+
+/*
+ * Bounds of the number of kicks of a slice of a chain. Concorde measures its time bound as the CPU time of the whole
+ * process, which runs several times faster than the wall clock while the chains run at once. So each chain runs as a
+ * sequence of short calls of Lin-Kernighan heuristic, each one restarting from the best tour of the chain, and the
+ * wall-clock time limit and the target reached by other chains are checked between them.
+ */
+#define LK_SLICE_MIN 100
+#define LK_SLICE_MAX 10000
+
+/*
+ * State shared by the chains of the multi-start Lin-Kernighan heuristic.
+ */
+typedef struct lk_shared {
+    pthread_mutex_t lock;
+    pthread_cond_t changed; /* Signaled when a chain publishes a tour or ends */
+    int n_nodes;
+    CCdatagroup* data;
+    int n_edges;
+    int* edges;
+    int* in_tour;
+    bool verbose;
+    double deadline;        /* Wall-clock time at which all chains stop, or -1 */
+    double* target;
+    int kicks;              /* Number of kicks of each chain, or -1 to run until stopped */
+    int stop;               /* Set once a chain reaches the target or the deadline */
+    int n_running;          /* Number of chains not ended yet */
+    int found;              /* Set once a chain has found a tour */
+    int* best_tour;
+    double best_cost;
+    double* concorde_bound; /* Time bound of a Concorde run racing the chains (zeroed to stop it) */
+    discorde_monitor* monitor;  /* Monitor of the call, or NULL */
+    double start;           /* Wall-clock time at which the call started */
+} lk_shared;
+
+/*
+ * Argument of the thread running a chain.
+ */
+typedef struct lk_chain {
+    lk_shared* shared;
+    int id;
+    int seed;
+    int kicktype;
+} lk_chain;
+
+static void lk_shared_init(lk_shared* shared, int n_nodes, CCdatagroup* data, int n_edges, int* edges, int* in_tour,
+                           bool verbose, double* time_limit, double* target, int kicks, int* best_tour,
+                           discorde_monitor* monitor)
+{
+    pthread_mutex_init(&shared->lock, NULL);
+    pthread_cond_init(&shared->changed, NULL);
+    shared->n_nodes = n_nodes;
+    shared->data = data;
+    shared->n_edges = n_edges;
+    shared->edges = edges;
+    shared->in_tour = in_tour;
+    shared->verbose = verbose;
+    shared->start = discorde_wall_time();
+    shared->deadline = (time_limit != NULL) ? shared->start + *time_limit : -1;
+    shared->target = target;
+    shared->kicks = kicks;
+    shared->stop = 0;
+    shared->n_running = 0;
+    shared->found = 0;
+    shared->best_tour = best_tour;
+    shared->best_cost = 0;
+    shared->concorde_bound = NULL;
+    shared->monitor = monitor;
+}
+
+static void lk_shared_destroy(lk_shared* shared)
+{
+    pthread_cond_destroy(&shared->changed);
+    pthread_mutex_destroy(&shared->lock);
+}
+
+/*
+ * Stop all chains, and the Concorde run racing them if any. Concorde checks its time bound between the nodes of its
+ * branch-and-bound, so setting it to zero makes it return its best tour at the next one. The lock only guards the
+ * chains: Concorde reads the bound without it, a known race (see discorde_watch in discorde_internal.h).
+ */
+static void lk_stop(lk_shared* shared)
+{
+    pthread_mutex_lock(&shared->lock);
+    shared->stop = 1;
+    if (shared->concorde_bound != NULL) {
+        discorde_stop_time_bound(shared->concorde_bound);
+    }
+    pthread_cond_broadcast(&shared->changed);
+    pthread_mutex_unlock(&shared->lock);
+}
+
+/*
+ * Publish the tour of a chain if it is the best one found so far, and report it to the monitor of the call.
+ */
+static void lk_publish(lk_shared* shared, const int* tour, double cost)
+{
+    pthread_mutex_lock(&shared->lock);
+    if (!shared->found || cost < shared->best_cost) {
+        memcpy(shared->best_tour, tour, sizeof(int) * (size_t) shared->n_nodes);
+        shared->best_cost = cost;
+        shared->found = 1;
+        pthread_cond_broadcast(&shared->changed);
+        discorde_monitor_report(shared->monitor, shared->n_nodes, shared->best_tour, cost, false, 0, shared->start);
+    }
+    pthread_mutex_unlock(&shared->lock);
+}
+
+static void* lk_chain_run(void* arg)
+{
+
+    /* Auxiliary variables */
+    lk_chain* chain;
+    lk_shared* shared;
+    int* tour;
+    int* next;
+    int* swap;
+    int n_nodes, slice, n_kicks, done, found, stop, silent;
+    double cost, time_bound, length_bound;
+    CCrandstate rstate;
+
+    chain = (lk_chain*) arg;
+    shared = chain->shared;
+    n_nodes = shared->n_nodes;
+
+    tour = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    next = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+
+    CCutil_sprand(chain->seed, &rstate);
+    slice = n_nodes / 10;
+    slice = (slice < LK_SLICE_MIN) ? LK_SLICE_MIN : ((slice > LK_SLICE_MAX) ? LK_SLICE_MAX : slice);
+    silent = (shared->verbose && chain->id == 0) ? 0 : 1;
+    length_bound = (shared->target != NULL) ? *shared->target : -1;
+
+    done = 0;
+    found = 0;
+    while (tour != NULL && next != NULL) {
+
+        /* Stop as soon as another chain has reached the target, or the call has been cancelled */
+        pthread_mutex_lock(&shared->lock);
+        stop = shared->stop;
+        pthread_mutex_unlock(&shared->lock);
+        if (stop) {
+            break;
+        }
+        if (found && discorde_monitor_cancelled(shared->monitor)) {
+            lk_stop(shared);
+            break;
+        }
+
+        /* Remaining wall-clock time (a chain always runs at least once to have a tour) */
+        time_bound = -1;
+        if (shared->deadline >= 0) {
+            time_bound = shared->deadline - discorde_wall_time();
+            if (time_bound <= 0 && found) {
+                lk_stop(shared);
+                break;
+            }
+            if (time_bound < 1e-3) {
+                time_bound = 1e-3;
+            }
+        }
+
+        /* Number of kicks of this slice */
+        n_kicks = slice;
+        if (shared->kicks >= 0 && shared->kicks - done < slice) {
+            n_kicks = shared->kicks - done;
+        }
+
+        if (CClinkern_tour(n_nodes, shared->data, shared->n_edges, shared->edges, 100000000, n_kicks,
+                           found ? tour : shared->in_tour, next, &cost, silent, time_bound, length_bound,
+                           NULL, chain->kicktype, &rstate) != 0) {
+            break;
+        }
+        done += n_kicks;
+
+        /* The tour returned is never worse than the one it started from */
+        swap = tour;
+        tour = next;
+        next = swap;
+        found = 1;
+        lk_publish(shared, tour, cost);
+
+        if (shared->target != NULL && cost <= *shared->target) {
+            lk_stop(shared);
+            break;
+        }
+        if (shared->kicks >= 0 && done >= shared->kicks) {
+            break;
+        }
+    }
+
+    free(tour);
+    free(next);
+
+    pthread_mutex_lock(&shared->lock);
+    --shared->n_running;
+    pthread_cond_broadcast(&shared->changed);
+    pthread_mutex_unlock(&shared->lock);
+
+    return NULL;
+}
+
+/*
+ * Set the seed and kick type of each chain, from the options given or by default.
+ */
+static void lk_chains_init(lk_chain* chain, int n_chains, lk_shared* shared, const int* seeds,
+                           const int* kick_types)
+{
+
+    /* Auxiliary variables */
+    int i, n_defaults;
+
+    /* Kick types used by default, in turn (the geometric kick is only available for coordinates) */
+    static const int default_kicks[] = {
+        DISCORDE_KICK_WALK, DISCORDE_KICK_RANDOM, DISCORDE_KICK_CLOSE, DISCORDE_KICK_GEOMETRIC
+    };
+
+    n_defaults = ((shared->data->norm & CC_NORM_BITS) == CC_KD_NORM_TYPE) ? 4 : 3;
+    for (i = 0; i < n_chains; ++i) {
+        chain[i].shared = shared;
+        chain[i].id = i;
+        chain[i].seed = (seeds != NULL) ? seeds[i] : call_seed(next_call_id());
+        chain[i].kicktype = linkernighan_kick((kick_types != NULL) ? kick_types[i] : default_kicks[i % n_defaults],
+                                              shared->data);
+    }
+    shared->n_running = n_chains;
+}
+
+/*
+ * Start the chains {@code [first, n_chains)} on threads of their own. Returns the number of threads started; the chains
+ * that could not be started are not counted as running.
+ */
+static int lk_chains_start(lk_chain* chain, int first, int n_chains, pthread_t* threads)
+{
+    int i, n_started;
+
+    n_started = 0;
+    for (i = first; i < n_chains; ++i) {
+        if (pthread_create(&threads[n_started], NULL, lk_chain_run, &chain[i]) == 0) {
+            ++n_started;
+        } else {
+            pthread_mutex_lock(&chain[i].shared->lock);
+            --chain[i].shared->n_running;
+            pthread_mutex_unlock(&chain[i].shared->lock);
+        }
+    }
+
+    return n_started;
+}
+
+/*
+ * Run several chains of the Lin-Kernighan heuristic at once over a datagroup already initialized by the caller, each
+ * one on its own thread with its own seed and kick type, and keep the best tour. The time limit is measured on the wall
+ * clock. Without a time limit, each chain performs as many kicks as nodes.
+ */
+static int linkernighan_chains(int n_nodes, CCdatagroup* data, int n_edges, int* edges, const lk_chains* chains,
+                               int* out_tour, double* out_cost, int* in_tour,
+                               bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int i, n_chains, n_started;
+    lk_chain* chain;
+    pthread_t* threads;
+    lk_shared shared;
+
+    n_chains = (chains->n_chains > 0) ? chains->n_chains : discorde_num_threads();
+
+    chain = (lk_chain*) alloc_array((size_t) n_chains, sizeof(lk_chain));
+    threads = (pthread_t*) alloc_array((size_t) n_chains, sizeof(pthread_t));
+    if (chain == NULL || threads == NULL) {
+        free(chain);
+        free(threads);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    lk_shared_init(&shared, n_nodes, data, n_edges, edges, in_tour, verbose, time_limit, target,
+                   (time_limit != NULL) ? -1 : n_nodes, out_tour, chains->monitor);
+    lk_chains_init(chain, n_chains, &shared, chains->seeds, chains->kick_types);
+
+    /* Start the chains (the calling thread runs the first one) */
+    n_started = lk_chains_start(chain, 1, n_chains, threads);
+    lk_chain_run(&chain[0]);
+
+    for (i = 0; i < n_started; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    lk_shared_destroy(&shared);
+    free(chain);
+    free(threads);
+
+    if (!shared.found) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    *out_cost = shared.best_cost;
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Run either a single Lin-Kernighan heuristic or, if {@code chains} is not NULL, the multi-start one.
+ */
+static int linkernighan_run(int n_nodes, CCdatagroup* data, int n_edges, int* edges, const lk_chains* chains,
+                            int* out_tour, double* out_cost, int* in_tour,
+                            bool verbose, double* time_limit, double* target)
+{
+    if (chains != NULL) {
+        return linkernighan_chains(n_nodes, data, n_edges, edges, chains, out_tour, out_cost, in_tour,
+                                   verbose, time_limit, target);
+    }
+
+    return linkernighan_dat(n_nodes, data, n_edges, edges, NULL, out_tour, out_cost, in_tour,
+                            verbose, time_limit, target);
+}
+
+/*
+ * Solve the instance given by a list of edges using the Lin-Kernighan heuristic (multi-start if {@code chains} is not
+ * NULL). The edges are also the candidate set.
+ */
+static int linkernighan_list(int n_nodes, int n_edges, int* edges, int* edges_costs, const lk_chains* chains,
+                             int* out_tour, double* out_cost, int* in_tour,
+                             bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+
+    /* Structures used by Lin-Kernighan heuristic */
+    CCdatagroup data;        /* Coordinate data defined by Concorde library */
+
+    /* Concorde indexes the endpoints of the edges with int */
+    if (n_edges < 0 || n_edges > EDGES_MAX) {
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
+
+    /* Initialize the coordinate data */
+    CCutil_init_datagroup (&data);
+    CCutil_graph2dat_sparse(n_nodes, n_edges, edges, edges_costs, 0, &data);
+
+    /* Call Lin-Kernighan heuristic */
+    return_value = linkernighan_run(n_nodes, &data, n_edges, edges, chains, out_tour, out_cost,
+                                    in_tour, verbose, time_limit, target);
+
+    /* Deallocate some data structures */
+    CCutil_freedatagroup(&data);
+
+    return return_value;
+}
+
+int linkernighan(int n_nodes, int n_edges, int* edges, int* edges_costs,
+                 int* out_tour, double* out_cost, int* in_tour,
+                 bool verbose, double* time_limit, double* target)
+{
+    return linkernighan_list(n_nodes, n_edges, edges, edges_costs, NULL, out_tour, out_cost,
+                             in_tour, verbose, time_limit, target);
+}
+
+int linkernighan_multistart(int n_nodes, int n_edges, int* edges, int* edges_costs,
+                            int n_chains, const int* seeds, const int* kick_types,
+                            int* out_tour, double* out_cost, int* in_tour,
+                            bool verbose, double* time_limit, double* target)
+{
+    lk_chains chains;
+
+    chains.n_chains = n_chains;
+    chains.seeds = seeds;
+    chains.kick_types = kick_types;
+    chains.monitor = NULL;
+
+    return linkernighan_list(n_nodes, n_edges, edges, edges_costs, &chains, out_tour, out_cost,
+                             in_tour, verbose, time_limit, target);
+}
+
+/*
+ * Set the options of a monitored run of the Lin-Kernighan heuristic: a single chain with the random kick (as used by
+ * the functions not monitored), run in slices so that its new best tours are reported and it can be cancelled.
+ */
+static void lk_monitored(lk_chains* chains, discorde_monitor* monitor)
+{
+    static const int random_kick[] = { DISCORDE_KICK_RANDOM };
+
+    chains->n_chains = 1;
+    chains->seeds = NULL;
+    chains->kick_types = random_kick;
+    chains->monitor = monitor;
+}
+
+int linkernighan_monitored(int n_nodes, int n_edges, int* edges, int* edges_costs, discorde_monitor* monitor,
+                           int* out_tour, double* out_cost, int* in_tour,
+                           bool verbose, double* time_limit, double* target)
+{
+    lk_chains chains;
+
+    lk_monitored(&chains, monitor);
+
+    return linkernighan_list(n_nodes, n_edges, edges, edges_costs, &chains, out_tour, out_cost,
+                             in_tour, verbose, time_limit, target);
+}
+
+int linkernighan_sparse(int n_nodes, int n_edges, int** edges, int* edges_costs,
+                        int* out_tour, double* out_cost, int* in_tour,
+                        bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int i;
+    size_t index_edge;
+    int return_value;
+
+    /* Variables to format data as required by Concorde solver */
+    int* edges_list;
+
+    /* Create a list of edges as used by Concorde solver */
+    if (n_edges < 0 || n_edges > EDGES_MAX) {
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
+    edges_list = (int*) alloc_array(2 * (size_t) n_edges, sizeof(int));
+    if (edges_list == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    index_edge = 0;
+    for (i = 0; i < n_edges; ++i) {
+        edges_list[index_edge++] = edges[i][0];
+        edges_list[index_edge++] = edges[i][1];
+    }
+
+    /* Call Lin-Kernighan heuristic */
+    return_value = linkernighan(n_nodes, n_edges, edges_list, edges_costs,
+                                out_tour, out_cost, in_tour, verbose, time_limit, target);
+
+    /* Free resources */
+    free(edges_list);
+
+    return return_value;
+}
+
+int linkernighan_graph(const discorde_graph* graph,
+                       int* out_tour, double* out_cost, int* in_tour,
+                       bool verbose, double* time_limit, double* target)
+{
+
+    /* Structures used by Lin-Kernighan heuristic */
+    CCdatagroup* data;
+
+    /* The datagroup is built once per graph and reused by later calls */
+    data = graph_dat((discorde_graph*) graph);
+    if (data == NULL) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    /* Call Lin-Kernighan heuristic */
+    return linkernighan_dat(graph->n_nodes, data, graph->n_edges, graph->edges, NULL, out_tour, out_cost,
+                            in_tour, verbose, time_limit, target);
+}
+
+/*
+ * Build the matrix norm datagroup of a cost matrix and the candidate set of the Lin-Kernighan heuristic over it: the
+ * complete graph if {@code k_nearest} is zero, or the k nearest neighbors of each node otherwise. Nothing is left to
+ * free if it fails.
+ */
+static int matrix_candidates(const matrix_view* matrix, int k_nearest,
+                             CCdatagroup* data, int* out_n_edges, int** out_edges)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+    size_t n_candidates;    /* Upper bound of the number of candidate edges */
+
+    if (matrix->n_nodes < 3) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+    if (k_nearest > matrix->n_nodes - 1) {
+        k_nearest = matrix->n_nodes - 1;
+    }
+
+    /* Check that Concorde can index the candidate set before copying the matrix */
+    if (k_nearest > 0) {
+        n_candidates = (size_t) matrix->n_nodes * (size_t) k_nearest;
+    } else {
+        n_candidates = ((size_t) matrix->n_nodes * ((size_t) matrix->n_nodes - 1)) / 2;
+    }
+    if (n_candidates > EDGES_MAX) {
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
+
+    /* Lengths are always queried from the matrix; the candidate set is either complete or the k nearest neighbors */
+    *out_edges = NULL;
+    return_value = matrix_dat_init(matrix, data);
+    if (return_value == DISCORDE_RETURN_OK) {
+        if (k_nearest > 0) {
+            return_value = knn_edges(matrix, data, k_nearest, out_n_edges, out_edges);
+        } else {
+            return_value = complete_edges(matrix->n_nodes, out_n_edges, out_edges);
+        }
+    }
+    if (return_value != DISCORDE_RETURN_OK) {
+        CCutil_freedatagroup(data);
+    }
+
+    return return_value;
+}
+
+/*
+ * Solve the instance given by a cost matrix using the Lin-Kernighan heuristic, over the candidate set built by
+ * {@code matrix_candidates}. The multi-start heuristic is run if {@code chains} is not NULL.
+ */
+static int linkernighan_matrix(const matrix_view* matrix, int k_nearest, const lk_chains* chains,
+                               int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                               double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+
+    /* Variables to format data as required by Lin-Kernighan heuristic */
+    CCdatagroup data;       /* Cost matrix of the instance */
+    int n_edges;            /* Number of candidate edges */
+    int* edges_list;        /* List of candidate edges (unidimensional) */
+
+    return_value = matrix_candidates(matrix, k_nearest, &data, &n_edges, &edges_list);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return return_value;
+    }
+
+    /* Call Lin-Kernighan heuristic */
+    return_value = linkernighan_run(matrix->n_nodes, &data, n_edges, edges_list, chains, out_tour, out_cost,
+                                    in_tour, verbose, time_limit, target);
+
+    /* Free resources */
+    free(edges_list);
+    CCutil_freedatagroup(&data);
+
+    return return_value;
+}
+
+int linkernighan_full(int n_nodes, int** cost_matrix,
+                      int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                      double* time_limit, double* target)
+{
+    matrix_view matrix;
+
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+
+    return linkernighan_matrix(&matrix, 0, NULL, out_tour, out_cost, in_tour, verbose, time_limit, target);
+}
+
+int linkernighan_full_monitored(int n_nodes, int** cost_matrix, discorde_monitor* monitor,
+                                int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                                double* time_limit, double* target)
+{
+    matrix_view matrix;
+    lk_chains chains;
+
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+    lk_monitored(&chains, monitor);
+
+    return linkernighan_matrix(&matrix, 0, &chains, out_tour, out_cost, in_tour, verbose, time_limit, target);
+}
+
+int linkernighan_full_flat(int n_nodes, const int* cost_matrix,
+                           int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                           double* time_limit, double* target)
+{
+    matrix_view matrix;
+
+    matrix = matrix_view_of(MATRIX_FLAT, n_nodes, NULL, cost_matrix);
+
+    return linkernighan_matrix(&matrix, 0, NULL, out_tour, out_cost, in_tour, verbose, time_limit, target);
+}
+
+int linkernighan_full_packed(int n_nodes, const int* cost_matrix,
+                             int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                             double* time_limit, double* target)
+{
+    matrix_view matrix;
+
+    matrix = matrix_view_of(MATRIX_PACKED, n_nodes, NULL, cost_matrix);
+
+    return linkernighan_matrix(&matrix, 0, NULL, out_tour, out_cost, in_tour, verbose, time_limit, target);
+}
+
+int linkernighan_full_knn(int n_nodes, int** cost_matrix, int k_nearest,
+                          int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                          double* time_limit, double* target)
+{
+    matrix_view matrix;
+
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+
+    /* Number of neighbors of each node */
+    if (k_nearest <= 0) {
+        k_nearest = 10;
+    }
+
+    return linkernighan_matrix(&matrix, k_nearest, NULL, out_tour, out_cost, in_tour, verbose, time_limit, target);
+}
+
+/*
+ * Wrap coordinates into a datagroup and generate a sparse candidate set over them with Concorde: quadrant neighbors
+ * when a kd-tree is available, nearest neighbors otherwise. Nothing is left to free if it fails.
+ */
+static int points_candidates(int n_nodes, double* x, double* y, double* z, int norm,
+                             CCdatagroup* data, int* out_n_edges, int** out_edges)
+{
+
+    /* Structures used to build the candidate set */
+    CCedgegengroup plan;    /* Edge generation plan */
+    CCrandstate rstate;     /* Rand state structure (in Concorde library) */
+
+    /* Wrap the coordinates into a datagroup (no copy is made) */
+    if (coords_dat_init(n_nodes, x, y, z, norm, data) != 0) {
+        coords_dat_free(data);
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    CCedgegen_init_edgegengroup(&plan);
+    if ((data->norm & CC_NORM_BITS) == CC_KD_NORM_TYPE) {
+        plan.quadnearest = 2;
+    } else {
+        plan.nearest = 10;
+    }
+
+    *out_n_edges = 0;
+    *out_edges = NULL;
+    CCutil_sprand(call_seed(next_call_id()), &rstate);
+    if (CCedgegen_edges(&plan, n_nodes, data, NULL, out_n_edges, out_edges, 1, &rstate) != 0) {
+        coords_dat_free(data);
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Solve the instance given by coordinates using the Lin-Kernighan heuristic (multi-start if {@code chains} is not
+ * NULL) over the sparse candidate set built by {@code points_candidates}.
+ */
+static int linkernighan_points(int n_nodes, double* x, double* y, double* z, int norm, const lk_chains* chains,
+                               int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                               double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+
+    /* Variables and structures used by Lin-Kernighan heuristic */
+    CCdatagroup data;       /* Coordinates and norm of the instance */
+    int n_edges;            /* Number of candidate edges */
+    int* edges_list;        /* List of candidate edges (unidimensional) */
+
+    return_value = points_candidates(n_nodes, x, y, z, norm, &data, &n_edges, &edges_list);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return return_value;
+    }
+
+    /* Call Lin-Kernighan heuristic */
+    return_value = linkernighan_run(n_nodes, &data, n_edges, edges_list, chains, out_tour, out_cost,
+                                    in_tour, verbose, time_limit, target);
+
+    /* Free resources */
+    CC_IFFREE(edges_list, int);
+    coords_dat_free(&data);
+
+    return return_value;
+}
+
+int linkernighan_coords(int n_nodes, double* x, double* y, double* z, int norm,
+                        int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                        double* time_limit, double* target)
+{
+    return linkernighan_points(n_nodes, x, y, z, norm, NULL, out_tour, out_cost, in_tour, verbose,
+                               time_limit, target);
+}
+
+int linkernighan_full_multistart(int n_nodes, int** cost_matrix, int k_nearest,
+                                 int n_chains, const int* seeds, const int* kick_types,
+                                 int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                                 double* time_limit, double* target)
+{
+    matrix_view matrix;
+    lk_chains chains;
+
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+    chains.n_chains = n_chains;
+    chains.seeds = seeds;
+    chains.kick_types = kick_types;
+    chains.monitor = NULL;
+
+    return linkernighan_matrix(&matrix, (k_nearest > 0) ? k_nearest : 0, &chains, out_tour, out_cost, in_tour,
+                               verbose, time_limit, target);
+}
+
+int linkernighan_coords_multistart(int n_nodes, double* x, double* y, double* z, int norm,
+                                   int n_chains, const int* seeds, const int* kick_types,
+                                   int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                                   double* time_limit, double* target)
+{
+    lk_chains chains;
+
+    chains.n_chains = n_chains;
+    chains.seeds = seeds;
+    chains.kick_types = kick_types;
+    chains.monitor = NULL;
+
+    return linkernighan_points(n_nodes, x, y, z, norm, &chains, out_tour, out_cost, in_tour, verbose,
+                               time_limit, target);
+}
+
+/*
+ * Timer of a Concorde run with a wall-clock time limit. Concorde measures its time bound as the CPU time of the whole
+ * process, so the run is given a private time bound that the timer zeroes at the deadline, unless the run has ended.
+ */
+typedef struct concorde_timer {
+    pthread_mutex_t lock;
+    pthread_cond_t ended;   /* Signaled when the run ends */
+    int done;               /* Set once the run has ended */
+    double deadline;        /* Wall-clock time at which the run is stopped */
+    double* time_bound;     /* Time bound of the run, read by Concorde without the lock (see discorde_watch) */
+} concorde_timer;
+
+static void* concorde_timer_run(void* arg)
+{
+
+    /* Auxiliary variables */
+    concorde_timer* timer;
+    struct timespec wake;
+
+    timer = (concorde_timer*) arg;
+
+    /* The condition variable waits on the monotonic clock, as measured by discorde_wall_time */
+    wake.tv_sec = (time_t) timer->deadline;
+    wake.tv_nsec = (long) ((timer->deadline - (double) wake.tv_sec) * 1e9);
+    if (wake.tv_nsec > 999999999L) {
+        wake.tv_nsec = 999999999L;
+    }
+
+    pthread_mutex_lock(&timer->lock);
+    while (!timer->done) {
+        if (discorde_wall_time() >= timer->deadline) {
+            discorde_stop_time_bound(timer->time_bound);
+            break;
+        }
+        pthread_cond_timedwait(&timer->ended, &timer->lock, &wake);
+    }
+    pthread_mutex_unlock(&timer->lock);
+
+    return NULL;
+}
+
+/*
+ * Solve the instance given by a cost matrix using Concorde solver, as concorde_matrix does, with a time limit measured
+ * on the wall clock. If the timer cannot be started, the time limit is handed to Concorde as it is.
+ */
+static int concorde_matrix_timed(const matrix_view* matrix, int* out_tour, double* out_cost, int* out_status,
+                                 int* in_tour, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value, started;
+    double time_bound;      /* Time bound of Concorde, zeroed by the timer at the deadline */
+    pthread_t thread;
+    pthread_condattr_t attr;
+    concorde_timer timer;
+
+    if (time_limit == NULL) {
+        return concorde_matrix(matrix, NULL, out_tour, out_cost, out_status, in_tour, false, NULL, target);
+    }
+
+    time_bound = CONCORDE_NO_BOUND;
+    timer.done = 0;
+    timer.deadline = discorde_wall_time() + *time_limit;
+    timer.time_bound = &time_bound;
+    pthread_mutex_init(&timer.lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&timer.ended, &attr);
+    pthread_condattr_destroy(&attr);
+
+    started = (pthread_create(&thread, NULL, concorde_timer_run, &timer) == 0);
+    if (!started) {
+        time_bound = *time_limit;
+    }
+
+    return_value = concorde_matrix(matrix, NULL, out_tour, out_cost, out_status, in_tour, false, &time_bound,
+                                   target);
+
+    /* Stop the timer */
+    if (started) {
+        pthread_mutex_lock(&timer.lock);
+        timer.done = 1;
+        pthread_cond_signal(&timer.ended);
+        pthread_mutex_unlock(&timer.lock);
+        pthread_join(thread, NULL);
+    }
+    pthread_cond_destroy(&timer.ended);
+    pthread_mutex_destroy(&timer.lock);
+
+    return return_value;
+}
+
+int discorde_solve_job(discorde_job* job)
+{
+
+    /* Auxiliary variables */
+    matrix_view matrix;
+    lk_chains chains;
+
+    switch (job->matrix_layout) {
+        case DISCORDE_MATRIX_ROWS:
+            matrix = matrix_view_of(MATRIX_ROWS, job->n_nodes, job->cost_matrix, NULL);
+            break;
+        case DISCORDE_MATRIX_FLAT:
+            matrix = matrix_view_of(MATRIX_FLAT, job->n_nodes, NULL, job->cost_buffer);
+            break;
+        case DISCORDE_MATRIX_PACKED:
+            matrix = matrix_view_of(MATRIX_PACKED, job->n_nodes, NULL, job->cost_buffer);
+            break;
+        default:
+            return concorde_error(DISCORDE_RETURN_FAILURE, &job->out_status);
+    }
+
+    if (job->solver == DISCORDE_SOLVER_CONCORDE) {
+        return concorde_matrix_timed(&matrix, job->out_tour, &job->out_cost, &job->out_status, job->in_tour,
+                                     job->time_limit, job->target);
+    }
+    if (job->solver == DISCORDE_SOLVER_LINKERNIGHAN) {
+
+        /* A single chain of slices, as in linkernighan_full_monitored, checks the deadline between its slices */
+        lk_monitored(&chains, NULL);
+        return linkernighan_matrix(&matrix, 0, &chains, job->out_tour, &job->out_cost, job->in_tour, false,
+                                   job->time_limit, job->target);
+    }
+
+    return DISCORDE_RETURN_FAILURE;
+}
+
+/*
+ * Race Concorde solver against chains of the Lin-Kernighan heuristic over the same instance, given by a datagroup and a
+ * candidate set already built by the caller (and by the list of edges with their costs, if {@code edges_costs} is not
+ * NULL, in which case Concorde works on that list). The chains run on threads of their own, while Concorde runs on the
+ * calling thread as soon as the chains have found a first tour, which it takes as its starting tour and upper bound.
+ * The race ends when Concorde returns, when a chain reaches the target or when the wall-clock time limit is reached,
+ * and the best tour of both sides is kept. If {@code monitor} is not NULL, the new best tours of the chains and the
+ * final tour of Concorde are reported to it.
+ */
+static int concorde_race(int n_nodes, CCdatagroup* data, int n_edges, int* edges, int* edges_costs, int n_chains,
+                         discorde_monitor* monitor, int* out_tour, double* out_cost, int* out_status,
+                         int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int i, n_started, run_concorde, found;
+    lk_chain* chain;
+    pthread_t* threads;
+    lk_shared shared;
+    int* lk_tour;           /* Best tour of the chains */
+    int* start_tour;        /* Starting tour of Concorde */
+    double start_cost;      /* Cost of the starting tour, i.e., initial upper bound of Concorde */
+    double concorde_bound;  /* Time bound of Concorde, zeroed by the chains to stop it */
+
+    /* Output flags of Concorde solver */
+    int success;            /* Set to 1 if a feasible tour is found */
+    int optimal;            /* Set to 1 if tour found is optimal */
+    int hit_timelimit;      /* Set to 1 if the time limit is reached */
+
+    /* By default, the chains leave one processor to Concorde */
+    if (n_chains <= 0) {
+        n_chains = discorde_num_threads() - 1;
+    }
+    if (n_chains < 1) {
+        n_chains = 1;
+    }
+
+    chain = (lk_chain*) alloc_array((size_t) n_chains, sizeof(lk_chain));
+    threads = (pthread_t*) alloc_array((size_t) n_chains, sizeof(pthread_t));
+    lk_tour = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    start_tour = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    if (chain == NULL || threads == NULL || lk_tour == NULL || start_tour == NULL) {
+        free(chain);
+        free(threads);
+        free(lk_tour);
+        free(start_tour);
+        return concorde_error(DISCORDE_RETURN_NO_MEMORY, out_status);
+    }
+
+    /* The chains run until they are stopped (by Concorde returning, the target or the deadline) */
+    concorde_bound = CONCORDE_NO_BOUND;
+    lk_shared_init(&shared, n_nodes, data, n_edges, edges, in_tour, false, time_limit, target, -1, lk_tour, monitor);
+    shared.concorde_bound = &concorde_bound;
+    lk_chains_init(chain, n_chains, &shared, NULL, NULL);
+    n_started = lk_chains_start(chain, 0, n_chains, threads);
+
+    /* Without chains, nothing else measures the time limit */
+    if (n_started == 0 && time_limit != NULL) {
+        concorde_bound = *time_limit;
+    }
+
+    /* Wait for the first tour of the chains, which gives Concorde its upper bound */
+    pthread_mutex_lock(&shared.lock);
+    while (!shared.found && !shared.stop && shared.n_running > 0) {
+        pthread_cond_wait(&shared.changed, &shared.lock);
+    }
+    found = shared.found;
+    start_cost = 0;
+    if (found) {
+        memcpy(start_tour, lk_tour, sizeof(int) * (size_t) n_nodes);
+        start_cost = shared.best_cost;
+    }
+    run_concorde = !shared.stop;
+    pthread_mutex_unlock(&shared.lock);
+
+    /* Run Concorde, unless the chains have already reached the target or the deadline */
+    success = 0;
+    optimal = 0;
+    hit_timelimit = 0;
+    if (run_concorde) {
+        concorde_call(n_nodes, data, n_edges, edges, edges_costs, NULL, found ? start_tour : in_tour,
+                      found ? &start_cost : NULL, out_tour, out_cost, verbose, &concorde_bound, NULL, &success,
+                      &optimal, &hit_timelimit);
+    }
+
+    /* Concorde has returned: stop the chains */
+    lk_stop(&shared);
+    for (i = 0; i < n_started; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    lk_shared_destroy(&shared);
+    if (success == 1) {
+        discorde_monitor_report(monitor, n_nodes, out_tour, *out_cost, optimal != 0, *out_cost, shared.start);
+    }
+
+    /* Keep the best tour of both sides (a tour of the chains as good as an optimal one is optimal too) */
+    if (shared.found && (success != 1 || shared.best_cost <= *out_cost)) {
+        memcpy(out_tour, lk_tour, sizeof(int) * (size_t) n_nodes);
+        *out_cost = shared.best_cost;
+        success = 1;
+    }
+
+    /* Set solver status: the race may have been ended by the chains, which cancel Concorde through its time bound */
+    if (out_status != NULL) {
+        if (success == 1 && optimal != 0) {
+            *out_status = DISCORDE_STATUS_OPTIMAL;
+        } else if (success == 1 && target != NULL && *out_cost <= *target) {
+            *out_status = DISCORDE_STATUS_TARGET;
+        } else if (hit_timelimit == 1 || (shared.deadline >= 0 && discorde_wall_time() >= shared.deadline)) {
+            *out_status = DISCORDE_STATUS_TIMELIMIT;
+        } else {
+            *out_status = DISCORDE_STATUS_UNKNOWN;
+        }
+    }
+
+    free(chain);
+    free(threads);
+    free(lk_tour);
+    free(start_tour);
+
+    return (success == 1) ? DISCORDE_RETURN_OK : DISCORDE_RETURN_FAILURE;
+}
+
+int concorde_portfolio(int n_nodes, int n_edges, int* edges, int* edges_costs, int n_chains,
+                       int* out_tour, double* out_cost, int* out_status,
+                       int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+
+    /* Structures used by Lin-Kernighan heuristic */
+    CCdatagroup data;        /* Coordinate data defined by Concorde library */
+
+    /* Concorde indexes the endpoints of the edges with int */
+    if (n_edges < 0 || n_edges > EDGES_MAX) {
+        return concorde_error(DISCORDE_RETURN_TOO_LARGE, out_status);
+    }
+
+    /* The chains query the lengths from a datagroup, while Concorde works on the list of edges */
+    CCutil_init_datagroup(&data);
+    CCutil_graph2dat_sparse(n_nodes, n_edges, edges, edges_costs, 0, &data);
+
+    return_value = concorde_race(n_nodes, &data, n_edges, edges, edges_costs, n_chains, NULL, out_tour,
+                                 out_cost, out_status, in_tour, verbose, time_limit, target);
+
+    CCutil_freedatagroup(&data);
+
+    return return_value;
+}
+
+int concorde_full_portfolio(int n_nodes, int** cost_matrix, int n_chains,
+                            int* out_tour, double* out_cost, int* out_status,
+                            int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+
+    /* Variables to format data as required by both solvers */
+    matrix_view matrix;
+    CCdatagroup data;       /* Cost matrix of the instance */
+    int n_edges;            /* Number of candidate edges of the chains */
+    int* edges_list;        /* List of candidate edges of the chains (unidimensional) */
+
+    /* Concorde prices the edges against the matrix, the chains use the complete graph as in linkernighan_full */
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+    return_value = matrix_candidates(&matrix, 0, &data, &n_edges, &edges_list);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return concorde_error(return_value, out_status);
+    }
+
+    return_value = concorde_race(n_nodes, &data, n_edges, edges_list, NULL, n_chains, NULL, out_tour, out_cost,
+                                 out_status, in_tour, verbose, time_limit, target);
+
+    /* Free resources */
+    free(edges_list);
+    CCutil_freedatagroup(&data);
+
+    return return_value;
+}
+
+int concorde_coords_portfolio(int n_nodes, double* x, double* y, double* z, int norm, int n_chains,
+                              int* out_tour, double* out_cost, int* out_status,
+                              int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+
+    /* Variables to format data as required by both solvers */
+    CCdatagroup data;       /* Coordinates and norm of the instance */
+    int n_edges;            /* Number of candidate edges of the chains */
+    int* edges_list;        /* List of candidate edges of the chains (unidimensional) */
+
+    return_value = points_candidates(n_nodes, x, y, z, norm, &data, &n_edges, &edges_list);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return concorde_error(return_value, out_status);
+    }
+
+    return_value = concorde_race(n_nodes, &data, n_edges, edges_list, NULL, n_chains, NULL, out_tour, out_cost,
+                                 out_status, in_tour, verbose, time_limit, target);
+
+    /* Free resources */
+    CC_IFFREE(edges_list, int);
+    coords_dat_free(&data);
+
+    return return_value;
+}
+
+/*
+ * Pool of cuts shared by the solves of a family of instances. The cuts are valid inequalities of the TSP polytope of
+ * the nodes, whatever the costs of the edges, but they refer to the nodes through the labelling given to Concorde, so
+ * the pool keeps the labelling of the first solve and every later solve reuses it.
+ */
+struct discorde_cutpool {
+    int n_nodes;                /* Number of nodes of the instances, or 0 before the first solve */
+    int* perm;                  /* Labelling of the nodes: node i of the pool is node perm[i] of the instances */
+    CCtsp_lpcuts* cuts;         /* Cuts found so far, or NULL before the first solve */
+    CClp_warmstart* warmstart;  /* Basis of the last root LP, or NULL */
+    int warmstart_rows;         /* Number of rows of the LP of the basis */
+    int warmstart_cols;         /* Number of columns of the LP of the basis */
+};
+
+int discorde_cutpool_create(discorde_cutpool** out_pool)
+{
+    discorde_cutpool* pool;
+
+    pool = (discorde_cutpool*) malloc(sizeof(discorde_cutpool));
+    *out_pool = pool;
+    if (pool == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    pool->n_nodes = 0;
+    pool->perm = NULL;
+    pool->cuts = NULL;
+    pool->warmstart = NULL;
+    pool->warmstart_rows = 0;
+    pool->warmstart_cols = 0;
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Empty a pool, so the next solve starts a new labelling.
+ */
+static void cutpool_clear(discorde_cutpool* pool)
+{
+    if (pool->cuts != NULL) {
+        CCtsp_free_cutpool(&pool->cuts);
+    }
+    if (pool->warmstart != NULL) {
+        CClp_free_warmstart(&pool->warmstart);
+    }
+    free(pool->perm);
+    pool->n_nodes = 0;
+    pool->perm = NULL;
+    pool->cuts = NULL;
+    pool->warmstart = NULL;
+    pool->warmstart_rows = 0;
+    pool->warmstart_cols = 0;
+}
+
+void discorde_cutpool_free(discorde_cutpool* pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    cutpool_clear(pool);
+    free(pool);
+}
+
+int discorde_cutpool_size(const discorde_cutpool* pool)
+{
+    return (pool->cuts != NULL) ? pool->cuts->cutcount : 0;
+}
+
+/*
+ * Prepare a pool for a solve over {@code n_nodes} nodes. A pool of another number of nodes is emptied first, and an
+ * empty pool takes the labelling of {@code in_tour} (or the identity if it is NULL), so the cuts of the family refer
+ * to nodes close along a good tour, as Concorde does.
+ */
+static int cutpool_prepare(discorde_cutpool* pool, int n_nodes, const int* in_tour)
+{
+    int i;
+
+    if (pool->cuts != NULL && pool->n_nodes == n_nodes) {
+        return DISCORDE_RETURN_OK;
+    }
+
+    cutpool_clear(pool);
+    pool->perm = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    if (pool->perm == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    for (i = 0; i < n_nodes; ++i) {
+        pool->perm[i] = (in_tour != NULL) ? in_tour[i] : i;
+    }
+    if (CCtsp_init_cutpool(&n_nodes, NULL, &pool->cuts) != 0) {
+        cutpool_clear(pool);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    pool->n_nodes = n_nodes;
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Length given to the pairs of nodes that are not edges of a list, so that no optimal tour uses one of them when the
+ * list has a Hamiltonian cycle (it is the cost of n_nodes edges of the largest cost plus one, as far as it fits).
+ */
+static int cutpool_missing_len(int n_nodes, int n_edges, const int* edges_costs)
+{
+    int i, max_cost;
+
+    max_cost = 0;
+    for (i = 0; i < n_edges; ++i) {
+        if (edges_costs[i] > max_cost) {
+            max_cost = edges_costs[i];
+        }
+    }
+
+    if (n_nodes > 0 && max_cost < (INT_MAX / 2 - 1) / n_nodes) {
+        return max_cost * n_nodes + 1;
+    }
+
+    return INT_MAX / 2;
+}
+
+/*
+ * Interval in seconds of wall-clock time between two saves of the branch-and-bound tree of a checkpointed run.
+ */
+#define BB_SAVE_INTERVAL 30.0
+
+/*
+ * Options of a branch-and-cut run over a cut pool: the monitor told of each new best tour (cancelling it stops the run
+ * as the time limit would), the checkpoint where the tree and the best tour are saved, and the tree of the checkpoint
+ * to resume. Each of them may be NULL. The stop flag is set by {@code concorde_pool_call}: it is registered with the
+ * monitor, which raises it with an atomic store, and polled with an atomic load between the nodes of the
+ * branch-and-bound, so the lock of the monitor is never taken there.
+ */
+typedef struct bb_options {
+    discorde_monitor* monitor;
+    discorde_checkpoint* checkpoint;
+    discorde_bb_tree* resume;
+    int* stop;
+} bb_options;
+
+/*
+ * State of the branch-and-bound run by Discorde over the problem files of Concorde. Concorde runs the cutting loop of
+ * each node and chooses its branch, while Discorde keeps the frontier, so it can poll its stop conditions between the
+ * nodes, report each new best tour and save the frontier for a later run.
+ */
+typedef struct bb_run {
+    int n_nodes;
+    CCdatagroup* data;
+    discorde_cutpool* pool;
+    CCrandstate* rstate;
+    char* filename;             /* Name given to Concorde for the problem files */
+    int silent;
+    CCtsp_cutselect sel;        /* Cut selection of the cutting loops */
+    discorde_bb_tree tree;      /* Frontier, labelled by the pool */
+    int* stale;                 /* Ids of the problem files of processed nodes, deleted once the frontier is saved */
+    int n_stale;
+    int stale_capacity;
+    int* best_tour;             /* Best tour found, relabelled */
+    double* upper_bound;        /* Cost of best_tour */
+    int* buffer;                /* Best tour translated back to the nodes of the instance */
+    double start;
+    double deadline;            /* Wall-clock time at which the run stops */
+    double last_save;
+    const bb_options* options;
+} bb_run;
+
+/*
+ * Translate a relabelled tour back to the nodes of the instance (in {@code buffer}), save it to the checkpoint and
+ * report it to the monitor of {@code options}, along with the lower bound if it is known. Costs are integers, so the
+ * tour is optimal once the lower bound is within 1 of its cost.
+
+ */
+static void bb_report(const bb_options* options, int n_nodes, const int* perm, const int* tour, double cost,
+                      bool lower_bound_known, double lower_bound, int* buffer, double start)
+{
+    int i;
+
+    for (i = 0; i < n_nodes; ++i) {
+        buffer[i] = perm[tour[i]];
+    }
+    if (options->checkpoint != NULL) {
+        discorde_checkpoint_write(options->checkpoint, buffer, cost, lower_bound_known && lower_bound >= cost - 0.9);
+    }
+    discorde_monitor_report(options->monitor, n_nodes, buffer, cost, lower_bound_known,
+                            (lower_bound < cost) ? lower_bound : cost, start);
+}
+
+/*
+ * Return the lower bound of the frontier, i.e., the least bound of its active nodes (the cost of the best tour if it
+ * is empty).
+ */
+static double bb_lower_bound(const bb_run* run)
+{
+    int i;
+    double lower_bound;
+
+    lower_bound = *run->upper_bound;
+    for (i = 0; i < run->tree.n_active; ++i) {
+        if (run->tree.active[i].lower_bound < lower_bound) {
+            lower_bound = run->tree.active[i].lower_bound;
+        }
+    }
+
+    return lower_bound;
+}
+
+/*
+ * Add a node to the frontier. Returns {@code DISCORDE_RETURN_OK} on success, or {@code DISCORDE_RETURN_NO_MEMORY}.
+ */
+static int bb_push(discorde_bb_tree* tree, int id, int cut, double lower_bound)
+{
+    int capacity;
+    discorde_bb_node* active;
+
+    if (tree->n_active == tree->capacity) {
+        capacity = 2 * tree->capacity + 16;
+        active = (discorde_bb_node*) realloc(tree->active, sizeof(discorde_bb_node) * (size_t) capacity);
+        if (active == NULL) {
+            return DISCORDE_RETURN_NO_MEMORY;
+        }
+        tree->active = active;
+        tree->capacity = capacity;
+    }
+
+    tree->active[tree->n_active].id = id;
+    tree->active[tree->n_active].cut = cut;
+    tree->active[tree->n_active].lower_bound = lower_bound;
+    ++tree->n_active;
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Remove the node at {@code index} from the frontier (the last node takes its place).
+ */
+static void bb_remove(discorde_bb_tree* tree, int index)
+{
+    tree->active[index] = tree->active[--tree->n_active];
+}
+
+/*
+ * Drop the problem file of a processed node. Without a checkpoint it is deleted at once; otherwise the saved frontier
+ * may still refer to it, so it is deleted after the next save. Returns {@code DISCORDE_RETURN_OK} on success, or
+ * {@code DISCORDE_RETURN_NO_MEMORY}.
+ */
+static int bb_retire(bb_run* run, int id)
+{
+    int capacity;
+    int* stale;
+
+    if (run->options->checkpoint == NULL) {
+        CCtsp_prob_file_delete(run->filename, id);
+        return DISCORDE_RETURN_OK;
+    }
+
+    if (run->n_stale == run->stale_capacity) {
+        capacity = 2 * run->stale_capacity + 16;
+        stale = (int*) realloc(run->stale, sizeof(int) * (size_t) capacity);
+        if (stale == NULL) {
+            return DISCORDE_RETURN_NO_MEMORY;
+        }
+        run->stale = stale;
+        run->stale_capacity = capacity;
+    }
+    run->stale[run->n_stale++] = id;
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Save the frontier to the checkpoint (if any): the cut pool first, then the tree file, which refers to it and to the
+ * problem files of the active nodes. The problem files of the nodes processed since the last save are deleted once it
+ * is on disk.
+ */
+static void bb_save(bb_run* run)
+{
+    int k;
+    FILE* file;
+    discorde_checkpoint* checkpoint;
+
+    checkpoint = run->options->checkpoint;
+    if (checkpoint == NULL) {
+        return;
+    }
+    run->last_save = discorde_wall_time();
+
+    if (CCtsp_write_cutpool(run->n_nodes, checkpoint->pool_temp_path, run->pool->cuts) != 0) {
+        unlink(checkpoint->pool_temp_path);
+        checkpoint->failed = 1;
+        return;
+    }
+    file = fopen(checkpoint->pool_temp_path, "a");
+    if (file == NULL) {
+        unlink(checkpoint->pool_temp_path);
+        checkpoint->failed = 1;
+        return;
+    }
+    if (discorde_checkpoint_commit(file, 0, checkpoint->pool_temp_path, checkpoint->pool_path) != DISCORDE_RETURN_OK
+        || discorde_checkpoint_write_tree(checkpoint, &run->tree) != DISCORDE_RETURN_OK) {
+        checkpoint->failed = 1;
+        return;
+    }
+
+    for (k = 0; k < run->n_stale; ++k) {
+        CCtsp_prob_file_delete(run->filename, run->stale[k]);
+    }
+    run->n_stale = 0;
+}
+
+/*
+ * Process the active node at {@code index}: run the cutting loop of a node that has not been cut yet, or else split it
+ * on the branch chosen by Concorde into two children. Concorde may find a better tour on the way, which is reported.
+ * Returns 0 on success, or a non-zero value if Concorde fails or memory runs out (the node is then kept).
+ */
+static int bb_process(bb_run* run, int index)
+{
+    discorde_bb_node node;
+    int id;                     /* Id of the first new problem file */
+    int prune, prune0, prune1;  /* Set to 1 if a node cannot hold a tour better than the best one */
+    int found_tour;             /* Set to 1 if Concorde has improved the best tour */
+    int n_got;                  /* Number of branches chosen */
+    double value, value0, value1;
+    CCtsp_branchobj* branch;
+
+    node = run->tree.active[index];
+    id = run->tree.next_id;
+    prune = 0;
+    found_tour = 0;
+    if (!node.cut) {
+        if (CCtsp_bb_cutting(run->filename, node.id, id, run->n_nodes, run->data, run->pool->perm, run->upper_bound,
+                             run->pool->cuts, &run->sel, &value, &prune, &found_tour, run->best_tour, 0, run->silent,
+                             run->rstate) != 0) {
+            return 1;
+        }
+        run->tree.next_id = id + 1;
+        if (prune) {
+            bb_remove(&run->tree, index);
+        } else {
+            run->tree.active[index].id = id;
+            run->tree.active[index].cut = 1;
+            run->tree.active[index].lower_bound = value;
+        }
+    } else {
+        branch = NULL;
+        n_got = 0;
+        if (CCtsp_bb_find_branch(run->filename, node.id, run->n_nodes, run->data, run->pool->perm, run->upper_bound,
+                                 run->pool->cuts, 1, &n_got, &branch, 0, 0, &prune, &found_tour, run->best_tour,
+                                 run->silent, run->rstate) != 0) {
+            return 1;
+        }
+        if (prune) {
+            bb_remove(&run->tree, index);
+        } else if (n_got == 0) {
+            return 1;
+        } else {
+            if (CCtsp_bb_splitprob(run->filename, node.id, run->n_nodes, run->data, run->pool->perm,
+                                   *run->upper_bound, run->pool->cuts, branch, id, id + 1, &value0, &value1, &prune0,
+                                   &prune1, run->silent, run->rstate) != 0) {
+                CCtsp_free_branchobj(branch);
+                CC_IFFREE(branch, CCtsp_branchobj);
+                return 1;
+            }
+            CCtsp_free_branchobj(branch);
+            CC_IFFREE(branch, CCtsp_branchobj);
+            run->tree.next_id = id + 2;
+            bb_remove(&run->tree, index);
+            if ((!prune0 && bb_push(&run->tree, id, 0, value0) != DISCORDE_RETURN_OK)
+                || (!prune1 && bb_push(&run->tree, id + 1, 0, value1) != DISCORDE_RETURN_OK)) {
+                return 1;
+            }
+        }
+    }
+
+    if (found_tour) {
+        bb_report(run->options, run->n_nodes, run->pool->perm, run->best_tour, *run->upper_bound, true,
+                  bb_lower_bound(run), run->buffer, run->start);
+    }
+
+    return bb_retire(run, node.id) != DISCORDE_RETURN_OK;
+}
+
+/*
+ * Run the branch-and-bound from the frontier of {@code run}, best bound first, until it is empty (the best tour is then
+ * optimal), the deadline passes or the stop flag is raised (which sets {@code hit_timelimit}), or Concorde fails. The
+ * frontier is saved to the checkpoint periodically.
+ */
+static void bb_branch(bb_run* run, int* optimal, int* hit_timelimit)
+{
+    int i, best, failed;
+
+    failed = 0;
+    while (run->tree.n_active > 0 && !failed) {
+
+        /* Nodes whose bound cannot beat the best tour are pruned */
+        for (i = run->tree.n_active - 1; i >= 0 && !failed; --i) {
+            if (run->tree.active[i].lower_bound >= *run->upper_bound - 0.9) {
+                failed = bb_retire(run, run->tree.active[i].id) != DISCORDE_RETURN_OK;
+                bb_remove(&run->tree, i);
+            }
+        }
+        if (run->tree.n_active == 0 || failed) {
+            break;
+        }
+
+        /* The stop conditions are polled between the nodes */
+        if (discorde_wall_time() >= run->deadline || __atomic_load_n(run->options->stop, __ATOMIC_RELAXED)) {
+            *hit_timelimit = 1;
+            break;
+        }
+
+        best = 0;
+        for (i = 1; i < run->tree.n_active; ++i) {
+            if (run->tree.active[i].lower_bound < run->tree.active[best].lower_bound) {
+                best = i;
+            }
+        }
+        failed = bb_process(run, best) != 0;
+
+        if (discorde_wall_time() - run->last_save >= BB_SAVE_INTERVAL) {
+            bb_save(run);
+        }
+    }
+
+    *optimal = (run->tree.n_active == 0 && !failed && !*hit_timelimit) ? 1 : 0;
+}
+
+/*
+ * Solve the root LP of the relabelled instance of {@code run} over the given edges and add the root problem to the
+ * frontier, unless the tour is already proven optimal. The root LP starts from the cuts of the pool that are violated
+ * (Concorde prices them with CCtsp_search_cutpool on the new costs while separating). The cuts and the basis of the
+ * final root LP are kept in the pool for the next solve; the basis is only loaded into a root LP of the same numbers of
+ * rows and columns, which the cutting loop of the last solve usually changed. Returns 0 on success, or a non-zero
+ * value if the LP cannot be built or solved.
+ */
+static int bb_root(bb_run* run, int n_lp_edges, int* lp_edges, int* lp_costs)
+{
+
+    /* Auxiliary variables */
+    int k;
+    discorde_cutpool* pool;
+    double lower_bound;     /* Bound of the root LP */
+
+    /* Variables and structures used by Concorde solver */
+    CCtsp_lp* lp;           /* Root LP */
+
+    /* Root LP over the edges of the list, also given as the full edge set so no other pair of nodes is ever priced */
+    pool = run->pool;
+    lp = NULL;
+    if (CCtsp_init_lp(&lp, run->filename, -1, NULL, run->n_nodes, run->data, n_lp_edges, lp_edges, lp_costs,
+                      n_lp_edges, lp_edges, lp_costs, 1, pool->perm, *run->upper_bound, pool->cuts, NULL, run->silent,
+                      run->rstate) != 0) {
+        if (lp != NULL) {
+            CCtsp_free_tsp_lp_struct(&lp);
+        }
+        return 1;
+    }
+
+    /* The basis of the last root LP of the pool only fits a root LP of the same size; one that does not fit or that the
+     * LP solver refuses is dropped, and the LP starts cold */
+    if (pool->warmstart != NULL) {
+        if (CClp_nrows(lp->lp) != pool->warmstart_rows || CClp_ncols(lp->lp) != pool->warmstart_cols
+            || CClp_load_warmstart(lp->lp, pool->warmstart) != 0) {
+            CClp_free_warmstart(&pool->warmstart);
+            pool->warmstart = NULL;
+        }
+    }
+    if (CCtsp_cutting_loop(lp, &run->sel, 0, run->silent, run->rstate) != 0) {
+        CCtsp_free_tsp_lp_struct(&lp);
+        return 1;
+    }
+
+    /* The basis of the final root LP is kept for the next solve */
+    if (pool->warmstart != NULL) {
+        CClp_free_warmstart(&pool->warmstart);
+    }
+    if (CClp_get_warmstart(lp->lp, &pool->warmstart) != 0) {
+        pool->warmstart = NULL;
+    }
+    pool->warmstart_rows = CClp_nrows(lp->lp);
+    pool->warmstart_cols = CClp_ncols(lp->lp);
+
+    /* The cuts of the root LP go to the pool (the pool skips those it already holds) */
+    for (k = 0; k < lp->cuts.cutcount; ++k) {
+        CCtsp_add_to_cutpool(pool->cuts, &lp->cuts, &lp->cuts.cuts[k]);
+    }
+
+    /* Costs are integers, so the tour is optimal once the bound is within 1 of its cost */
+    lower_bound = lp->lowerbound;
+    if (lower_bound >= *run->upper_bound - 0.9) {
+        CCtsp_free_tsp_lp_struct(&lp);
+        return 0;
+    }
+
+    /* Otherwise the root problem is written to a file, from which the branching reads it back */
+    if (CCtsp_write_probroot_id(run->filename, lp) != 0) {
+        CCtsp_free_tsp_lp_struct(&lp);
+        return 1;
+    }
+    run->tree.next_id = lp->id + 1;
+    k = bb_push(&run->tree, lp->id, 1, lower_bound);
+    CCtsp_free_tsp_lp_struct(&lp);
+
+    return k != DISCORDE_RETURN_OK;
+}
+
+/*
+ * Solve the relabelled instance {@code data} by branch-and-cut from the tour {@code best_tour} of cost
+ * {@code upper_bound}, both updated with the best tour found: the root LP (see {@code bb_root}), or else the frontier
+ * of the checkpoint to resume, then the branch-and-bound of {@code bb_branch}, which stops at {@code deadline}. The
+ * problem files are named after {@code filename}. With a checkpoint, the frontier is saved after the root, periodically
+ * and at the end, and removed once the tour is proven optimal. Sets {@code optimal} and {@code hit_timelimit}; if the
+ * LP cannot be built, the tour is left as it is and neither flag is set.
+ */
+static void concorde_pool_branch(int n_nodes, CCdatagroup* data, int n_lp_edges, int* lp_edges, int* lp_costs,
+                                 discorde_cutpool* pool, CCrandstate* rstate, char* filename, bool verbose,
+                                 double deadline, double start, const bb_options* options, int* best_tour,
+                                 double* upper_bound, int* buffer, int* optimal, int* hit_timelimit)
+{
+    bb_run run;
+
+    run.n_nodes = n_nodes;
+    run.data = data;
+    run.pool = pool;
+    run.rstate = rstate;
+    run.filename = filename;
+    run.silent = verbose ? 0 : 1;
+    CCtsp_init_cutselect(&run.sel);
+    run.sel.cutpool = 1;
+    run.tree.perm = pool->perm;
+    run.tree.next_id = 0;
+    run.tree.n_active = 0;
+    run.tree.capacity = 0;
+    run.tree.active = NULL;
+    run.stale = NULL;
+    run.n_stale = 0;
+    run.stale_capacity = 0;
+    run.best_tour = best_tour;
+    run.upper_bound = upper_bound;
+    run.buffer = buffer;
+    run.start = start;
+    run.deadline = deadline;
+    run.last_save = discorde_wall_time();
+    run.options = options;
+
+    /* A resumed run takes over the frontier of the checkpoint, a new one starts from the root, saved at once */
+    if (options->resume != NULL) {
+        run.tree.next_id = options->resume->next_id;
+        run.tree.n_active = options->resume->n_active;
+        run.tree.capacity = options->resume->capacity;
+        run.tree.active = options->resume->active;
+        options->resume->active = NULL;
+        options->resume->n_active = 0;
+        options->resume->capacity = 0;
+    } else if (bb_root(&run, n_lp_edges, lp_edges, lp_costs) != 0) {
+        free(run.tree.active);
+        return;
+    } else {
+        bb_save(&run);
+    }
+
+    bb_branch(&run, optimal, hit_timelimit);
+
+    /* The proof of optimality is reported, and leaves nothing to resume; otherwise the frontier is saved for a later
+     * run */
+    if (*optimal) {
+        bb_report(options, n_nodes, pool->perm, best_tour, *upper_bound, true, *upper_bound, buffer, start);
+        if (options->checkpoint != NULL) {
+            discorde_checkpoint_reset(options->checkpoint);
+        }
+    } else {
+        bb_save(&run);
+    }
+
+    /* Free resources */
+    free(run.tree.active);
+    free(run.stale);
+}
+
+/*
+ * Run Concorde branch-and-cut over a list of edges with the cuts of {@code pool} (see {@code concorde_pool_branch}).
+ * The instance is handed to Concorde relabelled by the pool, and its tours are translated back. The initial upper
+ * bound is a Lin-Kernighan tour started from {@code in_tour}, or else from the labelling tour of the pool, i.e., the
+ * tour the family was first labelled by; it is reported and saved as the tours found while branching are. A resumed
+ * run (see {@code bb_options}, which may be NULL) starts from {@code in_tour} as it is, the best tour of the
+ * checkpoint. Instances of at most EXACT_NODES_MAX nodes are solved by the dynamic program instead, as in
+ * {@code concorde_call}, and leave the pool as it is. Sets the output flags as {@code concorde_call} does, and returns
+ * {@code DISCORDE_RETURN_FAILURE} if the instance has less than 3 nodes, or {@code DISCORDE_RETURN_NO_MEMORY} if a
+ * buffer cannot be allocated.
+ */
+static int concorde_pool_call(int n_nodes, int n_edges, int* edges, int* edges_costs, discorde_cutpool* pool,
+                              const bb_options* options, int* in_tour, int* out_tour, double* out_cost, bool verbose,
+                              double* time_limit, int* success, int* optimal, int* hit_timelimit)
+{
+
+    /* Auxiliary variables */
+    int i, k, u, v, exact;
+    unsigned long call_id;
+    double start;
+    double deadline;        /* Wall-clock time at which the branching stops */
+    int missing_len;        /* Length of the pairs of nodes that are not edges */
+    int n_lp_edges;         /* Number of edges of the list plus the missing edges of the starting tour */
+    int* inverse;           /* Inverse of the labelling of the pool */
+    int* lp_edges;          /* Edges relabelled by the pool, followed by the missing edges of the starting tour */
+    int* lp_costs;
+    int* start_tour;        /* Starting tour of Lin-Kernighan heuristic, relabelled (then a buffer of the reports) */
+    int* best_tour;         /* Best tour found, relabelled */
+    double upper_bound;     /* Cost of best_tour */
+    bb_options own_options; /* Options of the caller, with the stop flag of the run */
+    int stop;               /* Raised by the monitor to cancel the run */
+    discorde_watch watch;
+
+    /* Variables and structures used by Concorde solver */
+    discorde_scratch scratch;   /* Scratch directory of the run, removed with its files afterwards */
+    CCrandstate rstate;     /* Rand state structure defined by Concorde library */
+    CCdatagroup data;       /* Sparse datagroup of the relabelled instance */
+
+    own_options.monitor = (options != NULL) ? options->monitor : NULL;
+    own_options.checkpoint = (options != NULL) ? options->checkpoint : NULL;
+    own_options.resume = (options != NULL) ? options->resume : NULL;
+    own_options.stop = &stop;
+    options = &own_options;
+    stop = 0;
+
+    *success = 0;
+    *optimal = 0;
+    *hit_timelimit = 0;
+    if (n_nodes < 3) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    /* Small instances are solved at once by the dynamic program, whose optimal tour is saved and reported */
+    start = discorde_wall_time();
+    if (n_nodes <= EXACT_NODES_MAX) {
+        exact = exact_solve(n_nodes, NULL, n_edges, edges, edges_costs, out_tour, out_cost);
+        if (exact != DISCORDE_RETURN_NO_MEMORY) {
+            if (exact == DISCORDE_RETURN_OK) {
+                *success = 1;
+                *optimal = 1;
+                if (options->checkpoint != NULL) {
+                    discorde_checkpoint_write(options->checkpoint, out_tour, *out_cost, true);
+                }
+                discorde_monitor_report(options->monitor, n_nodes, out_tour, *out_cost, true, *out_cost, start);
+            }
+            return DISCORDE_RETURN_OK;
+        }
+    }
+
+    if (cutpool_prepare(pool, n_nodes, in_tour) != DISCORDE_RETURN_OK) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    inverse = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    start_tour = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    best_tour = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    lp_edges = (int*) alloc_array(2 * ((size_t) n_edges + (size_t) n_nodes), sizeof(int));
+    lp_costs = (int*) alloc_array((size_t) n_edges + (size_t) n_nodes, sizeof(int));
+    CCutil_init_datagroup(&data);
+    if (inverse == NULL || start_tour == NULL || best_tour == NULL || lp_edges == NULL || lp_costs == NULL) {
+        free(inverse);
+        free(start_tour);
+        free(best_tour);
+        free(lp_edges);
+        free(lp_costs);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    /* Initialize Concorde structures */
+    call_id = next_call_id();
+    CCutil_sprand(call_seed(call_id), &rstate);
+
+    /* Relabel the instance by the pool */
+    for (i = 0; i < n_nodes; ++i) {
+        inverse[pool->perm[i]] = i;
+    }
+    for (k = 0; k < n_edges; ++k) {
+        lp_edges[2 * k] = inverse[edges[2 * k]];
+        lp_edges[2 * k + 1] = inverse[edges[2 * k + 1]];
+        lp_costs[k] = edges_costs[k];
+    }
+    missing_len = cutpool_missing_len(n_nodes, n_edges, edges_costs);
+    if (CCutil_graph2dat_sparse(n_nodes, n_edges, lp_edges, lp_costs, missing_len, &data) != 0) {
+        free(inverse);
+        free(start_tour);
+        free(best_tour);
+        free(lp_edges);
+        free(lp_costs);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    /* Initial upper bound: the tour of the caller, or else the labelling tour of the pool, improved by LK */
+    for (i = 0; i < n_nodes; ++i) {
+        start_tour[i] = (in_tour != NULL) ? inverse[in_tour[i]] : i;
+    }
+    if (options->resume != NULL) {
+        upper_bound = 0;
+        for (i = 0; i < n_nodes; ++i) {
+            best_tour[i] = start_tour[i];
+            upper_bound += CCutil_dat_edgelen(start_tour[i], start_tour[(i + 1) % n_nodes], &data);
+        }
+    } else {
+        linkernighan_dat(n_nodes, &data, n_edges, lp_edges, &rstate, best_tour, &upper_bound, start_tour, verbose,
+                         time_limit, NULL);
+        bb_report(options, n_nodes, pool->perm, best_tour, upper_bound, false, 0, start_tour, start);
+    }
+    *success = 1;
+
+    /* The LP must hold a Hamiltonian cycle, so the missing edges of the tour (if any) are added to it */
+    n_lp_edges = n_edges;
+    for (i = 0; i < n_nodes; ++i) {
+        u = best_tour[i];
+        v = best_tour[(i + 1) % n_nodes];
+        if (CCutil_dat_edgelen(u, v, &data) == missing_len) {
+            lp_edges[2 * n_lp_edges] = u;
+            lp_edges[2 * n_lp_edges + 1] = v;
+            lp_costs[n_lp_edges] = missing_len;
+            ++n_lp_edges;
+        }
+    }
+
+    /* The branching gets the time left by the heuristic, and the monitor cancels it through the stop flag */
+    deadline = (time_limit != NULL) ? start + *time_limit : CONCORDE_NO_BOUND;
+    discorde_monitor_watch(options->monitor, &watch, NULL, &stop);
+
+    /* Concorde writes its problem files to the checkpoint, or else to a scratch directory of its own (the tour of LK
+     * is kept if it fails) */
+    if (options->checkpoint != NULL) {
+        CONCORDE_LOCK();
+        concorde_pool_branch(n_nodes, &data, n_lp_edges, lp_edges, lp_costs, pool, &rstate,
+                             options->checkpoint->problem_name, verbose, deadline, start, options, best_tour,
+                             &upper_bound, start_tour, optimal, hit_timelimit);
+        CONCORDE_UNLOCK();
+    } else if (discorde_scratch_open(call_id, &scratch) == DISCORDE_RETURN_OK) {
+        CONCORDE_LOCK();
+        concorde_pool_branch(n_nodes, &data, n_lp_edges, lp_edges, lp_costs, pool, &rstate, scratch.filename, verbose,
+                             deadline, start, options, best_tour, &upper_bound, start_tour, optimal, hit_timelimit);
+        CONCORDE_UNLOCK();
+        discorde_scratch_close(&scratch);
+    }
+    discorde_monitor_unwatch(options->monitor, &watch);
+
+    /* Translate the best tour back to the nodes of the instance */
+    for (i = 0; i < n_nodes; ++i) {
+        out_tour[i] = pool->perm[best_tour[i]];
+    }
+    *out_cost = upper_bound;
+
+    /* Free resources */
+    CCutil_freedatagroup(&data);
+    free(inverse);
+    free(start_tour);
+    free(best_tour);
+    free(lp_edges);
+    free(lp_costs);
+
+    return DISCORDE_RETURN_OK;
+}
+
+int concorde_pooled(int n_nodes, int n_edges, int* edges, int* edges_costs, discorde_cutpool* pool,
+                    int* out_tour, double* out_cost, int* out_status,
+                    int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+
+    /* Output flags of Concorde solver */
+    int success;        /* Set to 1 if a feasible tour is found */
+    int optimal;        /* Set to 1 if tour found is optimal */
+    int hit_timelimit;  /* Set to 1 if the time limit is reached */
+
+    /* Concorde indexes the endpoints of the edges (and of the missing edges of a tour) with int */
+    if (n_edges < 0 || n_edges > EDGES_MAX - n_nodes) {
+        return concorde_error(DISCORDE_RETURN_TOO_LARGE, out_status);
+    }
+
+    return_value = concorde_pool_call(n_nodes, n_edges, edges, edges_costs, pool, NULL, in_tour, out_tour, out_cost,
+                                      verbose, time_limit, &success, &optimal, &hit_timelimit);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return concorde_error(return_value, out_status);
+    }
+
+    /* Set solver status and return value */
+    return concorde_result(success, optimal, hit_timelimit, out_cost, out_status, target, NULL);
+}
+
+/*
+ * Run Concorde branch-and-cut over a list of edges with a cut pool of its own, as {@code concorde_pooled} does with a
+ * new pool, saving each new best tour, the cut pool and the frontier of the branch-and-bound to a checkpoint in
+ * {@code checkpoint_dir}. If {@code resume} is set, the run continues the branch-and-bound of the checkpoint (or, if
+ * only its tour was saved, starts over from it), and it is skipped if that tour is optimal.
+ */
+static int concorde_checkpointed(int n_nodes, int n_edges, int* edges, int* edges_costs, const char* checkpoint_dir,
+                                 bool resume, int* out_tour, double* out_cost, int* out_status,
+                                 int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+    int n_pool;                 /* Number of nodes of the saved pool */
+    bool saved_optimal;         /* Whether the tour of the checkpoint is optimal */
+    int* resume_tour;           /* Tour of the checkpoint, the starting tour of a resumed run */
+    double resume_cost;
+    discorde_cutpool* pool;     /* Cut pool of the run, read back from the checkpoint when resuming */
+    discorde_bb_tree tree;      /* Frontier of the checkpoint */
+    discorde_checkpoint checkpoint;
+    bb_options options;
+
+    /* Output flags of Concorde solver */
+    int success;        /* Set to 1 if a feasible tour is found */
+    int optimal;        /* Set to 1 if tour found is optimal */
+    int hit_timelimit;  /* Set to 1 if the time limit is reached */
+
+    /* Concorde indexes the endpoints of the edges (and of the missing edges of a tour) with int */
+    if (n_edges < 0 || n_edges > EDGES_MAX - n_nodes) {
+        return concorde_error(DISCORDE_RETURN_TOO_LARGE, out_status);
+    }
+    if (discorde_checkpoint_init(&checkpoint, checkpoint_dir, n_nodes, n_edges, edges, edges_costs)
+        != DISCORDE_RETURN_OK) {
+        return concorde_error(DISCORDE_RETURN_FAILURE, out_status);
+    }
+
+    resume_tour = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    if (resume_tour == NULL || discorde_cutpool_create(&pool) != DISCORDE_RETURN_OK) {
+        free(resume_tour);
+        return concorde_error(DISCORDE_RETURN_NO_MEMORY, out_status);
+    }
+    options.monitor = NULL;
+    options.checkpoint = &checkpoint;
+    options.resume = NULL;
+
+    if (resume) {
+        if (discorde_checkpoint_read(&checkpoint, resume_tour, &resume_cost, &saved_optimal) != DISCORDE_RETURN_OK) {
+            discorde_cutpool_free(pool);
+            free(resume_tour);
+            return concorde_error(DISCORDE_RETURN_FAILURE, out_status);
+        }
+
+        /* An optimal tour has nothing left to improve */
+        if (saved_optimal) {
+            memcpy(out_tour, resume_tour, sizeof(int) * (size_t) n_nodes);
+            *out_cost = resume_cost;
+            discorde_cutpool_free(pool);
+            free(resume_tour);
+            if (out_status != NULL) {
+                *out_status = DISCORDE_STATUS_OPTIMAL;
+            }
+            return DISCORDE_RETURN_OK;
+        }
+
+        checkpoint.written = 1;
+        checkpoint.cost = resume_cost;
+        in_tour = resume_tour;
+
+        /* The frontier resumes with the labelling and the pool it was saved with */
+        if (discorde_checkpoint_read_tree(&checkpoint, &tree) == DISCORDE_RETURN_OK) {
+            n_pool = n_nodes;
+            if (CCtsp_init_cutpool(&n_pool, checkpoint.pool_path, &pool->cuts) == 0 && n_pool == n_nodes) {
+                pool->n_nodes = n_nodes;
+                pool->perm = tree.perm;
+                tree.perm = NULL;
+                options.resume = &tree;
+            } else {
+                if (pool->cuts != NULL) {
+                    CCtsp_free_cutpool(&pool->cuts);
+                }
+                discorde_bb_tree_free(&tree);
+            }
+        }
+    }
+
+    /* A new run replaces the tree of a previous one */
+    if (options.resume == NULL && discorde_checkpoint_reset(&checkpoint) != DISCORDE_RETURN_OK) {
+        discorde_cutpool_free(pool);
+        free(resume_tour);
+        return concorde_error(DISCORDE_RETURN_FAILURE, out_status);
+    }
+
+    return_value = concorde_pool_call(n_nodes, n_edges, edges, edges_costs, pool, &options, in_tour, out_tour,
+                                      out_cost, verbose, time_limit, &success, &optimal, &hit_timelimit);
+
+    /* Free resources */
+    if (options.resume != NULL) {
+        discorde_bb_tree_free(&tree);
+    }
+    discorde_cutpool_free(pool);
+    free(resume_tour);
+
+    if (return_value != DISCORDE_RETURN_OK) {
+        return concorde_error(return_value, out_status);
+    }
+
+    /* Set solver status and return value */
+    return concorde_result(success, optimal, hit_timelimit, out_cost, out_status, target, NULL);
+}
+
+int concorde_checkpoint(int n_nodes, int n_edges, int* edges, int* edges_costs, const char* checkpoint_dir,
+                        int* out_tour, double* out_cost, int* out_status,
+                        int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return concorde_checkpointed(n_nodes, n_edges, edges, edges_costs, checkpoint_dir, false, out_tour, out_cost,
+                                 out_status, in_tour, verbose, time_limit, target);
+}
+
+int concorde_resume(int n_nodes, int n_edges, int* edges, int* edges_costs, const char* checkpoint_dir,
+                    int* out_tour, double* out_cost, int* out_status,
+                    bool verbose, double* time_limit, double* target)
+{
+    return concorde_checkpointed(n_nodes, n_edges, edges, edges_costs, checkpoint_dir, true, out_tour, out_cost,
+                                 out_status, NULL, verbose, time_limit, target);
+}
+
+/*
+ * Number of nearest neighbors of each node in the candidate set of the Lin-Kernighan tour that a monitored run over a
+ * cost matrix reports before Concorde starts.
+ */
+#define MONITOR_K_NEAREST 10
+
+int concorde_monitored(int n_nodes, int n_edges, int* edges, int* edges_costs, discorde_monitor* monitor,
+                       int* out_tour, double* out_cost, int* out_status,
+                       int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+    discorde_cutpool* pool;     /* Cut pool of the run alone */
+    bb_options options;
+
+    /* Output flags of Concorde solver */
+    int success;        /* Set to 1 if a feasible tour is found */
+    int optimal;        /* Set to 1 if tour found is optimal */
+    int hit_timelimit;  /* Set to 1 if the time limit is reached */
+
+    /* Small instances are solved at once by the dynamic program, which reports its optimal tour */
+    if (monitor == NULL || n_nodes <= EXACT_NODES_MAX) {
+        return concorde_list(n_nodes, n_edges, edges, edges_costs, monitor, out_tour, out_cost, out_status,
+                             in_tour, verbose, time_limit, target);
+    }
+
+    /* Concorde indexes the endpoints of the edges (and of the missing edges of a tour) with int */
+    if (n_edges < 0 || n_edges > EDGES_MAX - n_nodes) {
+        return concorde_error(DISCORDE_RETURN_TOO_LARGE, out_status);
+    }
+    if (discorde_cutpool_create(&pool) != DISCORDE_RETURN_OK) {
+        return concorde_error(DISCORDE_RETURN_NO_MEMORY, out_status);
+    }
+
+    /* The branch-and-bound driven by Discorde reports the Lin-Kernighan tour and every better tour found while
+     * branching, and stops between two nodes once the monitor is cancelled */
+    options.monitor = monitor;
+    options.checkpoint = NULL;
+    options.resume = NULL;
+    options.stop = NULL;
+    return_value = concorde_pool_call(n_nodes, n_edges, edges, edges_costs, pool, &options, in_tour, out_tour,
+                                      out_cost, verbose, time_limit, &success, &optimal, &hit_timelimit);
+    discorde_cutpool_free(pool);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return concorde_error(return_value, out_status);
+    }
+
+    /* Set solver status and return value */
+    return concorde_result(success, optimal, hit_timelimit, out_cost, out_status, target, monitor);
+}
+
+int concorde_full_monitored(int n_nodes, int** cost_matrix, discorde_monitor* monitor,
+                            int* out_tour, double* out_cost, int* out_status,
+                            int* in_tour, bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value, found;
+    int n_edges;            /* Number of candidate edges of the heuristic */
+    int* edges;
+    int* lk_tour;           /* Tour of the heuristic, the initial upper bound of Concorde */
+    double lk_cost;
+    double start;
+    double time_bound;      /* Time left to Concorde */
+    matrix_view matrix;
+
+    /* Output flags of Concorde solver */
+    int success;        /* Set to 1 if a feasible tour is found */
+    int optimal;        /* Set to 1 if tour found is optimal */
+    int hit_timelimit;  /* Set to 1 if the time limit is reached */
+
+    /* Cost matrix of the instance, used by Concorde as the oracle of edge lengths */
+    CCdatagroup data;
+
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+
+    /* Small instances are solved at once by the dynamic program, which reports its optimal tour */
+    if (monitor == NULL || n_nodes <= EXACT_NODES_MAX) {
+        return concorde_matrix(&matrix, monitor, out_tour, out_cost, out_status,
+                               in_tour, verbose, time_limit, target);
+    }
+
+    lk_tour = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    if (lk_tour == NULL) {
+        return concorde_error(DISCORDE_RETURN_NO_MEMORY, out_status);
+    }
+    start = discorde_wall_time();
+    return_value = matrix_candidates(&matrix, MONITOR_K_NEAREST, &data, &n_edges, &edges);
+    if (return_value != DISCORDE_RETURN_OK) {
+        free(lk_tour);
+        return concorde_error(return_value, out_status);
+    }
+
+    /* Concorde works on the matrix as a whole and gives no intermediate tours, so the Lin-Kernighan tour that gives it
+     * its initial upper bound is reported before it starts */
+    found = (linkernighan_dat(n_nodes, &data, n_edges, edges, NULL, lk_tour, &lk_cost, in_tour, verbose, time_limit,
+                              NULL) == DISCORDE_RETURN_OK);
+    if (found) {
+        discorde_monitor_report(monitor, n_nodes, lk_tour, lk_cost, false, 0, start);
+    }
+    free(edges);
+
+    /* Concorde gets the time left by the heuristic */
+    if (time_limit != NULL) {
+        time_bound = *time_limit - (discorde_wall_time() - start);
+        time_bound = (time_bound > 0) ? time_bound : 0;
+        time_limit = &time_bound;
+    }
+
+    /* Concorde only sees a cancellation after its root LP, so a cancellation during the heuristic does not start it */
+    if (found && discorde_monitor_cancelled(monitor)) {
+        memcpy(out_tour, lk_tour, sizeof(int) * (size_t) n_nodes);
+        *out_cost = lk_cost;
+        success = 1;
+        optimal = 0;
+        hit_timelimit = 1;
+    } else {
+        concorde_call(n_nodes, &data, 0, NULL, NULL, NULL, found ? lk_tour : in_tour, found ? &lk_cost : NULL,
+                      out_tour, out_cost, verbose, time_limit, monitor, &success, &optimal, &hit_timelimit);
+    }
+
+    /* Free resources */
+    CCutil_freedatagroup(&data);
+    free(lk_tour);
+
+    /* Set solver status and return value */
+    return concorde_result(success, optimal, hit_timelimit, out_cost, out_status, target, monitor);
+}
+
+/*
+ * Live instance for incremental re-optimization: a list of edges whose costs are updated in batches, the cut pool of
+ * its previous solves and its last tour. The last tour is kept in positions as well, to tell whether an updated edge
+ * joins consecutive nodes of it.
+ */
+struct discorde_reopt {
+    int n_nodes;
+    int n_edges;
+    int* edges;                 /* Copy of the 2 * n_edges endpoints of the list */
+    int* edges_costs;           /* Current costs of the edges */
+    discorde_cutpool* pool;     /* Cuts of the previous solves */
+    int* tour;                  /* Last tour found */
+    int* position;              /* Position of each node in the last tour */
+    bool has_tour;              /* Whether a tour has been found */
+    double cost;                /* Cost of the last tour under the current costs, if it is known to be optimal */
+    bool optimal;               /* Whether the last tour is still known to be optimal under the current costs */
+};
+
+int discorde_reopt_create(int n_nodes, int n_edges, const int* edges, const int* edges_costs,
+                          discorde_reopt** out_reopt)
+{
+    discorde_reopt* reopt;
+
+    *out_reopt = NULL;
+    if (n_edges < 0 || n_edges > EDGES_MAX - n_nodes) {
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
+
+    reopt = (discorde_reopt*) malloc(sizeof(discorde_reopt));
+    if (reopt == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    reopt->edges = (int*) alloc_array(2 * (size_t) n_edges, sizeof(int));
+    reopt->edges_costs = (int*) alloc_array((size_t) n_edges, sizeof(int));
+    reopt->tour = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    reopt->position = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    reopt->pool = NULL;
+    if (reopt->edges == NULL || reopt->edges_costs == NULL || reopt->tour == NULL || reopt->position == NULL
+        || discorde_cutpool_create(&reopt->pool) != DISCORDE_RETURN_OK) {
+        discorde_reopt_free(reopt);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    memcpy(reopt->edges, edges, 2 * sizeof(int) * (size_t) n_edges);
+    memcpy(reopt->edges_costs, edges_costs, sizeof(int) * (size_t) n_edges);
+    reopt->n_nodes = n_nodes;
+    reopt->n_edges = n_edges;
+    reopt->has_tour = false;
+    reopt->cost = 0;
+    reopt->optimal = false;
+    *out_reopt = reopt;
+
+    return DISCORDE_RETURN_OK;
+}
+
+void discorde_reopt_free(discorde_reopt* reopt)
+{
+    if (reopt == NULL) {
+        return;
+    }
+
+    discorde_cutpool_free(reopt->pool);
+    free(reopt->edges);
+    free(reopt->edges_costs);
+    free(reopt->tour);
+    free(reopt->position);
+    free(reopt);
+}
+
+/*
+ * Return whether the endpoints of an edge are consecutive nodes of the last tour.
+ */
+static bool reopt_tour_edge(const discorde_reopt* reopt, int edge)
+{
+    int distance;
+
+    distance = abs(reopt->position[reopt->edges[2 * edge]] - reopt->position[reopt->edges[2 * edge + 1]]);
+
+    return distance == 1 || distance == reopt->n_nodes - 1;
+}
+
+int discorde_reopt_update(discorde_reopt* reopt, int n_updates, const int* edge_ids, const int* new_costs)
+{
+    int i;
+
+    for (i = 0; i < n_updates; ++i) {
+        if (edge_ids[i] < 0 || edge_ids[i] >= reopt->n_edges) {
+            return DISCORDE_RETURN_FAILURE;
+        }
+    }
+
+    /*
+     * An optimal tour stays optimal when the only costs that change are raised on edges it does not use. Edges joining
+     * consecutive nodes of the tour are treated as used (a parallel edge may be the one the tour goes through).
+     */
+    for (i = 0; i < n_updates; ++i) {
+        if (reopt->optimal && (new_costs[i] < reopt->edges_costs[edge_ids[i]] || reopt_tour_edge(reopt, edge_ids[i]))) {
+            reopt->optimal = false;
+        }
+        reopt->edges_costs[edge_ids[i]] = new_costs[i];
+    }
+
+    return DISCORDE_RETURN_OK;
+}
+
+int discorde_reopt_solve(discorde_reopt* reopt, int* out_tour, double* out_cost, int* out_status,
+                         bool verbose, double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int i;
+    int return_value;
+
+    /* Output flags of Concorde solver */
+    int success;        /* Set to 1 if a feasible tour is found */
+    int optimal;        /* Set to 1 if tour found is optimal */
+    int hit_timelimit;  /* Set to 1 if the time limit is reached */
+
+    /* Nothing to do if the last tour is still optimal */
+    if (reopt->optimal) {
+        memcpy(out_tour, reopt->tour, sizeof(int) * (size_t) reopt->n_nodes);
+        *out_cost = reopt->cost;
+        if (out_status != NULL) {
+            *out_status = DISCORDE_STATUS_OPTIMAL;
+        }
+        return DISCORDE_RETURN_OK;
+    }
+
+    /* The last tour is the upper bound, and the cuts of the previous solves seed the root LP */
+    return_value = concorde_pool_call(reopt->n_nodes, reopt->n_edges, reopt->edges, reopt->edges_costs, reopt->pool,
+                                      NULL, reopt->has_tour ? reopt->tour : NULL, out_tour, out_cost, verbose,
+                                      time_limit, &success, &optimal, &hit_timelimit);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return concorde_error(return_value, out_status);
+    }
+
+    if (success == 1) {
+        memcpy(reopt->tour, out_tour, sizeof(int) * (size_t) reopt->n_nodes);
+        for (i = 0; i < reopt->n_nodes; ++i) {
+            reopt->position[out_tour[i]] = i;
+        }
+        reopt->has_tour = true;
+        reopt->cost = *out_cost;
+        reopt->optimal = optimal != 0;
+    }
+
+    /* Set solver status and return value */
+    return concorde_result(success, optimal, hit_timelimit, out_cost, out_status, target, NULL);
+}
+
+/*
+ * Number of nearest neighbors of each node in the core of edges of the lower bounds of a cost matrix. The remaining
+ * pairs of nodes are priced against the matrix.
+ */
+#define BOUND_K_NEAREST 10
+
+/*
+ * Fractional 2-matching bound of an instance (see {@code discorde_lower_bound}). The support of the matching (its
+ * edges with a nonzero value) is returned in arrays allocated for the caller.
+ */
+static int lower_bound_matching(int n_nodes, CCdatagroup* data, int n_edges, int* edges, int* edges_costs,
+                                bool complete, bool verbose, CCrandstate* rstate, double* out_bound,
+                                int* out_n_support, int** out_support, double** out_values)
+{
+
+    /* Auxiliary variables */
+    int k;
+    int* matching;      /* Matching given by Concorde as triples (end1, end2, 2x), terminated by -1 */
+    int* support;
+    double* values;
+
+    /* Values are half-integral and add up to n_nodes, so the support holds at most 2 * n_nodes edges */
+    matching = (int*) alloc_array(6 * (size_t) n_nodes + 1, sizeof(int));
+    support = (int*) alloc_array(4 * (size_t) n_nodes, sizeof(int));
+    values = (double*) alloc_array(2 * (size_t) n_nodes, sizeof(double));
+    if (matching == NULL || support == NULL || values == NULL) {
+        free(matching);
+        free(support);
+        free(values);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    /* Over a list of edges only those edges are matched; over a matrix the other pairs are priced against it */
+    if (CCfmatch_fractional_2match(n_nodes, n_edges, edges, edges_costs, complete ? NULL : data, out_bound, matching,
+                                   NULL, NULL, 0, verbose ? 0 : 1, rstate) != 0) {
+        free(matching);
+        free(support);
+        free(values);
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    for (k = 0; matching[3 * k] != -1; ++k) {
+        support[2 * k] = matching[3 * k];
+        support[2 * k + 1] = matching[3 * k + 1];
+        values[k] = matching[3 * k + 2] / 2.0;
+    }
+
+    free(matching);
+
+    *out_n_support = k;
+    *out_support = support;
+    *out_values = values;
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Root LP bound of an instance (see {@code discorde_lower_bound}): the cutting loop of Concorde over the root LP, which
+ * is never branched on. The upper bound of the LP is a Lin-Kernighan tour, whose edges are added to the core if they
+ * are not in it, so that the LP holds a Hamiltonian cycle. The edges of the LP and their values are returned in arrays
+ * allocated by Concorde for the caller.
+ */
+static int lower_bound_root_lp(int n_nodes, CCdatagroup* data, int n_edges, int* edges, int* edges_costs,
+                               bool complete, bool verbose, CCrandstate* rstate, unsigned long call_id,
+                               double* out_bound, int* out_n_support, int** out_support, double** out_values)
+{
+
+    /* Auxiliary variables */
+    int i, u, v;
+    int return_value;
+    int n_lp_edges;         /* Number of edges of the core plus the missing edges of the tour */
+    int* lp_edges;
+    int* lp_costs;
+    int* perm;              /* Labelling of the nodes given to Concorde (the identity) */
+    int* tour;              /* Tour found by Lin-Kernighan heuristic */
+    double upper_bound;     /* Cost of tour */
+
+    /* Variables and structures used by Concorde solver */
+    discorde_scratch scratch;   /* Scratch directory of the run, removed with its files afterwards */
+    int silent;             /* Verbosity level */
+    CCtsp_lpgraph graph;    /* Core of edges, to look the edges of the tour up */
+    CCtsp_lpcuts* pool;     /* Cuts found by the cutting loop */
+    CCtsp_lp* lp;           /* Root LP */
+    CCtsp_cutselect sel;    /* Cut selection of the cutting loop */
+
+    silent = verbose ? 0 : 1;
+    lp_edges = (int*) alloc_array(2 * ((size_t) n_edges + (size_t) n_nodes), sizeof(int));
+    lp_costs = (int*) alloc_array((size_t) n_edges + (size_t) n_nodes, sizeof(int));
+    perm = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    tour = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    if (lp_edges == NULL || lp_costs == NULL || perm == NULL || tour == NULL) {
+        free(lp_edges);
+        free(lp_costs);
+        free(perm);
+        free(tour);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    /* Upper bound of the LP */
+    linkernighan_dat(n_nodes, data, n_edges, edges, rstate, tour, &upper_bound, NULL, verbose, NULL, NULL);
+
+    /* The core, followed by the edges of the tour that are not in it */
+    memcpy(lp_edges, edges, 2 * sizeof(int) * (size_t) n_edges);
+    memcpy(lp_costs, edges_costs, sizeof(int) * (size_t) n_edges);
+    n_lp_edges = n_edges;
+    CCtsp_init_lpgraph_struct(&graph);
+    if (CCtsp_build_lpgraph(&graph, n_nodes, n_edges, edges, edges_costs) != 0
+        || CCtsp_build_lpadj(&graph, 0, n_edges) != 0) {
+        CCtsp_free_lpgraph(&graph);
+        free(lp_edges);
+        free(lp_costs);
+        free(perm);
+        free(tour);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    for (i = 0; i < n_nodes; ++i) {
+        u = tour[i];
+        v = tour[(i + 1) % n_nodes];
+        if (CCtsp_find_edge(&graph, u, v) < 0) {
+            lp_edges[2 * n_lp_edges] = u;
+            lp_edges[2 * n_lp_edges + 1] = v;
+            lp_costs[n_lp_edges] = CCutil_dat_edgelen(u, v, data);
+            ++n_lp_edges;
+        }
+        perm[i] = i;
+    }
+    CCtsp_free_lpgraph(&graph);
+    free(tour);
+
+    /* Concorde writes its problem files in a scratch directory of its own */
+    return_value = discorde_scratch_open(call_id, &scratch);
+    if (return_value != DISCORDE_RETURN_OK) {
+        free(lp_edges);
+        free(lp_costs);
+        free(perm);
+        return return_value;
+    }
+
+    CONCORDE_LOCK();
+    return_value = DISCORDE_RETURN_FAILURE;
+    pool = NULL;
+    lp = NULL;
+    if (CCtsp_init_cutpool(&n_nodes, NULL, &pool) == 0) {
+        CCtsp_init_cutselect(&sel);
+        sel.cutpool = 1;
+
+        /* Over a list of edges the core is the full edge set; over a matrix the other pairs are priced against it */
+        if (CCtsp_init_lp(&lp, scratch.filename, -1, NULL, n_nodes, data, n_lp_edges, lp_edges, lp_costs,
+                          complete ? n_lp_edges : 0, complete ? lp_edges : NULL, complete ? lp_costs : NULL,
+                          complete ? 1 : 0, perm, upper_bound, pool, NULL, silent, rstate) == 0
+            && CCtsp_cutting_loop(lp, &sel, 0, silent, rstate) == 0
+            && CCtsp_get_lp_result(lp, out_bound, NULL, out_n_support, out_support, out_values, NULL, NULL,
+                                   NULL) == 0) {
+            return_value = DISCORDE_RETURN_OK;
+        }
+        if (lp != NULL) {
+            CCtsp_free_tsp_lp_struct(&lp);
+        }
+        CCtsp_free_cutpool(&pool);
+    }
+    CONCORDE_UNLOCK();
+    discorde_scratch_close(&scratch);
+
+    /* Free resources */
+    free(lp_edges);
+    free(lp_costs);
+    free(perm);
+
+    return return_value;
+}
+
+/*
+ * Compute a lower bound of an instance given by a datagroup and a core of edges. If {@code complete} is set the core
+ * holds every edge of the instance; otherwise the remaining pairs of nodes are priced against the datagroup. The
+ * support of the optimal solution is returned in arrays allocated for the caller.
+ */
+static int lower_bound_dat(int n_nodes, CCdatagroup* data, int n_edges, int* edges, int* edges_costs, bool complete,
+                           int mode, bool verbose, double* out_bound, int* out_n_support, int** out_support,
+                           double** out_values)
+{
+    unsigned long call_id;
+    CCrandstate rstate;
+
+    call_id = next_call_id();
+    CCutil_sprand(call_seed(call_id), &rstate);
+
+    if (mode == DISCORDE_BOUND_2MATCHING) {
+        return lower_bound_matching(n_nodes, data, n_edges, edges, edges_costs, complete, verbose, &rstate,
+                                    out_bound, out_n_support, out_support, out_values);
+    }
+
+    return lower_bound_root_lp(n_nodes, data, n_edges, edges, edges_costs, complete, verbose, &rstate, call_id,
+                               out_bound, out_n_support, out_support, out_values);
+}
+
+int discorde_lower_bound(int n_nodes, int n_edges, int* edges, int* edges_costs, int mode,
+                         double* out_bound, double* out_x, double* out_time, bool verbose)
+{
+
+    /* Auxiliary variables */
+    int k, e;
+    int return_value;
+    double start;
+
+    /* Support of the optimal solution of the bound */
+    int n_support;
+    int* support;
+    double* values;
+
+    /* Variables and structures used by Concorde */
+    CCdatagroup data;       /* Sparse datagroup of the instance */
+    CCtsp_lpgraph graph;    /* Edges of the list, to look the support up */
+
+    if (n_nodes < 3 || (mode != DISCORDE_BOUND_2MATCHING && mode != DISCORDE_BOUND_ROOT_LP)) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+    if (n_edges < 0 || n_edges > EDGES_MAX - n_nodes) {
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
+    start = discorde_wall_time();
+
+    /* A missing edge costs more than any tour over the edges of the list */
+    CCutil_init_datagroup(&data);
+    if (CCutil_graph2dat_sparse(n_nodes, n_edges, edges, edges_costs,
+                                cutpool_missing_len(n_nodes, n_edges, edges_costs), &data) != 0) {
+        CCutil_freedatagroup(&data);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    support = NULL;
+    values = NULL;
+    return_value = lower_bound_dat(n_nodes, &data, n_edges, edges, edges_costs, true, mode, verbose, out_bound,
+                                   &n_support, &support, &values);
+    CCutil_freedatagroup(&data);
+
+    /* The value of each edge of the list; the missing edges of the tour added to the LP have none */
+    if (return_value == DISCORDE_RETURN_OK && out_x != NULL) {
+        for (e = 0; e < n_edges; ++e) {
+            out_x[e] = 0;
+        }
+        CCtsp_init_lpgraph_struct(&graph);
+        if (CCtsp_build_lpgraph(&graph, n_nodes, n_edges, edges, edges_costs) == 0
+            && CCtsp_build_lpadj(&graph, 0, n_edges) == 0) {
+            for (k = 0; k < n_support; ++k) {
+                e = CCtsp_find_edge(&graph, support[2 * k], support[2 * k + 1]);
+                if (e >= 0) {
+                    out_x[e] = values[k];
+                }
+            }
+        } else {
+            return_value = DISCORDE_RETURN_NO_MEMORY;
+        }
+        CCtsp_free_lpgraph(&graph);
+    }
+    CC_IFFREE(support, int);
+    CC_IFFREE(values, double);
+
+    if (out_time != NULL) {
+        *out_time = discorde_wall_time() - start;
+    }
+
+    return return_value;
+}
+
+int discorde_lower_bound_full(int n_nodes, int** cost_matrix, int mode,
+                              double* out_bound, double* out_x, double* out_time, bool verbose)
+{
+
+    /* Auxiliary variables */
+    int k, u, v;
+    int return_value;
+    double start;
+    size_t n_pairs;
+    matrix_view matrix;
+
+    /* Core of edges: the k nearest neighbors of each node */
+    CCdatagroup data;
+    int n_edges;
+    int* edges;
+    int* edges_costs;
+
+    /* Support of the optimal solution of the bound */
+    int n_support;
+    int* support;
+    double* values;
+
+    if (n_nodes < 3 || (mode != DISCORDE_BOUND_2MATCHING && mode != DISCORDE_BOUND_ROOT_LP)) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+    start = discorde_wall_time();
+
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+    return_value = matrix_candidates(&matrix, BOUND_K_NEAREST, &data, &n_edges, &edges);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return return_value;
+    }
+    if (n_edges > EDGES_MAX - n_nodes) {
+        CCutil_freedatagroup(&data);
+        free(edges);
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
+    edges_costs = (int*) alloc_array((size_t) n_edges, sizeof(int));
+    if (edges_costs == NULL) {
+        CCutil_freedatagroup(&data);
+        free(edges);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    for (k = 0; k < n_edges; ++k) {
+        edges_costs[k] = CCutil_dat_edgelen(edges[2 * k], edges[2 * k + 1], &data);
+    }
+
+    support = NULL;
+    values = NULL;
+    return_value = lower_bound_dat(n_nodes, &data, n_edges, edges, edges_costs, false, mode, verbose, out_bound,
+                                   &n_support, &support, &values);
+
+    /* The value of each pair of nodes, in the packed upper triangle layout */
+    if (return_value == DISCORDE_RETURN_OK && out_x != NULL) {
+        n_pairs = ((size_t) n_nodes * ((size_t) n_nodes - 1)) / 2;
+        memset(out_x, 0, sizeof(double) * n_pairs);
+        for (k = 0; k < n_support; ++k) {
+            u = (support[2 * k] < support[2 * k + 1]) ? support[2 * k] : support[2 * k + 1];
+            v = (support[2 * k] < support[2 * k + 1]) ? support[2 * k + 1] : support[2 * k];
+            out_x[((size_t) u * (2 * (size_t) n_nodes - (size_t) u - 1)) / 2 + (size_t) (v - u - 1)] = values[k];
+        }
+    }
+
+    /* Free resources */
+    CC_IFFREE(support, int);
+    CC_IFFREE(values, double);
+    CCutil_freedatagroup(&data);
+    free(edges);
+    free(edges_costs);
+
+    if (out_time != NULL) {
+        *out_time = discorde_wall_time() - start;
+    }
+
+    return return_value;
+}
+
+/*
+ * Costs of a cost matrix given row by row to the Held-Karp ascent. The part of row u below the diagonal is read from
+ * the lower triangle copied into a matrix norm datagroup, and the part above it from the matrix of the caller, so both
+ * parts are copied contiguously.
+ */
+typedef struct matrix_rows {
+    const matrix_view* matrix;
+    CCdatagroup* data;
+} matrix_rows;
+
+static const int* matrix_rows_get(void* arg, int u, int* buffer)
+{
+    matrix_rows* rows;
+    const int* upper;
+    size_t shift;
+
+    rows = (matrix_rows*) arg;
+    memcpy(buffer, rows->data->adj[u], sizeof(int) * ((size_t) u + 1));
+    if (u + 1 < rows->matrix->n_nodes) {
+        upper = matrix_row(rows->matrix, u, &shift);
+        memcpy(buffer + u + 1, upper + ((size_t) u + 1 - shift),
+               sizeof(int) * (size_t) (rows->matrix->n_nodes - u - 1));
+    }
+
+    return buffer;
+}
+
+static int matrix_rows_cost(void* arg, int u, int v)
+{
+    return CCutil_dat_edgelen(u, v, ((matrix_rows*) arg)->data);
+}
+
+/*
+ * Costs of an instance given by coordinates, computed row by row for the Held-Karp ascent. The norms of Concorde that
+ * only take arithmetic and a square root have a kernel of their own, which is vectorized over the row; the other ones
+ * are queried from the datagroup of the coordinates.
+ */
+typedef struct points_rows {
+    int n_nodes;
+    const double* x;
+    const double* y;
+    const double* z;
+    int norm;               /* Norm of the coordinates (DISCORDE_NORM_*) */
+    CCdatagroup* data;
+} points_rows;
+
+static const int* points_rows_get(void* arg, int u, int* buffer)
+{
+    points_rows* points;
+    int v, n;
+    double dx, dy, dz, xu, yu, zu;
+
+    points = (points_rows*) arg;
+    n = points->n_nodes;
+    xu = points->x[u];
+    yu = points->y[u];
+    switch (points->norm) {
+        case DISCORDE_NORM_EUCLIDEAN:
+            for (v = 0; v < n; ++v) {
+                dx = points->x[v] - xu;
+                dy = points->y[v] - yu;
+                buffer[v] = (int) (sqrt(dx * dx + dy * dy) + 0.5);
+            }
+            break;
+        case DISCORDE_NORM_EUCLIDEAN_CEIL:
+            for (v = 0; v < n; ++v) {
+                dx = points->x[v] - xu;
+                dy = points->y[v] - yu;
+                buffer[v] = (int) ceil(sqrt(dx * dx + dy * dy));
+            }
+            break;
+        case DISCORDE_NORM_EUCLIDEAN_3D:
+            zu = points->z[u];
+            for (v = 0; v < n; ++v) {
+                dx = points->x[v] - xu;
+                dy = points->y[v] - yu;
+                dz = points->z[v] - zu;
+                buffer[v] = (int) (sqrt(dx * dx + dy * dy + dz * dz) + 0.5);
+            }
+            break;
+        case DISCORDE_NORM_MAX:
+            for (v = 0; v < n; ++v) {
+                dx = fabs(points->x[v] - xu);
+                dy = fabs(points->y[v] - yu);
+                buffer[v] = (int) (((dx > dy) ? dx : dy) + 0.5);
+            }
+            break;
+        case DISCORDE_NORM_MANHATTAN:
+            for (v = 0; v < n; ++v) {
+                buffer[v] = (int) (fabs(points->x[v] - xu) + fabs(points->y[v] - yu) + 0.5);
+            }
+            break;
+        default:
+            for (v = 0; v < n; ++v) {
+                buffer[v] = (v != u) ? CCutil_dat_edgelen(u, v, points->data) : 0;
+            }
+            break;
+    }
+
+    return buffer;
+}
+
+static int points_rows_cost(void* arg, int u, int v)
+{
+    return CCutil_dat_edgelen(u, v, ((points_rows*) arg)->data);
+}
+
+/*
+ * Run the Held-Karp ascent from zero penalties over {@code costs}, for what is left of the time limit of a call
+ * started at {@code start}, and store its results.
+ */
+static int held_karp_run(const discorde_costs* costs, int max_iterations, double* time_limit, double start,
+                         double* out_bound, double* out_pi, double* out_time)
+{
+    int v;
+    int return_value;
+    double time_left;
+    double* pi;
+
+    pi = (out_pi != NULL) ? out_pi : (double*) alloc_array((size_t) costs->n_nodes, sizeof(double));
+    if (pi == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    for (v = 0; v < costs->n_nodes; ++v) {
+        pi[v] = 0;
+    }
+
+    time_left = -1;
+    if (time_limit != NULL) {
+        time_left = *time_limit - (discorde_wall_time() - start);
+        time_left = (time_left > 0) ? time_left : 0;
+    }
+    return_value = discorde_held_karp_ascent(costs, max_iterations, time_left, pi, out_bound);
+
+    if (pi != out_pi) {
+        free(pi);
+    }
+    if (out_time != NULL) {
+        *out_time = discorde_wall_time() - start;
+    }
+
+    return return_value;
+}
+
+/*
+ * Held-Karp bound of an instance given by a cost matrix. The ascent runs over the k nearest neighbors of each node.
+ */
+static int held_karp_matrix(const matrix_view* matrix, int max_iterations, double* time_limit,
+                            double* out_bound, double* out_pi, double* out_time)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+    int n_edges;
+    int* edges;
+    double start;
+
+    /* Costs of the matrix */
+    CCdatagroup data;
+    matrix_rows rows;
+    discorde_costs costs;
+
+    start = discorde_wall_time();
+    return_value = matrix_candidates(matrix, BOUND_K_NEAREST, &data, &n_edges, &edges);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return return_value;
+    }
+
+    rows.matrix = matrix;
+    rows.data = &data;
+    costs.n_nodes = matrix->n_nodes;
+    costs.row = matrix_rows_get;
+    costs.cost = matrix_rows_cost;
+    costs.arg = &rows;
+    costs.n_edges = n_edges;
+    costs.edges = edges;
+    return_value = held_karp_run(&costs, max_iterations, time_limit, start, out_bound, out_pi, out_time);
+
+    free(edges);
+    CCutil_freedatagroup(&data);
+
+    return return_value;
+}
+
+int discorde_held_karp_full(int n_nodes, int** cost_matrix, int max_iterations, double* time_limit,
+                            double* out_bound, double* out_pi, double* out_time)
+{
+    matrix_view matrix;
+
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+
+    return held_karp_matrix(&matrix, max_iterations, time_limit, out_bound, out_pi, out_time);
+}
+
+int discorde_held_karp_full_flat(int n_nodes, const int* cost_matrix, int max_iterations, double* time_limit,
+                                 double* out_bound, double* out_pi, double* out_time)
+{
+    matrix_view matrix;
+
+    matrix = matrix_view_of(MATRIX_FLAT, n_nodes, NULL, cost_matrix);
+
+    return held_karp_matrix(&matrix, max_iterations, time_limit, out_bound, out_pi, out_time);
+}
+
+int discorde_held_karp_coords(int n_nodes, double* x, double* y, double* z, int norm, int max_iterations,
+                              double* time_limit, double* out_bound, double* out_pi, double* out_time)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+    int n_edges;
+    int* edges;
+    double start;
+
+    /* Costs of the instance */
+    CCdatagroup data;
+    points_rows points;
+    discorde_costs costs;
+
+    start = discorde_wall_time();
+    return_value = points_candidates(n_nodes, x, y, z, norm, &data, &n_edges, &edges);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return return_value;
+    }
+
+    points.n_nodes = n_nodes;
+    points.x = x;
+    points.y = y;
+    points.z = z;
+    points.norm = norm;
+    points.data = &data;
+    costs.n_nodes = n_nodes;
+    costs.row = points_rows_get;
+    costs.cost = points_rows_cost;
+    costs.arg = &points;
+    costs.n_edges = n_edges;
+    costs.edges = edges;
+    return_value = held_karp_run(&costs, max_iterations, time_limit, start, out_bound, out_pi, out_time);
+
+    CC_IFFREE(edges, int);
+    coords_dat_free(&data);
+
+    return return_value;
+}
+
+/*
+ * Default number of alpha-nearest neighbors of each node in the candidate set of the Lin-Kernighan heuristic, as in
+ * LKH.
+ */
+#define ALPHA_K_NEAREST 5
+
+/*
+ * Solve an instance using the Lin-Kernighan heuristic over the alpha-nearest neighbors of each node. The penalties of
+ * the 1-trees are optimized by the Held-Karp ascent first, over the candidate edges of {@code costs}, for at most half
+ * of the time limit; the heuristic gets the rest of it.
+ */
+static int linkernighan_alpha(const discorde_costs* costs, CCdatagroup* data, int k_alpha,
+                              int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                              double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+    double start;
+    double bound;           /* Held-Karp bound of the penalties */
+    double time_left;
+    double* pi;             /* Node penalties */
+    int* neighbors;         /* Alpha-nearest neighbors of each node */
+
+    /* Variables to format data as required by Lin-Kernighan heuristic */
+    int n_edges;            /* Number of candidate edges */
+    int* edges_list;        /* List of candidate edges (unidimensional) */
+
+    if (k_alpha <= 0) {
+        k_alpha = ALPHA_K_NEAREST;
+    }
+    if (k_alpha > costs->n_nodes - 1) {
+        k_alpha = costs->n_nodes - 1;
+    }
+    if ((size_t) costs->n_nodes * (size_t) k_alpha > EDGES_MAX) {
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
+    start = discorde_wall_time();
+
+    pi = (double*) calloc((size_t) costs->n_nodes, sizeof(double));
+    neighbors = (int*) alloc_array((size_t) costs->n_nodes * k_alpha, sizeof(int));
+    if (pi == NULL || neighbors == NULL) {
+        free(pi);
+        free(neighbors);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    /* Node penalties, then the alpha-nearest neighbors under them */
+    return_value = discorde_held_karp_ascent(costs, 0, (time_limit != NULL) ? *time_limit / 2 : -1, pi, &bound);
+    if (return_value == DISCORDE_RETURN_OK) {
+        return_value = discorde_alpha_nearest(costs, pi, k_alpha, neighbors);
+    }
+    if (return_value == DISCORDE_RETURN_OK) {
+        return_value = neighbors_edges(costs->n_nodes, k_alpha, neighbors, &n_edges, &edges_list);
+    }
+    free(pi);
+    free(neighbors);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return return_value;
+    }
+
+    /* Call Lin-Kernighan heuristic */
+    time_left = 0;
+    if (time_limit != NULL) {
+        time_left = *time_limit - (discorde_wall_time() - start);
+        time_left = (time_left > 0) ? time_left : 0;
+    }
+    return_value = linkernighan_dat(costs->n_nodes, data, n_edges, edges_list, NULL, out_tour, out_cost, in_tour,
+                                    verbose, (time_limit != NULL) ? &time_left : NULL, target);
+
+    /* Free resources */
+    free(edges_list);
+
+    return return_value;
+}
+
+int linkernighan_full_alpha(int n_nodes, int** cost_matrix, int k_alpha,
+                            int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                            double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+    int n_edges;
+    int* edges;
+
+    /* Costs of the matrix */
+    CCdatagroup data;
+    matrix_view matrix;
+    matrix_rows rows;
+    discorde_costs costs;
+
+    /* The ascent runs over the k nearest neighbors of each node */
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+    return_value = matrix_candidates(&matrix, BOUND_K_NEAREST, &data, &n_edges, &edges);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return return_value;
+    }
+
+    rows.matrix = &matrix;
+    rows.data = &data;
+    costs.n_nodes = n_nodes;
+    costs.row = matrix_rows_get;
+    costs.cost = matrix_rows_cost;
+    costs.arg = &rows;
+    costs.n_edges = n_edges;
+    costs.edges = edges;
+    return_value = linkernighan_alpha(&costs, &data, k_alpha, out_tour, out_cost, in_tour, verbose,
+                                      time_limit, target);
+
+    free(edges);
+    CCutil_freedatagroup(&data);
+
+    return return_value;
+}
+
+int linkernighan_coords_alpha(int n_nodes, double* x, double* y, double* z, int norm, int k_alpha,
+                              int* out_tour, double* out_cost, int* in_tour, bool verbose,
+                              double* time_limit, double* target)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+    int n_edges;
+    int* edges;
+
+    /* Costs of the instance */
+    CCdatagroup data;
+    points_rows points;
+    discorde_costs costs;
+
+    /* The ascent runs over the candidate edges of linkernighan_coords */
+    return_value = points_candidates(n_nodes, x, y, z, norm, &data, &n_edges, &edges);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return return_value;
+    }
+
+    points.n_nodes = n_nodes;
+    points.x = x;
+    points.y = y;
+    points.z = z;
+    points.norm = norm;
+    points.data = &data;
+    costs.n_nodes = n_nodes;
+    costs.row = points_rows_get;
+    costs.cost = points_rows_cost;
+    costs.arg = &points;
+    costs.n_edges = n_edges;
+    costs.edges = edges;
+    return_value = linkernighan_alpha(&costs, &data, k_alpha, out_tour, out_cost, in_tour, verbose,
+                                      time_limit, target);
+
+    CC_IFFREE(edges, int);
+    coords_dat_free(&data);
+
+    return return_value;
+}
+
+/*
+ * Reusable solver context. The datagroups and edge lists built for an instance are kept after each call, so the next
+ * call over an instance of the same size (cost matrix) or with the same edges (list of edges) only refreshes the costs
+ * in place instead of allocating and building them again.
+ */
+struct discorde_context {
+
+    /* Options */
+    bool verbose;
+    bool has_time_limit;
+    double time_limit;
+    bool has_target;
+    double target;
+    CCrandstate rstate;         /* Random state carried from call to call */
+
+    /* Matrix norm datagroup of the last cost matrix, and the complete graph used as candidate set over it */
+    int matrix_nodes;           /* Number of nodes of matrix_data, or 0 if it is not built */
+    CCdatagroup matrix_data;
+    int complete_nodes;         /* Number of nodes of complete_list, or 0 if it is not built */
+    int complete_n_edges;
+    int* complete_list;
+
+    /* Sparse datagroup of the last list of edges */
+    int sparse_nodes;           /* Number of nodes of sparse_data, or 0 if it is not built */
+    int sparse_n_edges;
+    int sparse_capacity;        /* Number of edges allocated in sparse_edges and sparse_slots */
+    int* sparse_edges;          /* Copy of the 2 * sparse_n_edges endpoints of the list */
+    int* sparse_slots;          /* Index in sparse_data.lenspace of the length of each edge of the list */
+    bool sparse_in_place;       /* Whether sparse_slots is valid, so the lengths can be updated in place */
+    CCdatagroup sparse_data;
+};
+
+int discorde_context_create(discorde_context** out_context)
+{
+    discorde_context* context;
+
+    context = (discorde_context*) malloc(sizeof(discorde_context));
+    *out_context = context;
+    if (context == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    context->verbose = false;
+    context->has_time_limit = false;
+    context->time_limit = 0;
+    context->has_target = false;
+    context->target = 0;
+    CCutil_sprand(call_seed(next_call_id()), &context->rstate);
+
+    context->matrix_nodes = 0;
+    CCutil_init_datagroup(&context->matrix_data);
+    context->complete_nodes = 0;
+    context->complete_n_edges = 0;
+    context->complete_list = NULL;
+
+    context->sparse_nodes = 0;
+    context->sparse_n_edges = 0;
+    context->sparse_capacity = 0;
+    context->sparse_edges = NULL;
+    context->sparse_slots = NULL;
+    context->sparse_in_place = false;
+    CCutil_init_datagroup(&context->sparse_data);
+
+    return DISCORDE_RETURN_OK;
+}
+
+void discorde_context_free(discorde_context* context)
+{
+    if (context == NULL) {
+        return;
+    }
+
+    if (context->matrix_nodes > 0) {
+        CCutil_freedatagroup(&context->matrix_data);
+    }
+    if (context->sparse_nodes > 0) {
+        CCutil_freedatagroup(&context->sparse_data);
+    }
+    free(context->complete_list);
+    free(context->sparse_edges);
+    free(context->sparse_slots);
+    free(context);
+}
+
+void discorde_context_set_verbose(discorde_context* context, bool verbose)
+{
+    context->verbose = verbose;
+}
+
+void discorde_context_set_time_limit(discorde_context* context, const double* time_limit)
+{
+    context->has_time_limit = (time_limit != NULL);
+    context->time_limit = (time_limit != NULL) ? *time_limit : 0;
+}
+
+void discorde_context_set_target(discorde_context* context, const double* target)
+{
+    context->has_target = (target != NULL);
+    context->target = (target != NULL) ? *target : 0;
+}
+
+void discorde_context_set_seed(discorde_context* context, int seed)
+{
+    CCutil_sprand(seed, &context->rstate);
+}
+
+/*
+ * Find the slot of the length of each edge in the sparse datagroup built from the list by CCutil_graph2dat_sparse. It
+ * stores each edge in the adjacency of its smaller endpoint, in the order of the list, so the slots are found by
+ * replaying that order. Returns {@code false} if the datagroup does not match the replay, in which case the lengths
+ * cannot be updated in place.
+ */
+static bool context_sparse_slots(discorde_context* context)
+{
+
+    /* Auxiliary variables */
+    int i, u, v;
+    int n_nodes, n_edges;
+    int* next;              /* Next free slot in the adjacency of each node */
+    bool matched;
+    CCdatagroup* data;
+
+    data = &context->sparse_data;
+    n_nodes = context->sparse_nodes;
+    n_edges = context->sparse_n_edges;
+    if (data->adj == NULL || data->len == NULL || data->adjspace == NULL || data->lenspace == NULL) {
+        return false;
+    }
+
+    next = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    if (next == NULL) {
+        return false;
+    }
+    for (u = 0; u < n_nodes; ++u) {
+        next[u] = (int) (data->adj[u] - data->adjspace);
+    }
+
+    matched = true;
+    for (i = 0; i < n_edges && matched; ++i) {
+        u = context->sparse_edges[2 * i];
+        v = context->sparse_edges[2 * i + 1];
+        if (u > v) {
+            u = v;
+            v = context->sparse_edges[2 * i];
+        }
+        if (u < 0 || u >= n_nodes || data->len[u] - data->lenspace != data->adj[u] - data->adjspace
+            || next[u] >= n_edges || data->adjspace[next[u]] != v) {
+            matched = false;
+        } else {
+            context->sparse_slots[i] = next[u]++;
+        }
+    }
+
+    free(next);
+
+    return matched;
+}
+
+/*
+ * Load a list of edges into the sparse datagroup of the context. If the edges are the same as in the last call, only
+ * the lengths are copied in place; otherwise the datagroup is built again, reusing the arrays of the context when they
+ * are large enough.
+ */
+static int context_sparse(discorde_context* context, int n_nodes, int n_edges, int* edges, int* edges_costs)
+{
+
+    /* Auxiliary variables */
+    int i;
+    size_t n_endpoints;
+
+    n_endpoints = 2 * (size_t) n_edges;
+    if (context->sparse_in_place && context->sparse_nodes == n_nodes && context->sparse_n_edges == n_edges
+        && memcmp(context->sparse_edges, edges, n_endpoints * sizeof(int)) == 0) {
+        for (i = 0; i < n_edges; ++i) {
+            context->sparse_data.lenspace[context->sparse_slots[i]] = edges_costs[i];
+        }
+        return DISCORDE_RETURN_OK;
+    }
+
+    /* Build the datagroup again */
+    if (context->sparse_nodes > 0) {
+        CCutil_freedatagroup(&context->sparse_data);
+        context->sparse_nodes = 0;
+    }
+    context->sparse_in_place = false;
+    if (n_edges > context->sparse_capacity || context->sparse_edges == NULL) {
+        free(context->sparse_edges);
+        free(context->sparse_slots);
+        context->sparse_capacity = 0;
+        context->sparse_edges = (int*) alloc_array(n_endpoints, sizeof(int));
+        context->sparse_slots = (int*) alloc_array((size_t) n_edges, sizeof(int));
+        if (context->sparse_edges == NULL || context->sparse_slots == NULL) {
+            return DISCORDE_RETURN_NO_MEMORY;
+        }
+        context->sparse_capacity = n_edges;
+    }
+    memcpy(context->sparse_edges, edges, n_endpoints * sizeof(int));
+
+    CCutil_init_datagroup(&context->sparse_data);
+    if (CCutil_graph2dat_sparse(n_nodes, n_edges, edges, edges_costs, 0, &context->sparse_data) != 0) {
+        CCutil_freedatagroup(&context->sparse_data);
+        return DISCORDE_RETURN_FAILURE;
+    }
+    context->sparse_nodes = n_nodes;
+    context->sparse_n_edges = n_edges;
+    context->sparse_in_place = context_sparse_slots(context);
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Load a cost matrix into the matrix norm datagroup of the context, which is allocated again only if the number of
+ * nodes has changed since the last call.
+ */
+static int context_matrix(discorde_context* context, const matrix_view* matrix)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+
+    if (context->matrix_nodes != matrix->n_nodes || matrix->n_nodes == 0) {
+        if (context->matrix_nodes > 0) {
+            CCutil_freedatagroup(&context->matrix_data);
+            context->matrix_nodes = 0;
+        }
+        return_value = matrix_dat_alloc(matrix->n_nodes, &context->matrix_data);
+        if (return_value != DISCORDE_RETURN_OK) {
+            CCutil_freedatagroup(&context->matrix_data);
+            return return_value;
+        }
+        context->matrix_nodes = matrix->n_nodes;
+    }
+
+    matrix_dat_fill(matrix, &context->matrix_data);
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Set the time limit and target of a call from the options of the context.
+ */
+static void context_limits(discorde_context* context, double* time_limit, double** out_time_limit,
+                           double* target, double** out_target)
+{
+    *time_limit = context->time_limit;
+    *target = context->target;
+    *out_time_limit = context->has_time_limit ? time_limit : NULL;
+    *out_target = context->has_target ? target : NULL;
+}
+
+int discorde_context_concorde(discorde_context* context, int n_nodes, int n_edges, int* edges, int* edges_costs,
+                              int* out_tour, double* out_cost, int* out_status, int* in_tour)
+{
+
+    /* Options of the call */
+    double time_limit_value, target_value;
+    double* time_limit;
+    double* target;
+
+    /* Output flags of Concorde solver */
+    int success;        /* Set to 1 if a feasible tour is found */
+    int optimal;        /* Set to 1 if tour found is optimal */
+    int hit_timelimit;  /* Set to 1 if the time limit is reached */
+
+    /* Concorde indexes the endpoints of the edges with int */
+    if (n_edges < 0 || n_edges > EDGES_MAX) {
+        return concorde_error(DISCORDE_RETURN_TOO_LARGE, out_status);
+    }
+
+    /* Concorde copies the list of edges itself, so it is handed over in place */
+    context_limits(context, &time_limit_value, &time_limit, &target_value, &target);
+    concorde_call(n_nodes, NULL, n_edges, edges, edges_costs, &context->rstate, in_tour, NULL, out_tour, out_cost,
+                  context->verbose, time_limit, NULL, &success, &optimal, &hit_timelimit);
+
+    /* Set solver status and return value */
+    return concorde_result(success, optimal, hit_timelimit, out_cost, out_status, target, NULL);
+}
+
+int discorde_context_concorde_full(discorde_context* context, int n_nodes, int** cost_matrix,
+                                   int* out_tour, double* out_cost, int* out_status, int* in_tour)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+    matrix_view matrix;
+
+    /* Options of the call */
+    double time_limit_value, target_value;
+    double* time_limit;
+    double* target;
+
+    /* Output flags of Concorde solver */
+    int success;        /* Set to 1 if a feasible tour is found */
+    int optimal;        /* Set to 1 if tour found is optimal */
+    int hit_timelimit;  /* Set to 1 if the time limit is reached */
+
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+    return_value = context_matrix(context, &matrix);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return concorde_error(return_value, out_status);
+    }
+
+    /* Call Concorde solver over the matrix norm datagroup of the context */
+    context_limits(context, &time_limit_value, &time_limit, &target_value, &target);
+    concorde_call(n_nodes, &context->matrix_data, 0, NULL, NULL, &context->rstate, in_tour, NULL, out_tour, out_cost,
+                  context->verbose, time_limit, NULL, &success, &optimal, &hit_timelimit);
+
+    /* Set solver status and return value */
+    return concorde_result(success, optimal, hit_timelimit, out_cost, out_status, target, NULL);
+}
+
+int discorde_context_linkernighan(discorde_context* context, int n_nodes, int n_edges, int* edges, int* edges_costs,
+                                  int* out_tour, double* out_cost, int* in_tour)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+
+    /* Options of the call */
+    double time_limit_value, target_value;
+    double* time_limit;
+    double* target;
+
+    /* Concorde indexes the endpoints of the edges with int */
+    if (n_edges < 0 || n_edges > EDGES_MAX) {
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
+
+    return_value = context_sparse(context, n_nodes, n_edges, edges, edges_costs);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return return_value;
+    }
+
+    /* Call Lin-Kernighan heuristic over the sparse datagroup of the context */
+    context_limits(context, &time_limit_value, &time_limit, &target_value, &target);
+    return linkernighan_dat(n_nodes, &context->sparse_data, n_edges, edges, &context->rstate, out_tour, out_cost,
+                            in_tour, context->verbose, time_limit, target);
+}
+
+int discorde_context_linkernighan_full(discorde_context* context, int n_nodes, int** cost_matrix,
+                                       int* out_tour, double* out_cost, int* in_tour)
+{
+
+    /* Auxiliary variables */
+    int return_value;
+    matrix_view matrix;
+
+    /* Options of the call */
+    double time_limit_value, target_value;
+    double* time_limit;
+    double* target;
+
+    /* The candidate set is the complete graph, as in linkernighan_full */
+    if (n_nodes < 3) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+    if (context->complete_nodes != n_nodes) {
+        free(context->complete_list);
+        context->complete_list = NULL;
+        context->complete_nodes = 0;
+        return_value = complete_edges(n_nodes, &context->complete_n_edges, &context->complete_list);
+        if (return_value != DISCORDE_RETURN_OK) {
+            return return_value;
+        }
+        context->complete_nodes = n_nodes;
+    }
+
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+    return_value = context_matrix(context, &matrix);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return return_value;
+    }
+
+    /* Call Lin-Kernighan heuristic over the matrix norm datagroup of the context */
+    context_limits(context, &time_limit_value, &time_limit, &target_value, &target);
+    return linkernighan_dat(n_nodes, &context->matrix_data, context->complete_n_edges, context->complete_list,
+                            &context->rstate, out_tour, out_cost, in_tour, context->verbose, time_limit, target);
+}
+
+/*
+ * Dynamic tour over a subset of the nodes of a cost matrix. The tour is kept as an array together with the position of
+ * each node, so a node is inserted or removed by shifting the nodes after it. The k nearest neighbors of each node in
+ * the whole matrix give the candidate positions of an insertion, and after each change the Lin-Kernighan heuristic
+ * re-optimizes a window of the tour around it.
+ */
+struct discorde_dyntour {
+    matrix_view matrix;         /* Cost matrix of the caller, borrowed */
+    int k;                      /* Number of nearest neighbors of each node */
+    int* neighbors;             /* k nearest neighbors of node i at [i * k, (i + 1) * k) */
+    int radius;                 /* Number of nodes re-optimized on each side of a change */
+    int length;                 /* Number of nodes in the tour */
+    int* tour;                  /* Nodes of the tour in its first length entries */
+    int* position;              /* Position of each node in the tour, or -1 if it is not in the tour */
+    double cost;                /* Cost of the tour */
+    CCrandstate rstate;         /* Random state of the repairs, carried from change to change */
+};
+
+/*
+ * Largest radius of the window re-optimized after a change. The sub-instance of a window is a dense matrix, so its
+ * size is bounded to keep a repair within milliseconds.
+ */
+#define DYNTOUR_RADIUS_MAX 256
+
+/*
+ * Smallest number of nodes of a window re-optimized after a change (the Lin-Kernighan heuristic of Concorde needs 8).
+ */
+#define DYNTOUR_WINDOW_MIN 8
+
+/*
+ * Increase of cost given to an insertion position that does not exist.
+ */
+#define DYNTOUR_NO_POSITION 1e30
+
+/*
+ * Return the cost of the edge (i,j) of the matrix of a dynamic tour (zero if i = j).
+ */
+static int dyntour_cost(const discorde_dyntour* dyntour, int i, int j)
+{
+    size_t shift;
+    int swap;
+
+    if (i == j) {
+        return 0;
+    }
+    if (i > j) {
+        swap = i;
+        i = j;
+        j = swap;
+    }
+
+    return matrix_row(&dyntour->matrix, i, &shift)[j - shift];
+}
+
+void discorde_dyntour_free(discorde_dyntour* dyntour)
+{
+    if (dyntour == NULL) {
+        return;
+    }
+
+    free(dyntour->neighbors);
+    free(dyntour->tour);
+    free(dyntour->position);
+    free(dyntour);
+}
+
+int discorde_dyntour_create(int n_nodes, int** cost_matrix, int tour_length, const int* tour, int k_nearest,
+                            int repair_radius, discorde_dyntour** out_dyntour)
+{
+
+    /* Auxiliary variables */
+    int i, return_value;
+    discorde_dyntour* dyntour;
+    CCdatagroup data;       /* Copy of the matrix read by the search of the nearest neighbors */
+
+    *out_dyntour = NULL;
+    if (n_nodes < 2 || tour_length < 0 || tour_length > n_nodes || k_nearest < 1 || repair_radius < 0) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    dyntour = (discorde_dyntour*) malloc(sizeof(discorde_dyntour));
+    if (dyntour == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    dyntour->matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+    dyntour->k = (k_nearest < n_nodes - 1) ? k_nearest : n_nodes - 1;
+    dyntour->neighbors = NULL;
+    dyntour->radius = (repair_radius < DYNTOUR_RADIUS_MAX) ? repair_radius : DYNTOUR_RADIUS_MAX;
+    dyntour->tour = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    dyntour->position = (int*) alloc_array((size_t) n_nodes, sizeof(int));
+    if (dyntour->tour == NULL || dyntour->position == NULL) {
+        discorde_dyntour_free(dyntour);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    CCutil_sprand(call_seed(next_call_id()), &dyntour->rstate);
+
+    /* The nodes of the tour must be distinct nodes of the matrix */
+    for (i = 0; i < n_nodes; ++i) {
+        dyntour->position[i] = -1;
+    }
+    for (i = 0; i < tour_length; ++i) {
+        if (tour[i] < 0 || tour[i] >= n_nodes || dyntour->position[tour[i]] >= 0) {
+            discorde_dyntour_free(dyntour);
+            return DISCORDE_RETURN_FAILURE;
+        }
+        dyntour->tour[i] = tour[i];
+        dyntour->position[tour[i]] = i;
+    }
+    dyntour->length = tour_length;
+    dyntour->cost = 0;
+    for (i = 0; i < tour_length && tour_length > 1; ++i) {
+        dyntour->cost += dyntour_cost(dyntour, tour[i], tour[(i + 1) % tour_length]);
+    }
+
+    /* Index of the nearest neighbors of every node, in or out of the tour */
+    return_value = matrix_dat_init(&dyntour->matrix, &data);
+    if (return_value == DISCORDE_RETURN_OK) {
+        return_value = knn_neighbors(&dyntour->matrix, &data, dyntour->k, &dyntour->neighbors);
+    }
+    CCutil_freedatagroup(&data);
+    if (return_value != DISCORDE_RETURN_OK) {
+        discorde_dyntour_free(dyntour);
+        return return_value;
+    }
+
+    *out_dyntour = dyntour;
+
+    return DISCORDE_RETURN_OK;
+}
+
+int discorde_dyntour_length(const discorde_dyntour* dyntour)
+{
+    return dyntour->length;
+}
+
+void discorde_dyntour_get(const discorde_dyntour* dyntour, int* out_tour, double* out_cost)
+{
+    memcpy(out_tour, dyntour->tour, sizeof(int) * (size_t) dyntour->length);
+    *out_cost = dyntour->cost;
+}
+
+/*
+ * Add the pair of nodes {@code (i, j)} of a window to its list of candidate edges, unless it is already listed.
+ */
+static void dyntour_window_edge(int m, char* listed, int* edges, int* n_edges, int i, int j)
+{
+    int swap;
+
+    if (i == j) {
+        return;
+    }
+    if (i > j) {
+        swap = i;
+        i = j;
+        j = swap;
+    }
+    if (!listed[(size_t) i * m + j]) {
+        listed[(size_t) i * m + j] = 1;
+        edges[2 * *n_edges] = i;
+        edges[2 * *n_edges + 1] = j;
+        ++*n_edges;
+    }
+}
+
+/*
+ * Re-optimize the window of {@code 2 * radius + 1} nodes of the tour centered at position {@code center} with the
+ * Lin-Kernighan heuristic, or the whole tour if it is not longer than the window plus one. The endpoints of a window
+ * stay in place: the edge between them is forced into the tour of the sub-instance by a penalty on every other edge,
+ * so that tour is a path between them. The candidate set is restricted to the nearest neighbors of each node that lie
+ * in the window, and the new order is kept only if it is cheaper. The tour is left as it is if a buffer cannot be
+ * allocated.
+ */
+static void dyntour_repair(discorde_dyntour* dyntour, int center)
+{
+
+    /* Auxiliary variables */
+    int i, j, v, offset, first, m, zero;
+    bool whole;             /* Whether the whole tour is re-optimized */
+    int max_cost, min_cost, cost, penalty;
+    double old_cost, new_cost;
+    int* window;            /* Nodes of the window, in tour order */
+    int* order;             /* New order of the window */
+    int* lk_tour;           /* Tour of the sub-instance found by the heuristic */
+    int* edges;             /* Candidate edges of the sub-instance */
+    int n_edges;
+    char* listed;           /* Whether each pair of nodes of the window is a candidate edge */
+    double lk_cost;
+    CCdatagroup data;       /* Sub-instance of the window */
+
+    whole = dyntour->length <= 2 * dyntour->radius + 2;
+    m = whole ? dyntour->length : 2 * dyntour->radius + 1;
+    first = whole ? 0 : (center - dyntour->radius + dyntour->length) % dyntour->length;
+    if (m < DYNTOUR_WINDOW_MIN) {
+        return;
+    }
+
+    window = (int*) alloc_array((size_t) m, sizeof(int));
+    order = (int*) alloc_array((size_t) m, sizeof(int));
+    lk_tour = (int*) alloc_array((size_t) m, sizeof(int));
+    edges = (int*) alloc_array(2 * (size_t) m * (dyntour->k + 1), sizeof(int));
+    listed = (char*) calloc((size_t) m * m, sizeof(char));
+    CCutil_init_datagroup(&data);
+    if (window == NULL || order == NULL || lk_tour == NULL || edges == NULL || listed == NULL
+        || matrix_dat_alloc(m, &data) != DISCORDE_RETURN_OK) {
+        free(window);
+        free(order);
+        free(lk_tour);
+        free(edges);
+        free(listed);
+        CCutil_freedatagroup(&data);
+        return;
+    }
+
+    /* Sub-instance of the window, with the costs of the matrix (lower triangle, as used by Concorde) */
+    for (i = 0; i < m; ++i) {
+        window[i] = dyntour->tour[(first + i) % dyntour->length];
+        order[i] = i;
+        lk_tour[i] = i;
+    }
+    max_cost = dyntour_cost(dyntour, window[1], window[0]);
+    min_cost = max_cost;
+    for (i = 0; i < m; ++i) {
+        for (j = 0; j < i; ++j) {
+            cost = dyntour_cost(dyntour, window[i], window[j]);
+            data.adj[i][j] = cost;
+            max_cost = (cost > max_cost) ? cost : max_cost;
+            min_cost = (cost < min_cost) ? cost : min_cost;
+        }
+        data.adj[i][i] = 0;
+    }
+
+    /* The penalty exceeds the cost of any path through the window, so the forced edge is in every good tour */
+    penalty = 0;
+    if (!whole) {
+        if ((double) (max_cost - min_cost) * m + max_cost + 1 > INT_MAX / 2) {
+            CCutil_freedatagroup(&data);
+            free(window);
+            free(order);
+            free(lk_tour);
+            free(edges);
+            free(listed);
+            return;
+        }
+        penalty = (max_cost - min_cost) * (m - 1) + 1;
+        for (i = 0; i < m; ++i) {
+            for (j = 0; j < i; ++j) {
+                data.adj[i][j] += penalty;
+            }
+        }
+        data.adj[m - 1][0] -= penalty;
+    }
+
+    /* Candidate set: the edges of the current order, and the nearest neighbors of each node within the window */
+    n_edges = 0;
+    for (i = 0; i < m; ++i) {
+        dyntour_window_edge(m, listed, edges, &n_edges, i, (i + 1) % m);
+        for (j = 0; j < dyntour->k; ++j) {
+            v = dyntour->neighbors[(size_t) window[i] * dyntour->k + j];
+            if (dyntour->position[v] >= 0) {
+                offset = (dyntour->position[v] - first + dyntour->length) % dyntour->length;
+                if (offset < m) {
+                    dyntour_window_edge(m, listed, edges, &n_edges, i, offset);
+                }
+            }
+        }
+    }
+
+    /* Start from the current order and read the new one from node 0 of the window, towards its other endpoint */
+    linkernighan_dat(m, &data, n_edges, edges, &dyntour->rstate, lk_tour, &lk_cost, order, false, NULL, NULL);
+    for (zero = 0; lk_tour[zero] != 0; ++zero);
+    if (whole || lk_tour[(zero + m - 1) % m] == m - 1) {
+        for (i = 0; i < m; ++i) {
+            order[i] = lk_tour[(zero + i) % m];
+        }
+    } else if (lk_tour[(zero + 1) % m] == m - 1) {
+        for (i = 0; i < m; ++i) {
+            order[i] = lk_tour[(zero - i + m) % m];
+        }
+    }
+
+    /* Keep the new order if it is cheaper (the closing edge of a window is the same in both) */
+    old_cost = 0;
+    new_cost = 0;
+    for (i = 0; i < m - 1; ++i) {
+        old_cost += dyntour_cost(dyntour, window[i], window[i + 1]);
+        new_cost += dyntour_cost(dyntour, window[order[i]], window[order[i + 1]]);
+    }
+    if (whole) {
+        old_cost += dyntour_cost(dyntour, window[m - 1], window[0]);
+        new_cost += dyntour_cost(dyntour, window[order[m - 1]], window[order[0]]);
+    }
+    if (new_cost < old_cost) {
+        for (i = 0; i < m; ++i) {
+            dyntour->tour[(first + i) % dyntour->length] = window[order[i]];
+            dyntour->position[window[order[i]]] = (first + i) % dyntour->length;
+        }
+        dyntour->cost += new_cost - old_cost;
+    }
+
+    /* Free resources */
+    CCutil_freedatagroup(&data);
+    free(window);
+    free(order);
+    free(lk_tour);
+    free(edges);
+    free(listed);
+}
+
+/*
+ * Compare the insertion of {@code node} after position {@code index} of the tour with the best two found so far.
+ */
+static void dyntour_consider(const discorde_dyntour* dyntour, int node, int index, int* best_index,
+                             double* best_delta, double* second_delta)
+{
+    int a, b;
+    double delta;
+
+    if (index == *best_index) {
+        return;
+    }
+
+    a = dyntour->tour[index];
+    b = dyntour->tour[(index + 1) % dyntour->length];
+    delta = (double) dyntour_cost(dyntour, a, node) + dyntour_cost(dyntour, node, b) - dyntour_cost(dyntour, a, b);
+    if (*best_index < 0 || delta < *best_delta) {
+        *second_delta = *best_delta;
+        *best_delta = delta;
+        *best_index = index;
+    } else if (delta < *second_delta) {
+        *second_delta = delta;
+    }
+}
+
+/*
+ * Find the cheapest position to insert {@code node} (the position after which it goes) and the increase of cost of
+ * the two cheapest positions. The candidate positions are the edges of the tour at its nearest neighbors, or every
+ * edge of the tour if none of them is in the tour. The tour must not be empty.
+ */
+static void dyntour_best_insertion(const discorde_dyntour* dyntour, int node, int* best_index, double* best_delta,
+                                   double* second_delta)
+{
+    int j, v, p;
+
+    *best_index = -1;
+    *best_delta = DYNTOUR_NO_POSITION;
+    *second_delta = DYNTOUR_NO_POSITION;
+    for (j = 0; j < dyntour->k; ++j) {
+        v = dyntour->neighbors[(size_t) node * dyntour->k + j];
+        p = dyntour->position[v];
+        if (p >= 0) {
+            dyntour_consider(dyntour, node, p, best_index, best_delta, second_delta);
+            dyntour_consider(dyntour, node, (p + dyntour->length - 1) % dyntour->length, best_index, best_delta,
+                             second_delta);
+        }
+    }
+
+    if (*best_index < 0) {
+        for (p = 0; p < dyntour->length; ++p) {
+            dyntour_consider(dyntour, node, p, best_index, best_delta, second_delta);
+        }
+    }
+}
+
+/*
+ * Insert {@code node} after position {@code index} of the tour (or as its only node if it is empty), with the given
+ * increase of cost, and repair the tour around it.
+ */
+static void dyntour_insert_at(discorde_dyntour* dyntour, int node, int index, double delta)
+{
+    int i, p;
+
+    p = (dyntour->length > 0) ? index + 1 : 0;
+    memmove(dyntour->tour + p + 1, dyntour->tour + p, sizeof(int) * (size_t) (dyntour->length - p));
+    dyntour->tour[p] = node;
+    ++dyntour->length;
+    for (i = p; i < dyntour->length; ++i) {
+        dyntour->position[dyntour->tour[i]] = i;
+    }
+    dyntour->cost = (dyntour->length > 1) ? dyntour->cost + delta : 0;
+
+    dyntour_repair(dyntour, p);
+}
+
+int discorde_dyntour_insert(discorde_dyntour* dyntour, int n_insert, const int* nodes, bool regret)
+{
+
+    /* Auxiliary variables */
+    int i, chosen, index, best_index;
+    double delta, best_delta, second_delta, most_regret;
+    int* pending;           /* Nodes not inserted yet, in the order given */
+    int n_pending;
+
+    /* The nodes must be distinct nodes out of the tour (they are marked with position -2 while they are checked) */
+    for (i = 0; i < n_insert; ++i) {
+        if (nodes[i] < 0 || nodes[i] >= dyntour->matrix.n_nodes || dyntour->position[nodes[i]] != -1) {
+            break;
+        }
+        dyntour->position[nodes[i]] = -2;
+    }
+    n_pending = i;
+    for (i = 0; i < n_pending; ++i) {
+        dyntour->position[nodes[i]] = -1;
+    }
+    if (n_pending < n_insert) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    pending = (int*) alloc_array((size_t) n_insert, sizeof(int));
+    if (pending == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    memcpy(pending, nodes, sizeof(int) * (size_t) n_insert);
+
+    /*
+     * Each node goes to its cheapest position. With regret insertion, the next node inserted is the one that loses the
+     * most if it does not get its cheapest position, i.e., the one with the largest gap between its two cheapest.
+     */
+    while (n_pending > 0) {
+        chosen = 0;
+        index = 0;
+        delta = 0;
+        if (dyntour->length > 0) {
+            most_regret = -1;
+            for (i = 0; i < (regret ? n_pending : 1); ++i) {
+                dyntour_best_insertion(dyntour, pending[i], &best_index, &best_delta, &second_delta);
+                if (second_delta - best_delta > most_regret) {
+                    most_regret = second_delta - best_delta;
+                    chosen = i;
+                    index = best_index;
+                    delta = best_delta;
+                }
+            }
+        }
+        dyntour_insert_at(dyntour, pending[chosen], index, delta);
+        memmove(pending + chosen, pending + chosen + 1, sizeof(int) * (size_t) (n_pending - chosen - 1));
+        --n_pending;
+    }
+
+    free(pending);
+
+    return DISCORDE_RETURN_OK;
+}
+
+int discorde_dyntour_remove(discorde_dyntour* dyntour, int node)
+{
+    int i, p, a, b;
+
+    if (node < 0 || node >= dyntour->matrix.n_nodes || dyntour->position[node] < 0) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    /* The neighbors of the node in the tour are joined by an edge */
+    p = dyntour->position[node];
+    a = dyntour->tour[(p + dyntour->length - 1) % dyntour->length];
+    b = dyntour->tour[(p + 1) % dyntour->length];
+    dyntour->cost += (double) dyntour_cost(dyntour, a, b) - dyntour_cost(dyntour, a, node)
+                     - dyntour_cost(dyntour, node, b);
+
+    memmove(dyntour->tour + p, dyntour->tour + p + 1, sizeof(int) * (size_t) (dyntour->length - p - 1));
+    --dyntour->length;
+    for (i = p; i < dyntour->length; ++i) {
+        dyntour->position[dyntour->tour[i]] = i;
+    }
+    dyntour->position[node] = -1;
+    if (dyntour->length < 2) {
+        dyntour->cost = 0;
+    }
+
+    if (dyntour->length > 0) {
+        dyntour_repair(dyntour, p % dyntour->length);
+    }
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Store of the last tour of a family of instances, keyed by node IDs given by the caller, so that it can start the
+ * next solve even if the node set has changed.
+ */
+struct discorde_warmstore {
+    int n_nodes;                /* Number of nodes of the tour, or 0 if no tour has been saved */
+    long* tour_ids;             /* IDs of the nodes of the tour, in tour order */
+};
+
+/*
+ * Cost of the edge (i,j) of an instance being projected on, given by a cost matrix or by a sparse datagroup.
+ */
+typedef struct warmstore_costs {
+    const matrix_view* matrix;  /* Cost matrix, or NULL */
+    CCdatagroup* data;          /* Sparse datagroup, used if matrix is NULL */
+} warmstore_costs;
+
+static int warmstore_cost(const warmstore_costs* costs, int i, int j)
+{
+    size_t shift;
+    int swap;
+
+    if (costs->matrix == NULL) {
+        return CCutil_dat_edgelen(i, j, costs->data);
+    }
+    if (i == j) {
+        return 0;
+    }
+    if (i > j) {
+        swap = i;
+        i = j;
+        j = swap;
+    }
+
+    return matrix_row(costs->matrix, i, &shift)[j - shift];
+}
+
+/*
+ * Hash of a node ID, for the open-addressing table of {@code warmstore_project}.
+ */
+static unsigned long warmstore_hash(long id)
+{
+    unsigned long h;
+
+    h = (unsigned long) id;
+    h ^= h >> 16;
+    h = (h * 0x45D9F3BUL) & 0xFFFFFFFFUL;
+    h ^= h >> 16;
+
+    return h;
+}
+
+int discorde_warmstore_create(discorde_warmstore** out_store)
+{
+    discorde_warmstore* store;
+
+    store = (discorde_warmstore*) malloc(sizeof(discorde_warmstore));
+    *out_store = store;
+    if (store == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    store->n_nodes = 0;
+    store->tour_ids = NULL;
+
+    return DISCORDE_RETURN_OK;
+}
+
+void discorde_warmstore_free(discorde_warmstore* store)
+{
+    if (store == NULL) {
+        return;
+    }
+
+    free(store->tour_ids);
+    free(store);
+}
+
+int discorde_warmstore_save(discorde_warmstore* store, int n_nodes, const long* node_ids, const int* tour)
+{
+    int i;
+    long* tour_ids;
+
+    tour_ids = (long*) alloc_array((size_t) n_nodes, sizeof(long));
+    if (tour_ids == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    for (i = 0; i < n_nodes; ++i) {
+        tour_ids[i] = node_ids[tour[i]];
+    }
+
+    free(store->tour_ids);
+    store->tour_ids = tour_ids;
+    store->n_nodes = n_nodes;
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Project the tour of a store onto a new node set: the nodes of the tour that are still there keep their order, the
+ * nodes that are gone are dropped, and each new node is inserted at the cheapest position of the tour built so far.
+ * Returns {@code DISCORDE_RETURN_FAILURE} if the store is empty or the IDs are not distinct.
+ */
+static int warmstore_project(const discorde_warmstore* store, int n_nodes, const long* node_ids,
+                             const warmstore_costs* costs, int* out_tour)
+{
+
+    /* Auxiliary variables */
+    int i, p, node, length, best_index;
+    unsigned long slot, mask;
+    double delta, best_delta;
+    int* table;             /* Open-addressing table from the IDs to the nodes of the new node set, -1 if empty */
+    bool* placed;           /* Whether each node of the new node set is in the tour */
+
+    if (store->n_nodes == 0 || n_nodes < 1) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    /* The table is at most half full */
+    for (mask = 1; mask < 2 * (unsigned long) n_nodes; mask <<= 1);
+    table = (int*) alloc_array((size_t) mask, sizeof(int));
+    placed = (bool*) alloc_array((size_t) n_nodes, sizeof(bool));
+    if (table == NULL || placed == NULL) {
+        free(table);
+        free(placed);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    --mask;
+    for (slot = 0; slot <= mask; ++slot) {
+        table[slot] = -1;
+    }
+    for (i = 0; i < n_nodes; ++i) {
+        placed[i] = false;
+        for (slot = warmstore_hash(node_ids[i]) & mask; table[slot] >= 0; slot = (slot + 1) & mask) {
+            if (node_ids[table[slot]] == node_ids[i]) {
+                free(table);
+                free(placed);
+                return DISCORDE_RETURN_FAILURE;
+            }
+        }
+        table[slot] = i;
+    }
+
+    /* The nodes of the old tour still present keep their order */
+    length = 0;
+    for (i = 0; i < store->n_nodes; ++i) {
+        for (slot = warmstore_hash(store->tour_ids[i]) & mask; table[slot] >= 0; slot = (slot + 1) & mask) {
+            node = table[slot];
+            if (node_ids[node] == store->tour_ids[i]) {
+                if (!placed[node]) {
+                    placed[node] = true;
+                    out_tour[length++] = node;
+                }
+                break;
+            }
+        }
+    }
+
+    /* The new nodes are inserted one by one at the cheapest position */
+    for (node = 0; node < n_nodes; ++node) {
+        if (placed[node]) {
+            continue;
+        }
+        best_index = 0;
+        best_delta = 0;
+        for (p = 0; p < length; ++p) {
+            delta = (double) warmstore_cost(costs, out_tour[p], node)
+                    + warmstore_cost(costs, node, out_tour[(p + 1) % length])
+                    - warmstore_cost(costs, out_tour[p], out_tour[(p + 1) % length]);
+            if (p == 0 || delta < best_delta) {
+                best_delta = delta;
+                best_index = p;
+            }
+        }
+        if (length > 0) {
+            memmove(out_tour + best_index + 2, out_tour + best_index + 1,
+                    sizeof(int) * (size_t) (length - best_index - 1));
+            out_tour[best_index + 1] = node;
+        } else {
+            out_tour[0] = node;
+        }
+        placed[node] = true;
+        ++length;
+    }
+
+    free(table);
+    free(placed);
+
+    return DISCORDE_RETURN_OK;
+}
+
+int discorde_warmstore_project(const discorde_warmstore* store, int n_nodes, const long* node_ids,
+                               int n_edges, int* edges, int* edges_costs, int* out_tour)
+{
+    int return_value;
+    warmstore_costs costs;
+    CCdatagroup data;
+
+    if (n_edges < 0 || n_edges > EDGES_MAX) {
+        return DISCORDE_RETURN_TOO_LARGE;
+    }
+
+    /* A missing edge costs more than any tour over the edges of the list, so no insertion uses one if it can help it */
+    CCutil_init_datagroup(&data);
+    if (CCutil_graph2dat_sparse(n_nodes, n_edges, edges, edges_costs,
+                                cutpool_missing_len(n_nodes, n_edges, edges_costs), &data) != 0) {
+        CCutil_freedatagroup(&data);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    costs.matrix = NULL;
+    costs.data = &data;
+
+    return_value = warmstore_project(store, n_nodes, node_ids, &costs, out_tour);
+
+    CCutil_freedatagroup(&data);
+
+    return return_value;
+}
+
+int discorde_warmstore_project_full(const discorde_warmstore* store, int n_nodes, const long* node_ids,
+                                    int** cost_matrix, int* out_tour)
+{
+    matrix_view matrix;
+    warmstore_costs costs;
+
+    matrix = matrix_view_of(MATRIX_ROWS, n_nodes, cost_matrix, NULL);
+    costs.matrix = &matrix;
+    costs.data = NULL;
+
+    return warmstore_project(store, n_nodes, node_ids, &costs, out_tour);
+}
@@ -25,6 +25,18 @@ extern "C" {
  */
 #define  DISCORDE_RETURN_FAILURE 1
 
+/**
+ * Returned if the instance cannot be represented by Concorde, e.g., if a list of edges given to Concorde would have
+ * more than {@code INT_MAX / 2} edges. It is returned before the solver is called.
+ */
+#define DISCORDE_RETURN_TOO_LARGE 2
+
+/**
+ * Returned if the memory required to format the instance for Concorde could not be allocated. It is returned before
+ * the solver is called.
+ */
+#define DISCORDE_RETURN_NO_MEMORY 3
+
 /**
  * The solver stopped because the optimal tour was found.
  */
@@ -45,13 +57,304 @@ extern "C" {
  */
 #define DISCORDE_STATUS_UNKNOWN 3
 
+/**
+ * The solver stopped because its monitor was cancelled (see {@code discorde_monitor_cancel}).
+ */
+#define DISCORDE_STATUS_CANCELLED 4
+
+/**
+ * Euclidean norm: the distance between two points is the euclidean distance rounded to the nearest integer.
+ */
+#define DISCORDE_NORM_EUCLIDEAN 0
+
+/**
+ * Euclidean norm rounded up: the distance between two points is the euclidean distance rounded up.
+ */
+#define DISCORDE_NORM_EUCLIDEAN_CEIL 1
+
+/**
+ * Three-dimensional euclidean norm: the distance between two points is the euclidean distance (considering x, y and z
+ * coordinates) rounded to the nearest integer.
+ */
+#define DISCORDE_NORM_EUCLIDEAN_3D 2
+
+/**
+ * Maximum norm: the distance between two points is the maximum of the differences between their coordinates.
+ */
+#define DISCORDE_NORM_MAX 3
+
+/**
+ * Manhattan norm: the distance between two points is the sum of the differences between their coordinates.
+ */
+#define DISCORDE_NORM_MANHATTAN 4
+
+/**
+ * Pseudo-euclidean norm used by ATT instances of TSPLIB.
+ */
+#define DISCORDE_NORM_ATT 5
+
+/**
+ * Geographic norm of TSPLIB: coordinates are latitude (x) and longitude (y) in DDD.MM format.
+ */
+#define DISCORDE_NORM_GEOGRAPHIC 6
+
+/**
+ * Geographic norm with coordinates given as latitude (x) and longitude (y) in decimal degrees. The distance is given
+ * in meters.
+ */
+#define DISCORDE_NORM_GEOM 7
+
+/**
+ * Solver of a job of a batch: Concorde branch-and-cut.
+ */
+#define DISCORDE_SOLVER_CONCORDE 0
+
+/**
+ * Solver of a job of a batch: Lin-Kernighan heuristic.
+ */
+#define DISCORDE_SOLVER_LINKERNIGHAN 1
+
+/**
+ * Layout of a cost matrix: array of {@code n_nodes} row pointers, as taken by {@code concorde_full}.
+ */
+#define DISCORDE_MATRIX_ROWS 0
+
+/**
+ * Layout of a cost matrix: contiguous row-major buffer of {@code n_nodes * n_nodes} entries, as taken by
+ * {@code concorde_full_flat}.
+ */
+#define DISCORDE_MATRIX_FLAT 1
+
+/**
+ * Layout of a cost matrix: upper triangle packed row by row into {@code n_nodes * (n_nodes - 1) / 2} entries, as
+ * taken by {@code concorde_full_packed}.
+ */
+#define DISCORDE_MATRIX_PACKED 2
+
+/**
+ * Kick of the Lin-Kernighan heuristic: a random double-bridge (4-swap).
+ */
+#define DISCORDE_KICK_RANDOM 0
+
+/**
+ * Kick of the Lin-Kernighan heuristic: a double-bridge among geometrically close nodes. It needs the coordinates of the
+ * nodes; on other instances the random walk kick is used instead.
+ */
+#define DISCORDE_KICK_GEOMETRIC 1
+
+/**
+ * Kick of the Lin-Kernighan heuristic: a double-bridge among nodes chosen close to each other in the tour.
+ */
+#define DISCORDE_KICK_CLOSE 2
+
+/**
+ * Kick of the Lin-Kernighan heuristic: a double-bridge among nodes reached by random walks in the candidate graph.
+ */
+#define DISCORDE_KICK_WALK 3
+
+/**
+ * Lower bound: the fractional 2-matching bound, i.e., the cheapest half-integral assignment of edge values in which
+ * each node has degree 2.
+ */
+#define DISCORDE_BOUND_2MATCHING 0
+
+/**
+ * Lower bound: the bound of the root LP of Concorde after its cutting loop, without any branching.
+ */
+#define DISCORDE_BOUND_ROOT_LP 1
+
 #endif /* DISCORDE_CONSTANTS */
 
 
+/*
+ * Thread safety: the functions below may be called concurrently from several threads (on distinct output arrays). Each
+ * call owns its random state and Concorde writes its temporary files in a directory of its own, named after the host,
+ * the process id, a per-process call counter and a random nonce, and locked by the run while it is alive (see
+ * {@code discorde_set_scratch_dir}). Two properties of Concorde remain shared by all threads of a process:
+ *  - time limits are measured by Concorde as the CPU time of the whole process, so concurrent calls consume each
+ *    other's time limit;
+ *  - branch-and-cut runs on the LP solver Concorde has been built with; if that solver is not reentrant, build Discorde
+ *    with the CMake option DISCORDE_SERIALIZE_CONCORDE so these calls run one at a time.
+ */
+
+/**
+ * Set the scratch directory of the process, where each run of Concorde creates a directory of its own for its temporary
+ * files (problem, save and pool files). The directory of a run is removed with every file in it when the run returns.
+ * Each run holds a lock (flock) on a file of its directory while it is alive, which the system releases when the run
+ * dies, so the directories whose lock is free, left by runs that died (on any host sharing the directory, or in any pid
+ * namespace), are removed by the first run of the process, and again by the first run after each call of this function.
+ * By default, the shared memory file system {@code /dev/shm} is used if available, so the files of Concorde stay in
+ * memory, and otherwise the directory given by the environment variable {@code TMPDIR}, {@code /tmp} or the working
+ * directory. Concorde has no option to keep its branch-and-bound problems in memory, so a memory-backed scratch
+ * directory is the way to keep them off the disk.
+ *
+ * @param   path
+ *          Path of an existing directory where files can be created, or {@code NULL} to restore the default directory.
+ *          It is copied, and it applies to the runs started afterwards.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the scratch directory has been set, or {@code DISCORDE_RETURN_FAILURE} if
+ *          {@code path} is not a writable directory or its path is too long.
+ */
+int discorde_set_scratch_dir(const char *path);
+
+/**
+ * Handle to a sparse graph whose edges are kept in the format read by Concorde, so that the solvers use them in place
+ * on every call. A handle may be shared by concurrent calls and must be released with {@code discorde_graph_free}.
+ */
+typedef struct discorde_graph discorde_graph;
+
+/**
+ * Create a graph handle from an array of edges given with any stride, e.g., an array of structures holding the two
+ * endpoints and the cost of each edge. If the endpoints are packed as pairs ({@code edges_stride} equal to
+ * {@code 2 * sizeof(int)} or zero) and the costs are packed ({@code costs_stride} equal to {@code sizeof(int)} or
+ * zero), the arrays are not copied: they are borrowed by the handle and must remain valid and unchanged until it is
+ * released. Otherwise they are gathered once into arrays owned by the handle.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          Pointer to the endpoints of the first edge. The two endpoints of each edge are consecutive {@code int}
+ *          values.
+ * @param   edges_stride
+ *          Distance, in bytes, between the endpoints of two consecutive edges. Zero means {@code 2 * sizeof(int)}.
+ * @param   edges_costs
+ *          Pointer to the cost (weight) of the first edge.
+ * @param   costs_stride
+ *          Distance, in bytes, between the costs of two consecutive edges. Zero means {@code sizeof(int)}.
+ * @param   out_graph
+ *          A pointer to store the handle created. It is set to {@code NULL} on failure.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the handle has been created, {@code DISCORDE_RETURN_TOO_LARGE} if the graph
+ *          has more edges than Concorde can index, {@code DISCORDE_RETURN_NO_MEMORY} if its arrays could not be
+ *          allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int discorde_graph_strided(int n_nodes, int n_edges, const int *edges, size_t edges_stride,
+                           const int *edges_costs, size_t costs_stride, discorde_graph **out_graph);
+
+/**
+ * Create a graph handle from a symmetric adjacency in compressed sparse row (CSR) format. Each edge (i,j) is expected
+ * in the adjacency of both nodes; only the entry with i less than j is kept. The adjacency is converted once into
+ * arrays owned by the handle, so it may be released right after this call.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   offsets
+ *          An array of length {@code n_nodes + 1}. The neighbors of node i are the entries from {@code offsets[i]} to
+ *          {@code offsets[i + 1] - 1} of {@code targets} and {@code weights}.
+ * @param   targets
+ *          An array of length {@code offsets[n_nodes]} with the neighbors of each node.
+ * @param   weights
+ *          An array of length {@code offsets[n_nodes]} with the cost (weight) of the edge to each neighbor.
+ * @param   out_graph
+ *          A pointer to store the handle created. It is set to {@code NULL} on failure.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the handle has been created, {@code DISCORDE_RETURN_TOO_LARGE} if the graph
+ *          has more edges than Concorde can index, {@code DISCORDE_RETURN_NO_MEMORY} if its arrays could not be
+ *          allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int discorde_graph_csr(int n_nodes, const int *offsets, const int *targets, const int *weights,
+                       discorde_graph **out_graph);
+
+/**
+ * Release a graph handle and the arrays it owns. Borrowed arrays are not released. It does nothing if {@code graph} is
+ * {@code NULL}.
+ *
+ * @param   graph
+ *          The handle to release.
+ */
+void discorde_graph_free(discorde_graph *graph);
+
+/**
+ * Handle to a monitor of solver calls: a callback fired on every new best tour and a cancellation token. It is passed
+ * to the {@code _monitored} variants of the solvers, may be shared by concurrent calls and must be released with
+ * {@code discorde_monitor_free}.
+ */
+typedef struct discorde_monitor discorde_monitor;
+
+/**
+ * Progress of a solver call, given to the callback of its monitor on every new best tour.
+ */
+#ifndef DISCORDE_PROGRESS_DEFINED
+#define DISCORDE_PROGRESS_DEFINED
+typedef struct discorde_progress {
+    int n_nodes;                /* Number of nodes */
+    const int *tour;            /* Best tour found so far (only valid during the call of the callback) */
+    double cost;                /* Cost of the best tour */
+    bool lower_bound_known;     /* Whether a lower bound of the optimal cost is known */
+    double lower_bound;         /* Best lower bound known (only set if lower_bound_known is true) */
+    double elapsed;             /* Wall-clock time elapsed since the call started, in seconds */
+} discorde_progress;
+#endif /* DISCORDE_PROGRESS_DEFINED */
+
+/**
+ * Callback of a monitor. The calls of the callback of a monitor never overlap, even when several threads report
+ * progress, but they run on the threads of the solver, so the callback should return quickly. It may cancel the
+ * monitor by returning a non-zero value.
+ */
+typedef int (*discorde_callback)(const discorde_progress *progress, void *user_data);
+
+/**
+ * Create a monitor.
+ *
+ * @param   callback
+ *          Function called on every new best tour. It may be {@code NULL} if only the cancellation token is desired.
+ * @param   user_data
+ *          Pointer given back to {@code callback} on every call.
+ * @param   out_monitor
+ *          A pointer to store the handle created. It is set to {@code NULL} on failure.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the monitor has been created, or {@code DISCORDE_RETURN_NO_MEMORY} otherwise.
+ */
+int discorde_monitor_create(discorde_callback callback, void *user_data, discorde_monitor **out_monitor);
+
+/**
+ * Cancel the calls monitored by {@code monitor}, including the calls started later, until the monitor is reset. It may
+ * be called from any thread, including the callback. The calls return their best tour so far with the status
+ * {@code DISCORDE_STATUS_CANCELLED}: the Lin-Kernighan heuristic stops at the end of its current round of kicks, a
+ * branch-and-bound driven by Discorde between two of its nodes, and any other Concorde run at its next check of the
+ * time limit. Concorde checks it only between two nodes of its own branch-and-bound, never during its initial heuristic
+ * or its root LP, so such a run may go on for most of its runtime, or to its end if the root LP proves its tour
+ * optimal.
+ *
+ * @param   monitor
+ *          The monitor to cancel.
+ */
+void discorde_monitor_cancel(discorde_monitor *monitor);
+
+/**
+ * Return whether {@code monitor} has been cancelled. It returns {@code false} if {@code monitor} is {@code NULL}.
+ *
+ * @param   monitor
+ *          The monitor to check.
+ */
+bool discorde_monitor_cancelled(discorde_monitor *monitor);
+
+/**
+ * Clear the cancellation of {@code monitor}, so that it can be used by later calls.
+ *
+ * @param   monitor
+ *          The monitor to reset.
+ */
+void discorde_monitor_reset(discorde_monitor *monitor);
+
+/**
+ * Release a monitor. No call monitored by it may be running. It does nothing if {@code monitor} is {@code NULL}.
+ *
+ * @param   monitor
+ *          The monitor to release.
+ */
+void discorde_monitor_free(discorde_monitor *monitor);
+
 /**
  * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver. Concorde is a
  * branch-and-cut based solver that solves a TSP instance to optimality, if no time limit or target is set.
  *
+ * Instances of at most 12 nodes are solved to optimality by the dynamic program of Held and Karp instead, in well under
+ * a millisecond and without the LP machinery of Concorde. This holds for every Concorde function of this API;
+ * {@code concorde_pooled} and {@code discorde_reopt_solve} then leave their cut pool as it is.
+ *
  * @param   n_nodes
  *          Number of nodes.
  * @param   n_edges
@@ -99,15 +402,26 @@ int concorde(int n_nodes, int n_edges, int *edges, int *edges_costs,
  * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver. Concorde is a
  * branch-and-cut based solver that solves a TSP instance to optimality, if no time limit or target is set.
  *
+ * The call is monitored by {@code monitor}: above 12 nodes, the branch-and-bound is driven by Discorde, so the callback
+ * is fired with the initial Lin-Kernighan tour, on every better tour found while branching, and with the proof of
+ * optimality (the cost of the tour as lower bound), and cancelling the monitor stops the call between two nodes of the
+ * branching (after the root LP) with the status {@code DISCORDE_STATUS_CANCELLED}. The time limit is then measured on
+ * the wall clock.
+ *
  * @param   n_nodes
  *          Number of nodes.
  * @param   n_edges
  *          Number of edges.
  * @param   edges
- *          An array of dimension {@code n_edges} by {@code 2}. It gives the edges in pair of nodes.
+ *          An unidimensional array of length {@code 2 * n_edges}. It gives the edges in pair of nodes like the original
+ *          API of Concorde, e.g., a list of three edges (a1, a2), (b1, b2), (c1, c2) is encoded as an array of six
+ *          elements given by {@code [a1, a2, b1, b2, c1, c2]}.
  * @param   edges_costs
  *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
  *          {@code edges} array.
+ * @param   monitor
+ *          The monitor of the call (see {@code discorde_monitor_create}). Its callback is fired on every new best tour
+ *          and cancelling it stops the call. It may be {@code NULL}.
  * @param   out_tour
  *          An array of length {@code n_nodes} to store the best tour found by the solver.
  * @param   out_cost
@@ -119,8 +433,8 @@ int concorde(int n_nodes, int n_edges, int *edges, int *edges_costs,
  *          at the end of the function may be: {@code DISCORDE_STATUS_OPTIMAL} if a tour has bee found and it is optimal;
  *          {@code DISCORDE_STATUS_TIMELIMIT} if the solver has stopped because the time limit has been reached;
  *          {@code DISCORDE_STATUS_TARGET} if the solver has stopped because a tour with cost equal or better than the
- *          {@code target} value has been found; or {@code DISCORDE_STATUS_UNKNOWN} if the solver has stopped
- *          unexpectedly.
+ *          {@code target} value has been found; {@code DISCORDE_STATUS_CANCELLED} if the monitor has been
+ *          cancelled; or {@code DISCORDE_STATUS_UNKNOWN} if the solver has stopped unexpectedly.
  * @param   in_tour
  *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
  *          {@code NULL} if no feasible tour is known.
@@ -136,9 +450,9 @@ int concorde(int n_nodes, int n_edges, int *edges, int *edges_costs,
  *
  * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
  */
-int concorde_sparse(int n_nodes, int n_edges, int **edges, int *edges_costs,
-                    int *out_tour, double *out_cost, int *out_status,
-                    int *in_tour, bool verbose, double *time_limit, double *target);
+int concorde_monitored(int n_nodes, int n_edges, int *edges, int *edges_costs, discorde_monitor *monitor,
+                       int *out_tour, double *out_cost, int *out_status,
+                       int *in_tour, bool verbose, double *time_limit, double *target);
 
 /**
  * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver. Concorde is a
@@ -146,9 +460,13 @@ int concorde_sparse(int n_nodes, int n_edges, int **edges, int *edges_costs,
  *
  * @param   n_nodes
  *          Number of nodes.
- * @param   cost_matrix
- *          An array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
- *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An array of dimension {@code n_edges} by {@code 2}. It gives the edges in pair of nodes.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
  * @param   out_tour
  *          An array of length {@code n_nodes} to store the best tour found by the solver.
  * @param   out_cost
@@ -177,30 +495,76 @@ int concorde_sparse(int n_nodes, int n_edges, int **edges, int *edges_costs,
  *
  * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
  */
-int concorde_full(int n_nodes, int **cost_matrix,
-                  int *out_tour, double *out_cost, int *out_status,
-                  int *in_tour, bool verbose, double *time_limit, double *target);
+int concorde_sparse(int n_nodes, int n_edges, int **edges, int *edges_costs,
+                    int *out_tour, double *out_cost, int *out_status,
+                    int *in_tour, bool verbose, double *time_limit, double *target);
 
 /**
- * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
- * implemented in Concorde library.
+ * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver. Concorde is a
+ * branch-and-cut based solver that solves a TSP instance to optimality, if no time limit or target is set.
+ *
+ * The edges of the graph handle are given to Concorde in place, without any copy.
+ *
+ * @param   graph
+ *          A graph handle created by {@code discorde_graph_strided} or {@code discorde_graph_csr}. Below,
+ *          {@code n_nodes} is the number of nodes of the graph.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, i.e, which stop criterion has been
+ *          activated. It may be set as {@code NULL} if this information is not desired. The values of {@code out_status}
+ *          at the end of the function may be: {@code DISCORDE_STATUS_OPTIMAL} if a tour has been found and it is
+ *          optimal; {@code DISCORDE_STATUS_TIMELIMIT} if the solver has stopped because the time limit has been
+ *          reached; {@code DISCORDE_STATUS_TARGET} if the solver has stopped because a tour with cost equal or better
+ *          than the {@code target} value has been found; or {@code DISCORDE_STATUS_UNKNOWN} if the solver has stopped
+ *          unexpectedly.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int concorde_graph(const discorde_graph *graph,
+                   int *out_tour, double *out_cost, int *out_status,
+                   int *in_tour, bool verbose, double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver. Concorde is a
+ * branch-and-cut based solver that solves a TSP instance to optimality, if no time limit or target is set.
+ *
+ * The cost matrix is given to Concorde as the oracle of edge lengths (matrix norm), not as a complete list of edges:
+ * the LP works on a sparse core of edges and the remaining ones are priced against the matrix on demand.
  *
  * @param   n_nodes
  *          Number of nodes.
- * @param   n_edges
- *          Number of edges.
- * @param   edges
- *          An unidimensional array of length {@code 2 * n_edges}. It gives the edges in pair of nodes like the original
- *          API of Concorde, e.g., a list of three edges (a1, a2), (b1, b2), (c1, c2) is encoded as an array of six
- *          elements given by {@code [a1, a2, b1, b2, c1, c2]}.
- * @param   edges_costs
- *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
- *          {@code edges} array.
+ * @param   cost_matrix
+ *          An array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
+ *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
  * @param   out_tour
  *          An array of length {@code n_nodes} to store the best tour found by the solver.
  * @param   out_cost
  *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
  *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, i.e, which stop criterion has been
+ *          activated. It may be set as {@code NULL} if this information is not desired. The values of {@code out_status}
+ *          at the end of the function may be: {@code DISCORDE_STATUS_OPTIMAL} if a tour has bee found and it is optimal;
+ *          {@code DISCORDE_STATUS_TIMELIMIT} if the solver has stopped because the time limit has been reached;
+ *          {@code DISCORDE_STATUS_TARGET} if the solver has stopped because a tour with cost equal or better than the
+ *          {@code target} value has been found; or {@code DISCORDE_STATUS_UNKNOWN} if the solver has stopped
+ *          unexpectedly.
  * @param   in_tour
  *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
  *          {@code NULL} if no feasible tour is known.
@@ -216,28 +580,45 @@ int concorde_full(int n_nodes, int **cost_matrix,
  *
  * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
  */
-int linkernighan(int n_nodes, int n_edges, int *edges, int *edges_costs,
-                 int *out_tour, double *out_cost, int *in_tour, bool verbose,
-                 double *time_limit, double *target);
+int concorde_full(int n_nodes, int **cost_matrix,
+                  int *out_tour, double *out_cost, int *out_status,
+                  int *in_tour, bool verbose, double *time_limit, double *target);
 
 /**
- * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
- * implemented in Concorde library.
+ * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver. Concorde is a
+ * branch-and-cut based solver that solves a TSP instance to optimality, if no time limit or target is set.
+ *
+ * The cost matrix is given to Concorde as the oracle of edge lengths (matrix norm), not as a complete list of edges:
+ * the LP works on a sparse core of edges and the remaining ones are priced against the matrix on demand.
+ *
+ * The call is monitored by {@code monitor}: above 12 nodes, the callback is fired with a Lin-Kernighan tour over the 10
+ * nearest neighbors of each node before Concorde starts, and then with the final tour (and its cost as lower bound if
+ * it is optimal). A cancellation during the heuristic returns its tour without starting Concorde. Concorde gives no
+ * intermediate tours and checks its time limit only between two nodes of its branch-and-bound, so a cancellation once
+ * it has started is only seen after its root LP, which may take most of the runtime of the call (and if the root LP
+ * proves the tour optimal, the call runs to its end). The status is then {@code DISCORDE_STATUS_CANCELLED}.
  *
  * @param   n_nodes
  *          Number of nodes.
- * @param   n_edges
- *          Number of edges.
- * @param   edges
- *          An array of dimension {@code n_edges} by {@code 2}. It gives the edges in pair of nodes.
- * @param   edges_costs
- *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
- *          {@code edges} array.
+ * @param   cost_matrix
+ *          An array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
+ *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
+ * @param   monitor
+ *          The monitor of the call (see {@code discorde_monitor_create}). Its callback is fired on every new best tour
+ *          and cancelling it stops the call. It may be {@code NULL}.
  * @param   out_tour
  *          An array of length {@code n_nodes} to store the best tour found by the solver.
  * @param   out_cost
  *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
  *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, i.e, which stop criterion has been
+ *          activated. It may be set as {@code NULL} if this information is not desired. The values of {@code out_status}
+ *          at the end of the function may be: {@code DISCORDE_STATUS_OPTIMAL} if a tour has bee found and it is optimal;
+ *          {@code DISCORDE_STATUS_TIMELIMIT} if the solver has stopped because the time limit has been reached;
+ *          {@code DISCORDE_STATUS_TARGET} if the solver has stopped because a tour with cost equal or better than the
+ *          {@code target} value has been found; {@code DISCORDE_STATUS_CANCELLED} if the monitor has been
+ *          cancelled; or {@code DISCORDE_STATUS_UNKNOWN} if the solver has stopped unexpectedly.
  * @param   in_tour
  *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
  *          {@code NULL} if no feasible tour is known.
@@ -253,19 +634,1114 @@ int linkernighan(int n_nodes, int n_edges, int *edges, int *edges_costs,
  *
  * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
  */
-int linkernighan_sparse(int n_nodes, int n_edges, int **edges, int *edges_costs,
-                        int *out_tour, double *out_cost, int *in_tour, bool verbose,
-                        double *time_limit, double *target);
+int concorde_full_monitored(int n_nodes, int **cost_matrix, discorde_monitor *monitor,
+                            int *out_tour, double *out_cost, int *out_status,
+                            int *in_tour, bool verbose, double *time_limit, double *target);
 
 /**
- * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
- * implemented in Concorde library.
+ * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver. Concorde is a
+ * branch-and-cut based solver that solves a TSP instance to optimality, if no time limit or target is set.
+ *
+ * The cost matrix is given to Concorde as the oracle of edge lengths (matrix norm), not as a complete list of edges:
+ * the LP works on a sparse core of edges and the remaining ones are priced against the matrix on demand.
  *
  * @param   n_nodes
  *          Number of nodes.
  * @param   cost_matrix
- *          A array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
- *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
+ *          A contiguous array of {@code n_nodes * n_nodes} elements in row-major order. Only its upper triangle is
+ *          read: the element {@code cost_matrix[i * n_nodes + j]}, with i less than j, is the cost (weight) of the
+ *          edges (i,j) and (j,i). It is read in place, i.e., no array of rows or list of edges is built from it.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, i.e, which stop criterion has been
+ *          activated. It may be set as {@code NULL} if this information is not desired. The values of {@code out_status}
+ *          at the end of the function may be: {@code DISCORDE_STATUS_OPTIMAL} if a tour has bee found and it is optimal;
+ *          {@code DISCORDE_STATUS_TIMELIMIT} if the solver has stopped because the time limit has been reached;
+ *          {@code DISCORDE_STATUS_TARGET} if the solver has stopped because a tour with cost equal or better than the
+ *          {@code target} value has been found; or {@code DISCORDE_STATUS_UNKNOWN} if the solver has stopped
+ *          unexpectedly.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int concorde_full_flat(int n_nodes, const int *cost_matrix,
+                       int *out_tour, double *out_cost, int *out_status,
+                       int *in_tour, bool verbose, double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver. Concorde is a
+ * branch-and-cut based solver that solves a TSP instance to optimality, if no time limit or target is set.
+ *
+ * The cost matrix is given to Concorde as the oracle of edge lengths (matrix norm), not as a complete list of edges:
+ * the LP works on a sparse core of edges and the remaining ones are priced against the matrix on demand.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          A contiguous array of {@code n_nodes * (n_nodes - 1) / 2} elements with the upper triangle of the cost
+ *          matrix packed row by row, i.e., the costs of edges (0,1), (0,2), ..., (0,n-1), (1,2), ..., (n-2,n-1). It is
+ *          read in place, i.e., no array of rows or list of edges is built from it.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, i.e, which stop criterion has been
+ *          activated. It may be set as {@code NULL} if this information is not desired. The values of {@code out_status}
+ *          at the end of the function may be: {@code DISCORDE_STATUS_OPTIMAL} if a tour has bee found and it is optimal;
+ *          {@code DISCORDE_STATUS_TIMELIMIT} if the solver has stopped because the time limit has been reached;
+ *          {@code DISCORDE_STATUS_TARGET} if the solver has stopped because a tour with cost equal or better than the
+ *          {@code target} value has been found; or {@code DISCORDE_STATUS_UNKNOWN} if the solver has stopped
+ *          unexpectedly.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int concorde_full_packed(int n_nodes, const int *cost_matrix,
+                         int *out_tour, double *out_cost, int *out_status,
+                         int *in_tour, bool verbose, double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver. Concorde is a
+ * branch-and-cut based solver that solves a TSP instance to optimality, if no time limit or target is set.
+ *
+ * The instance is given by the coordinates of its nodes and a norm, so the complete graph is never built: Concorde
+ * generates its own sparse set of edges and prices the remaining ones on demand. Memory usage is linear on the number
+ * of nodes.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   x
+ *          An array of length {@code n_nodes} with the x coordinate of each node. It is not copied.
+ * @param   y
+ *          An array of length {@code n_nodes} with the y coordinate of each node. It is not copied.
+ * @param   z
+ *          An array of length {@code n_nodes} with the z coordinate of each node. It is only used (and required) by
+ *          {@code DISCORDE_NORM_EUCLIDEAN_3D}, and it may be {@code NULL} for any other norm.
+ * @param   norm
+ *          The norm used to compute the distance between two nodes. It must be one of the {@code DISCORDE_NORM_*}
+ *          constants.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, i.e, which stop criterion has been
+ *          activated. It may be set as {@code NULL} if this information is not desired. The values of {@code out_status}
+ *          at the end of the function may be: {@code DISCORDE_STATUS_OPTIMAL} if a tour has been found and it is optimal;
+ *          {@code DISCORDE_STATUS_TIMELIMIT} if the solver has stopped because the time limit has been reached;
+ *          {@code DISCORDE_STATUS_TARGET} if the solver has stopped because a tour with cost equal or better than the
+ *          {@code target} value has been found; or {@code DISCORDE_STATUS_UNKNOWN} if the solver has stopped
+ *          unexpectedly.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int concorde_coords(int n_nodes, double *x, double *y, double *z, int norm,
+                    int *out_tour, double *out_cost, int *out_status,
+                    int *in_tour, bool verbose, double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) racing the Concorde solver against chains of
+ * the Lin-Kernighan heuristic (portfolio). The chains run on threads of their own, and Concorde starts on the calling
+ * thread as soon as they have found a first tour, which it takes as its starting tour and initial upper bound. The
+ * race ends as soon as Concorde returns (usually because it has proved the optimality of its tour), a chain reaches
+ * the target value or the time limit is reached, and the best tour of both sides is returned. Concorde takes its upper
+ * bound once, so the later tours of the chains do not prune its search, but they end the race if they reach the
+ * target. Unlike {@code concorde}, the time limit is measured on the wall clock.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges}. It gives the edges in pair of nodes like the original
+ *          API of Concorde, e.g., a list of three edges (a1, a2), (b1, b2), (c1, c2) is encoded as an array of six
+ *          elements given by {@code [a1, a2, b1, b2, c1, c2]}. The edges are also the candidate set of the chains.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
+ * @param   n_chains
+ *          Number of chains of the Lin-Kernighan heuristic, each one on its own thread. If it is zero (or negative), the
+ *          number of online processors minus one (at least one) is used, leaving a processor to Concorde.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, i.e, which stop criterion has been
+ *          activated. It may be set as {@code NULL} if this information is not desired. The values of {@code out_status}
+ *          at the end of the function may be: {@code DISCORDE_STATUS_OPTIMAL} if a tour has been found and it is optimal;
+ *          {@code DISCORDE_STATUS_TIMELIMIT} if the solver has stopped because the time limit has been reached;
+ *          {@code DISCORDE_STATUS_TARGET} if the solver has stopped because a tour with cost equal or better than the
+ *          {@code target} value has been found; or {@code DISCORDE_STATUS_UNKNOWN} if the solver has stopped
+ *          unexpectedly.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives the starting tour of the chains in (node, node, ..., node)
+ *          format. It may be {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log of Concorde is printed on the standard output. If {@code false}, the
+ *          progress log is not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed (wall-clock) time reaches {@code time_limit}
+ *          seconds. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          instance has too many edges for Concorde, {@code DISCORDE_RETURN_NO_MEMORY} if memory could not be
+ *          allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int concorde_portfolio(int n_nodes, int n_edges, int *edges, int *edges_costs, int n_chains,
+                       int *out_tour, double *out_cost, int *out_status,
+                       int *in_tour, bool verbose, double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) racing the Concorde solver against chains of
+ * the Lin-Kernighan heuristic (portfolio). The chains run on threads of their own, and Concorde starts on the calling
+ * thread as soon as they have found a first tour, which it takes as its starting tour and initial upper bound. The
+ * race ends as soon as Concorde returns (usually because it has proved the optimality of its tour), a chain reaches
+ * the target value or the time limit is reached, and the best tour of both sides is returned. Concorde takes its upper
+ * bound once, so the later tours of the chains do not prune its search, but they end the race if they reach the
+ * target. Unlike {@code concorde}, the time limit is measured on the wall clock.
+ *
+ * Concorde prices the edges against the cost matrix, as in {@code concorde_full}, and the chains use the complete
+ * graph as their candidate set, as in {@code linkernighan_full}.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          An array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
+ *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
+ * @param   n_chains
+ *          Number of chains of the Lin-Kernighan heuristic, each one on its own thread. If it is zero (or negative), the
+ *          number of online processors minus one (at least one) is used, leaving a processor to Concorde.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, i.e, which stop criterion has been
+ *          activated. It may be set as {@code NULL} if this information is not desired. The values of {@code out_status}
+ *          at the end of the function may be: {@code DISCORDE_STATUS_OPTIMAL} if a tour has been found and it is optimal;
+ *          {@code DISCORDE_STATUS_TIMELIMIT} if the solver has stopped because the time limit has been reached;
+ *          {@code DISCORDE_STATUS_TARGET} if the solver has stopped because a tour with cost equal or better than the
+ *          {@code target} value has been found; or {@code DISCORDE_STATUS_UNKNOWN} if the solver has stopped
+ *          unexpectedly.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives the starting tour of the chains in (node, node, ..., node)
+ *          format. It may be {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log of Concorde is printed on the standard output. If {@code false}, the
+ *          progress log is not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed (wall-clock) time reaches {@code time_limit}
+ *          seconds. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          instance has too many edges for Concorde, {@code DISCORDE_RETURN_NO_MEMORY} if memory could not be
+ *          allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int concorde_full_portfolio(int n_nodes, int **cost_matrix, int n_chains,
+                            int *out_tour, double *out_cost, int *out_status,
+                            int *in_tour, bool verbose, double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) racing the Concorde solver against chains of
+ * the Lin-Kernighan heuristic (portfolio). The chains run on threads of their own, and Concorde starts on the calling
+ * thread as soon as they have found a first tour, which it takes as its starting tour and initial upper bound. The
+ * race ends as soon as Concorde returns (usually because it has proved the optimality of its tour), a chain reaches
+ * the target value or the time limit is reached, and the best tour of both sides is returned. Concorde takes its upper
+ * bound once, so the later tours of the chains do not prune its search, but they end the race if they reach the
+ * target. Unlike {@code concorde}, the time limit is measured on the wall clock.
+ *
+ * Concorde generates its own sparse set of edges from the coordinates, as in {@code concorde_coords}, and the chains
+ * use the candidate set of {@code linkernighan_coords}.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   x
+ *          An array of length {@code n_nodes} with the x coordinate of each node. It is not copied.
+ * @param   y
+ *          An array of length {@code n_nodes} with the y coordinate of each node. It is not copied.
+ * @param   z
+ *          An array of length {@code n_nodes} with the z coordinate of each node. It is only used (and required) by
+ *          {@code DISCORDE_NORM_EUCLIDEAN_3D}, and it may be {@code NULL} for any other norm.
+ * @param   norm
+ *          The norm used to compute the distance between two nodes. It must be one of the {@code DISCORDE_NORM_*}
+ *          constants.
+ * @param   n_chains
+ *          Number of chains of the Lin-Kernighan heuristic, each one on its own thread. If it is zero (or negative), the
+ *          number of online processors minus one (at least one) is used, leaving a processor to Concorde.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, i.e, which stop criterion has been
+ *          activated. It may be set as {@code NULL} if this information is not desired. The values of {@code out_status}
+ *          at the end of the function may be: {@code DISCORDE_STATUS_OPTIMAL} if a tour has been found and it is optimal;
+ *          {@code DISCORDE_STATUS_TIMELIMIT} if the solver has stopped because the time limit has been reached;
+ *          {@code DISCORDE_STATUS_TARGET} if the solver has stopped because a tour with cost equal or better than the
+ *          {@code target} value has been found; or {@code DISCORDE_STATUS_UNKNOWN} if the solver has stopped
+ *          unexpectedly.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives the starting tour of the chains in (node, node, ..., node)
+ *          format. It may be {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log of Concorde is printed on the standard output. If {@code false}, the
+ *          progress log is not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed (wall-clock) time reaches {@code time_limit}
+ *          seconds. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          instance has too many edges for Concorde, {@code DISCORDE_RETURN_NO_MEMORY} if memory could not be
+ *          allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int concorde_coords_portfolio(int n_nodes, double *x, double *y, double *z, int norm, int n_chains,
+                              int *out_tour, double *out_cost, int *out_status,
+                              int *in_tour, bool verbose, double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) by branch-and-cut, as
+ * {@code concorde_pooled} does with a new pool, and saves a checkpoint of the call in {@code checkpoint_dir}: the
+ * initial Lin-Kernighan tour and every better tour found while branching are written to the file {@code checkpoint} of
+ * that directory, and the cut pool and the frontier of the branch-and-bound (the problem files of its active nodes,
+ * written by Concorde to the subdirectory {@code problems}, with their bounds) are saved after the root LP, every 30
+ * seconds while branching and when the call stops. Each file is written to a temporary file renamed over it, and both
+ * the file and the directory are synced to the disk, so a process killed or a machine crashed while writing leaves the
+ * previous checkpoint intact. The checkpoint is tied to the instance by its numbers of nodes and edges and a 64-bit
+ * fingerprint of its edges and costs, and a call interrupted at any time (e.g., by the eviction of its process) is
+ * continued by {@code concorde_resume}.
+ *
+ * The branch-and-bound runs best bound first, and the time limit is checked between its nodes. Once the tour is proven
+ * optimal, the frontier and the pool are removed and the checkpoint holds the optimal tour.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges}. It gives the edges in pair of nodes like the
+ *          original API of Concorde, e.g., a list of three edges (a1, a2), (b1, b2), (c1, c2) is encoded as an array
+ *          of six elements given by {@code [a1, a2, b1, b2, c1, c2]}. The edges are also the candidate set of the
+ *          Lin-Kernighan heuristic.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
+ * @param   checkpoint_dir
+ *          Path of an existing directory where the checkpoint is saved. A checkpoint of a previous call in it is
+ *          replaced.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, as in {@code concorde_portfolio}.
+ *          It may be set as {@code NULL} if this information is not desired.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives the starting tour of the Lin-Kernighan heuristic in (node,
+ *          node, ..., node) format. It may be {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log of Concorde is printed on the standard output. If {@code false}, the
+ *          progress log is not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed (wall-clock) time of this call reaches {@code
+ *          time_limit} seconds. The root LP always runs to its end, so it is only checked by the heuristic and between
+ *          the nodes of the branching. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than {@code
+ *          target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          instance has too many edges for Concorde, {@code DISCORDE_RETURN_NO_MEMORY} if memory could not be
+ *          allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise (including when {@code checkpoint_dir} is not a
+ *          writable directory). A failed write of the checkpoint does not stop the call.
+ */
+int concorde_checkpoint(int n_nodes, int n_edges, int *edges, int *edges_costs, const char *checkpoint_dir,
+                        int *out_tour, double *out_cost, int *out_status,
+                        int *in_tour, bool verbose, double *time_limit, double *target);
+
+/**
+ * This function continues a call of {@code concorde_checkpoint} from its checkpoint in {@code checkpoint_dir}, e.g.,
+ * after its process has been killed. The instance must be the same as in that call. The branch-and-bound resumes from
+ * its saved frontier with its saved cut pool, skipping the heuristic and the root LP, and keeps saving to the
+ * checkpoint, so a resumed call may be resumed again. If only the tour has been saved (the call was killed before the
+ * end of the root LP), the call starts over from that tour. If the tour of the checkpoint is optimal, it is returned at
+ * once.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges}. It gives the edges in pair of nodes like the
+ *          original API of Concorde, e.g., a list of three edges (a1, a2), (b1, b2), (c1, c2) is encoded as an array
+ *          of six elements given by {@code [a1, a2, b1, b2, c1, c2]}. The edges are also the candidate set of the
+ *          Lin-Kernighan heuristic.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
+ * @param   checkpoint_dir
+ *          Path of the directory where the checkpoint has been saved by {@code concorde_checkpoint}.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, as in {@code concorde_portfolio}.
+ *          It may be set as {@code NULL} if this information is not desired.
+ * @param   verbose
+ *          If {@code true}, the progress log of Concorde is printed on the standard output. If {@code false}, the
+ *          progress log is not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed (wall-clock) time of this call reaches {@code
+ *          time_limit} seconds. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than {@code
+ *          target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          instance has too many edges for Concorde, {@code DISCORDE_RETURN_NO_MEMORY} if memory could not be
+ *          allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise (including when there is no checkpoint of this
+ *          instance in {@code checkpoint_dir}).
+ */
+int concorde_resume(int n_nodes, int n_edges, int *edges, int *edges_costs, const char *checkpoint_dir,
+                    int *out_tour, double *out_cost, int *out_status,
+                    bool verbose, double *time_limit, double *target);
+
+/**
+ * Handle to a pool of cuts shared by the solves of a family of related instances, e.g., the same graph with costs
+ * perturbed through the day. Cuts are valid inequalities of the TSP polytope of the nodes whatever the costs, so the
+ * cuts found by a solve of {@code concorde_pooled} seed the root LP of the next one, which then skips most of the
+ * separation. A pool may be used by one call at a time and must be released with {@code discorde_cutpool_free}.
+ */
+typedef struct discorde_cutpool discorde_cutpool;
+
+/**
+ * Create an empty cut pool.
+ *
+ * @param   out_pool
+ *          A pointer to store the handle created. It is set to {@code NULL} on failure.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the pool has been created, or {@code DISCORDE_RETURN_NO_MEMORY} otherwise.
+ */
+int discorde_cutpool_create(discorde_cutpool **out_pool);
+
+/**
+ * Release a cut pool and the cuts it holds. It does nothing if {@code pool} is {@code NULL}.
+ *
+ * @param   pool
+ *          The pool to release.
+ */
+void discorde_cutpool_free(discorde_cutpool *pool);
+
+/**
+ * Return the number of cuts held by a cut pool.
+ *
+ * @param   pool
+ *          The pool to query.
+ */
+int discorde_cutpool_size(const discorde_cutpool *pool);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver, as
+ * {@code concorde} does, sharing the cuts of {@code pool} with the other instances of its family. The root LP starts
+ * from the cuts of the pool, priced on the new costs by Concorde while it separates, and the cuts of the final root LP
+ * are added to the pool. The initial upper bound is a Lin-Kernighan tour started from {@code in_tour}.
+ *
+ * The cuts of a pool refer to the nodes through the labelling of its first solve (the order of {@code in_tour}, if
+ * given), so every instance of a family must have the same nodes. A pool used with another number of nodes is emptied
+ * first. The edges may differ from solve to solve: a cut of a pool stays valid for any graph over the same nodes.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges}. It gives the edges in pair of nodes like the
+ *          original API of Concorde, e.g., a list of three edges (a1, a2), (b1, b2), (c1, c2) is encoded as an array
+ *          of six elements given by {@code [a1, a2, b1, b2, c1, c2]}.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
+ * @param   pool
+ *          The cut pool of the family of the instance (see {@code discorde_cutpool_create}).
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, as in {@code concorde}. It may be
+ *          set as {@code NULL} if this information is not desired.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL}, in which case the heuristic starts from the first tour of the family (or from the identity).
+ * @param   verbose
+ *          If {@code true}, the progress log of Concorde is printed on the standard output. If {@code false}, the
+ *          progress log is not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed (wall-clock) time reaches {@code time_limit}
+ *          seconds. The root LP always runs to its end, so it is only checked by the heuristic and between the nodes
+ *          of the branching. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than {@code
+ *          target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          instance has too many edges for Concorde, {@code DISCORDE_RETURN_NO_MEMORY} if memory could not be
+ *          allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int concorde_pooled(int n_nodes, int n_edges, int *edges, int *edges_costs, discorde_cutpool *pool,
+                    int *out_tour, double *out_cost, int *out_status,
+                    int *in_tour, bool verbose, double *time_limit, double *target);
+
+/**
+ * Handle to a live instance for incremental re-optimization (what-if analysis): a list of edges whose costs are
+ * updated in batches, e.g., when a road closes or traffic changes, and re-optimized after each batch. A re-optimization
+ * starts from the last tour as upper bound, and from the cuts of the previous solves (see {@code concorde_pooled}), so a
+ * small perturbation costs a fraction of a full solve. A handle may be used by one thread at a time and must be
+ * released with {@code discorde_reopt_free}.
+ */
+typedef struct discorde_reopt discorde_reopt;
+
+/**
+ * Create a live instance from a list of edges. The edges and their costs are copied into the handle.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges} with the endpoints of each edge, as in
+ *          {@code concorde}. The edges are referred to by their index in this list in later updates.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the initial costs (weights) of each edge, following the same
+ *          order in {@code edges} array.
+ * @param   out_reopt
+ *          A pointer to store the handle created. It is set to {@code NULL} on failure.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the handle has been created, {@code DISCORDE_RETURN_TOO_LARGE} if the instance
+ *          has too many edges for Concorde, or {@code DISCORDE_RETURN_NO_MEMORY} otherwise.
+ */
+int discorde_reopt_create(int n_nodes, int n_edges, const int *edges, const int *edges_costs,
+                          discorde_reopt **out_reopt);
+
+/**
+ * Release a live instance and everything it keeps. It does nothing if {@code reopt} is {@code NULL}.
+ *
+ * @param   reopt
+ *          The handle to release.
+ */
+void discorde_reopt_free(discorde_reopt *reopt);
+
+/**
+ * Update the costs of a batch of edges of a live instance. If the last tour is optimal and the batch only raises the
+ * costs of edges it does not use, the tour stays optimal and the next call of {@code discorde_reopt_solve} returns it
+ * at once.
+ *
+ * @param   reopt
+ *          The live instance to update.
+ * @param   n_updates
+ *          Number of edges updated.
+ * @param   edge_ids
+ *          An array of length {@code n_updates} with the index of each edge updated in the list given to
+ *          {@code discorde_reopt_create}.
+ * @param   new_costs
+ *          An array of length {@code n_updates} with the new cost of each edge updated.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the costs have been updated, or {@code DISCORDE_RETURN_FAILURE} if an index
+ *          is out of range (in which case no cost is updated).
+ */
+int discorde_reopt_update(discorde_reopt *reopt, int n_updates, const int *edge_ids, const int *new_costs);
+
+/**
+ * This function re-optimizes a live instance under its current costs using the Concorde solver. The first call solves
+ * it from scratch (as {@code concorde_pooled} does with a new pool); later calls start from the last tour and the
+ * cuts found so far.
+ *
+ * @param   reopt
+ *          The live instance to solve.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, as in {@code concorde}. It may be
+ *          set as {@code NULL} if this information is not desired.
+ * @param   verbose
+ *          If {@code true}, the progress log of Concorde is printed on the standard output. If {@code false}, the
+ *          progress log is not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed time reaches {@code time_limit} seconds, as in
+ *          {@code concorde_pooled}. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than {@code
+ *          target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_NO_MEMORY} if memory
+ *          could not be allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int discorde_reopt_solve(discorde_reopt *reopt, int *out_tour, double *out_cost, int *out_status,
+                         bool verbose, double *time_limit, double *target);
+
+/**
+ * Handle to a persistent result cache: a memory-mapped file of bounded size holding the results of past solves, keyed
+ * by a hash of the instance. Once the file is full, the oldest results are overwritten. The file may be shared by
+ * several processes (through file locks): its size is set by the process that creates it, and a process opening an
+ * existing cache keeps its size and layout, whatever size it asks for, so the file is never resized under the processes
+ * that have it mapped. A handle may be used by several threads at a time and must be released with
+ * {@code discorde_cache_close}.
+ */
+typedef struct discorde_cache discorde_cache;
+
+/**
+ * Open a result cache, creating its file if needed.
+ *
+ * @param   path
+ *          Path of the cache file.
+ * @param   max_bytes
+ *          Size of the cache file in bytes, at least 65536, used if the file is created. About one result per kilobyte
+ *          is indexed, and a result takes 56 bytes plus 4 bytes per node. An existing cache keeps its own size.
+ * @param   out_cache
+ *          A pointer to store the handle created. It is set to {@code NULL} on failure.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the cache has been opened, {@code DISCORDE_RETURN_NO_MEMORY} if memory could
+ *          not be allocated, or {@code DISCORDE_RETURN_FAILURE} if the size is too small, the file could not be
+ *          created or mapped, or it exists and is not a cache of this version.
+ */
+int discorde_cache_open(const char *path, size_t max_bytes, discorde_cache **out_cache);
+
+/**
+ * Close a result cache. The results stay in its file. It does nothing if {@code cache} is {@code NULL}.
+ *
+ * @param   cache
+ *          The handle to release.
+ */
+void discorde_cache_close(discorde_cache *cache);
+
+/**
+ * This function solves an instance given by a list of edges as {@code concorde}, through a result cache. The instance
+ * is looked up by a hash of its edges and costs, regardless of the order of the edges and of their endpoints. A cached
+ * result is returned at once if it is optimal, if its cost reaches {@code target}, or if it was stopped by a time limit
+ * at least as large as {@code time_limit}; otherwise the instance is solved and its result replaces the cached one.
+ * A cached tour is only returned if it visits every node once and its cost, recomputed on the instance, is the cached
+ * cost. Results stopped by a cancellation or an unknown event are not cached.
+ *
+ * @param   cache
+ *          The result cache (see {@code discorde_cache_open}).
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges}, as in {@code concorde}.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, as in {@code concorde}. A cached
+ *          result reused because it reaches the target has status {@code DISCORDE_STATUS_TARGET}. It may be set as
+ *          {@code NULL} if this information is not desired.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known. It is not part of the key.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than {@code
+ *          target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found or reused, or the error code of
+ *          {@code concorde} otherwise.
+ */
+int concorde_cached(discorde_cache *cache, int n_nodes, int n_edges, int *edges, int *edges_costs,
+                    int *out_tour, double *out_cost, int *out_status,
+                    int *in_tour, bool verbose, double *time_limit, double *target);
+
+/**
+ * This function solves an instance given by a cost matrix as {@code concorde_full}, through a result cache, as in
+ * {@code concorde_cached}. The instance is looked up by a hash of the upper triangle of the matrix.
+ *
+ * @param   cache
+ *          The result cache (see {@code discorde_cache_open}).
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          A array of dimension {@code n_nodes} by {@code n_nodes}, as in {@code concorde_full}.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable which indicates the solver status, as in {@code concorde_cached}. It
+ *          may be set as {@code NULL} if this information is not desired.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known. It is not part of the key.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than {@code
+ *          target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found or reused, or the error code of
+ *          {@code concorde_full} otherwise.
+ */
+int concorde_full_cached(discorde_cache *cache, int n_nodes, int **cost_matrix,
+                         int *out_tour, double *out_cost, int *out_status,
+                         int *in_tour, bool verbose, double *time_limit, double *target);
+
+/**
+ * This function computes a lower bound of the cost of the optimal tour of an instance, without solving it. Together
+ * with the cost of a tour found by {@code linkernighan}, it bounds how far that tour may be from optimal. The
+ * fractional 2-matching bound ({@code DISCORDE_BOUND_2MATCHING}) takes a fraction of the time of a Lin-Kernighan run.
+ * The bound of the root LP of Concorde ({@code DISCORDE_BOUND_ROOT_LP}), i.e., the cutting loop of {@code concorde}
+ * without any branching, is much tighter but slower; its LP is started from a Lin-Kernighan tour.
+ *
+ * @param   n_nodes
+ *          Number of nodes, at least 3.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges} with the endpoints of each edge, as in
+ *          {@code concorde}.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order
+ *          in {@code edges} array.
+ * @param   mode
+ *          The bound to compute: {@code DISCORDE_BOUND_2MATCHING} or {@code DISCORDE_BOUND_ROOT_LP}.
+ * @param   out_bound
+ *          A pointer to a {@code double} variable to store the lower bound.
+ * @param   out_x
+ *          An array of length {@code n_edges} to store the value (between 0 and 1) of each edge in the optimal
+ *          solution of the bound, i.e., the fractional x vector. It may be {@code NULL} if it is not desired.
+ * @param   out_time
+ *          A pointer to a {@code double} variable to store the elapsed time in seconds. It may be {@code NULL} if this
+ *          information is not desired.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the bound has been computed, {@code DISCORDE_RETURN_TOO_LARGE} if the instance
+ *          has too many edges for Concorde, {@code DISCORDE_RETURN_NO_MEMORY} if a buffer cannot be allocated, or
+ *          {@code DISCORDE_RETURN_FAILURE} otherwise (e.g., if the mode is unknown or the graph has no tour).
+ */
+int discorde_lower_bound(int n_nodes, int n_edges, int *edges, int *edges_costs, int mode,
+                         double *out_bound, double *out_x, double *out_time, bool verbose);
+
+/**
+ * This function computes a lower bound of the cost of the optimal tour of an instance given by a cost matrix, as
+ * {@code discorde_lower_bound}. The bound is computed over the 10 nearest neighbors of each node, and the remaining
+ * pairs of nodes are priced against the matrix, so the bound holds for the complete graph.
+ *
+ * @param   n_nodes
+ *          Number of nodes, at least 3.
+ * @param   cost_matrix
+ *          A array of dimension {@code n_nodes} by {@code n_nodes}, as in {@code concorde_full}.
+ * @param   mode
+ *          The bound to compute: {@code DISCORDE_BOUND_2MATCHING} or {@code DISCORDE_BOUND_ROOT_LP}.
+ * @param   out_bound
+ *          A pointer to a {@code double} variable to store the lower bound.
+ * @param   out_x
+ *          An array of length {@code n_nodes * (n_nodes - 1) / 2} to store the value of each pair of nodes in the
+ *          optimal solution of the bound, packed as the upper triangle of the matrix row by row (as taken by
+ *          {@code concorde_full_packed}). It may be {@code NULL} if it is not desired.
+ * @param   out_time
+ *          A pointer to a {@code double} variable to store the elapsed time in seconds. It may be {@code NULL} if this
+ *          information is not desired.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ *
+ * @return  The return code of {@code discorde_lower_bound}.
+ */
+int discorde_lower_bound_full(int n_nodes, int **cost_matrix, int mode,
+                              double *out_bound, double *out_x, double *out_time, bool verbose);
+
+/**
+ * This function computes the Held-Karp bound of an instance given by a cost matrix: the Lagrangian relaxation of the
+ * TSP over 1-trees (a spanning tree of the nodes but one, plus two edges of that node), whose node penalties are
+ * optimized by subgradient ascent. Unlike {@code discorde_lower_bound}, it needs no LP and no edge list, so it scales
+ * to large instances. As in LKH, the 1-trees of the ascent are built by Prim's algorithm over the 10 nearest neighbors
+ * of each node, and the penalties are updated in parallel; the first and the last 1-trees are built over the dense rows
+ * of the matrix, vectorized over each row, so the bound holds for the complete graph. At its optimum, the bound equals
+ * the bound of the subtour elimination LP.
+ *
+ * @param   n_nodes
+ *          Number of nodes, at least 3.
+ * @param   cost_matrix
+ *          A array of dimension {@code n_nodes} by {@code n_nodes}, as in {@code concorde_full}.
+ * @param   max_iterations
+ *          Maximum number of 1-trees built by the ascent. If it is not positive, the ascent runs until its step sizes
+ *          vanish (a few times the number of nodes, up to a few thousand 1-trees).
+ * @param   time_limit
+ *          Indicates that the ascent should stop as soon as the runtime reaches {@code time_limit} seconds (of
+ *          wall-clock time). It may be {@code NULL} if no time limit is desired.
+ * @param   out_bound
+ *          A pointer to a {@code double} variable to store the best bound found.
+ * @param   out_pi
+ *          An array of length {@code n_nodes} to store the node penalties of the best bound (the pi-values). It may be
+ *          {@code NULL} if they are not desired.
+ * @param   out_time
+ *          A pointer to a {@code double} variable to store the elapsed time in seconds. It may be {@code NULL} if this
+ *          information is not desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the bound has been computed, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          instance has too many nodes, {@code DISCORDE_RETURN_NO_MEMORY} if a buffer cannot be allocated, or
+ *          {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int discorde_held_karp_full(int n_nodes, int **cost_matrix, int max_iterations, double *time_limit,
+                            double *out_bound, double *out_pi, double *out_time);
+
+/**
+ * This function computes the Held-Karp bound of an instance given by a cost matrix stored in a contiguous buffer, as
+ * {@code discorde_held_karp_full}.
+ *
+ * @param   n_nodes
+ *          Number of nodes, at least 3.
+ * @param   cost_matrix
+ *          A contiguous row-major buffer of {@code n_nodes * n_nodes} entries, as in {@code concorde_full_flat}.
+ * @param   max_iterations
+ *          Maximum number of 1-trees built by the ascent, as in {@code discorde_held_karp_full}.
+ * @param   time_limit
+ *          Indicates that the ascent should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   out_bound
+ *          A pointer to a {@code double} variable to store the best bound found.
+ * @param   out_pi
+ *          An array of length {@code n_nodes} to store the node penalties of the best bound. It may be {@code NULL}.
+ * @param   out_time
+ *          A pointer to a {@code double} variable to store the elapsed time in seconds. It may be {@code NULL}.
+ *
+ * @return  The return code of {@code discorde_held_karp_full}.
+ */
+int discorde_held_karp_full_flat(int n_nodes, const int *cost_matrix, int max_iterations, double *time_limit,
+                                 double *out_bound, double *out_pi, double *out_time);
+
+/**
+ * This function computes the Held-Karp bound of an instance given by the coordinates of its nodes, as
+ * {@code discorde_held_karp_full}. The ascent runs over the candidate edges of {@code linkernighan}, and the distances
+ * of the dense 1-trees are computed row by row, so no matrix is stored; the Euclidean, maximum and Manhattan norms
+ * are computed by kernels vectorized over each row.
+ *
+ * @param   n_nodes
+ *          Number of nodes, at least 3.
+ * @param   x
+ *          An array of length {@code n_nodes} with the x coordinate of each node. It is not copied.
+ * @param   y
+ *          An array of length {@code n_nodes} with the y coordinate of each node. It is not copied.
+ * @param   z
+ *          An array of length {@code n_nodes} with the z coordinate of each node. It is only used (and required) by
+ *          {@code DISCORDE_NORM_EUCLIDEAN_3D}, and it may be {@code NULL} for any other norm.
+ * @param   norm
+ *          The norm used to compute the distance between two nodes. It must be one of the {@code DISCORDE_NORM_*}
+ *          constants.
+ * @param   max_iterations
+ *          Maximum number of 1-trees built by the ascent, as in {@code discorde_held_karp_full}.
+ * @param   time_limit
+ *          Indicates that the ascent should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   out_bound
+ *          A pointer to a {@code double} variable to store the best bound found.
+ * @param   out_pi
+ *          An array of length {@code n_nodes} to store the node penalties of the best bound. It may be {@code NULL}.
+ * @param   out_time
+ *          A pointer to a {@code double} variable to store the elapsed time in seconds. It may be {@code NULL}.
+ *
+ * @return  The return code of {@code discorde_held_karp_full}. {@code DISCORDE_RETURN_FAILURE} is also returned if
+ *          the norm is unknown or a required coordinate array is {@code NULL}.
+ */
+int discorde_held_karp_coords(int n_nodes, double *x, double *y, double *z, int norm, int max_iterations,
+                              double *time_limit, double *out_bound, double *out_pi, double *out_time);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges}. It gives the edges in pair of nodes like the original
+ *          API of Concorde, e.g., a list of three edges (a1, a2), (b1, b2), (c1, c2) is encoded as an array of six
+ *          elements given by {@code [a1, a2, b1, b2, c1, c2]}.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan(int n_nodes, int n_edges, int *edges, int *edges_costs,
+                 int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                 double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * The call is monitored by {@code monitor}: the heuristic runs in rounds of kicks (a tenth of the number of nodes,
+ * between 100 and 10000), the callback is fired after each round that improves the best tour, and cancelling the
+ * monitor stops the heuristic at the end of the current round. The time limit is measured on the wall clock and,
+ * without a time limit, the heuristic performs as many kicks as nodes.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges}. It gives the edges in pair of nodes like the original
+ *          API of Concorde, e.g., a list of three edges (a1, a2), (b1, b2), (c1, c2) is encoded as an array of six
+ *          elements given by {@code [a1, a2, b1, b2, c1, c2]}.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
+ * @param   monitor
+ *          The monitor of the call (see {@code discorde_monitor_create}). Its callback is fired on every new best tour
+ *          and cancelling it stops the call. It may be {@code NULL}.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed (wall-clock) time reaches {@code time_limit}
+ *          seconds. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_monitored(int n_nodes, int n_edges, int *edges, int *edges_costs, discorde_monitor *monitor,
+                           int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                           double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) running several independent chains of the
+ * Lin-Kernighan heuristic at once (multi-start), each one with its own seed and kick type, and keeps the best tour
+ * found. All chains stop as soon as one of them reaches the target value or the time limit is reached. Unlike the
+ * single-chain functions, the time limit is measured on the wall clock. Without a time limit, each chain performs as
+ * many kicks as nodes.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges}. It gives the edges in pair of nodes like the original
+ *          API of Concorde, e.g., a list of three edges (a1, a2), (b1, b2), (c1, c2) is encoded as an array of six
+ *          elements given by {@code [a1, a2, b1, b2, c1, c2]}.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
+ * @param   n_chains
+ *          Number of chains run at once, each one on its own thread. If it is zero (or negative), the number of online
+ *          processors is used.
+ * @param   seeds
+ *          An array of length {@code n_chains} with the seed of the random number generator of each chain. It may be
+ *          {@code NULL}, in which case distinct seeds are chosen.
+ * @param   kick_types
+ *          An array of length {@code n_chains} with the kick type ({@code DISCORDE_KICK_*}) of each chain. It may be
+ *          {@code NULL}, in which case the chains use the random walk, random, close and (for coordinates only)
+ *          geometric kicks in turn.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives the starting tour of every chain in (node, node, ..., node)
+ *          format. It may be {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log of the first chain is printed on the standard output. If {@code false},
+ *          the progress log is not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed (wall-clock) time reaches {@code time_limit}
+ *          seconds. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_multistart(int n_nodes, int n_edges, int *edges, int *edges_costs,
+                            int n_chains, const int *seeds, const int *kick_types,
+                            int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                            double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An array of dimension {@code n_edges} by {@code 2}. It gives the edges in pair of nodes.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_sparse(int n_nodes, int n_edges, int **edges, int *edges_costs,
+                        int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                        double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * The edges of the graph handle are used in place as the candidate set. The lookup structure of edge lengths is built
+ * on the first call and kept by the handle for later calls.
+ *
+ * @param   graph
+ *          A graph handle created by {@code discorde_graph_strided} or {@code discorde_graph_csr}. Below,
+ *          {@code n_nodes} is the number of nodes of the graph.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_graph(const discorde_graph *graph,
+                       int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                       double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          A array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
+ *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
  * @param   out_tour
  *          An array of length {@code n_nodes} to store the best tour found by the solver.
  * @param   out_cost
@@ -290,6 +1766,856 @@ int linkernighan_full(int n_nodes, int **cost_matrix,
                       int *out_tour, double *out_cost, int *in_tour, bool verbose,
                       double *time_limit, double *target);
 
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * The call is monitored by {@code monitor}: the heuristic runs in rounds of kicks (a tenth of the number of nodes,
+ * between 100 and 10000), the callback is fired after each round that improves the best tour, and cancelling the
+ * monitor stops the heuristic at the end of the current round. The time limit is measured on the wall clock and,
+ * without a time limit, the heuristic performs as many kicks as nodes.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          A array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
+ *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
+ * @param   monitor
+ *          The monitor of the call (see {@code discorde_monitor_create}). Its callback is fired on every new best tour
+ *          and cancelling it stops the call. It may be {@code NULL}.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed (wall-clock) time reaches {@code time_limit}
+ *          seconds. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_full_monitored(int n_nodes, int **cost_matrix, discorde_monitor *monitor,
+                                int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                                double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          A contiguous array of {@code n_nodes * n_nodes} elements in row-major order. Only its upper triangle is
+ *          read: the element {@code cost_matrix[i * n_nodes + j]}, with i less than j, is the cost (weight) of the
+ *          edges (i,j) and (j,i). It is read in place, i.e., no array of rows or list of edges is built from it.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_full_flat(int n_nodes, const int *cost_matrix,
+                           int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                           double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          A contiguous array of {@code n_nodes * (n_nodes - 1) / 2} elements with the upper triangle of the cost
+ *          matrix packed row by row, i.e., the costs of edges (0,1), (0,2), ..., (0,n-1), (1,2), ..., (n-2,n-1). It is
+ *          read in place, i.e., no array of rows or list of edges is built from it.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_full_packed(int n_nodes, const int *cost_matrix,
+                             int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                             double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * Unlike {@code linkernighan_full}, the candidate set of the heuristic is not the complete graph but the union of the
+ * {@code k_nearest} cheapest edges incident to each node, found by a parallel partial sort over the rows of the cost
+ * matrix. The full matrix is still used for the exact length of any edge, but the neighborhood scans of the heuristic
+ * cost O(k) per node instead of O(n_nodes).
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          An array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
+ *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
+ * @param   k_nearest
+ *          Number of nearest neighbors of each node included in the candidate set. If it is not positive, 10 nearest
+ *          neighbors are used.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_full_knn(int n_nodes, int **cost_matrix, int k_nearest,
+                          int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                          double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * Unlike {@code linkernighan_full_knn}, the candidate set of the heuristic is the union of the {@code k_alpha}
+ * alpha-nearest neighbors of each node, as in LKH. The alpha-value of an edge is the increase of the cost of the
+ * minimum 1-tree when it is forced to hold the edge, under the node penalties of the Held-Karp ascent (see
+ * {@code discorde_held_karp_full}). Edges of optimal tours have small alpha-values much more often than they are among
+ * the nearest ones, so fewer candidates per node are needed, notably on clustered and non-Euclidean instances. The
+ * ascent and the alpha-values take O(n_nodes^2) time before the heuristic starts.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          An array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
+ *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
+ * @param   k_alpha
+ *          Number of alpha-nearest neighbors of each node included in the candidate set. If it is not positive, 5
+ *          neighbors are used, as in LKH.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds, including
+ *          the Held-Karp ascent. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          candidate set has too many edges, {@code DISCORDE_RETURN_NO_MEMORY} if a buffer cannot be allocated, or
+ *          {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_full_alpha(int n_nodes, int **cost_matrix, int k_alpha,
+                            int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                            double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * The instance is given by the coordinates of its nodes and a norm, so the complete graph is never built: the
+ * heuristic works on a sparse set of candidate edges (quadrant neighbors or nearest neighbors, depending on the norm)
+ * and computes the remaining lengths on demand. Memory usage is linear on the number of nodes.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   x
+ *          An array of length {@code n_nodes} with the x coordinate of each node. It is not copied.
+ * @param   y
+ *          An array of length {@code n_nodes} with the y coordinate of each node. It is not copied.
+ * @param   z
+ *          An array of length {@code n_nodes} with the z coordinate of each node. It is only used (and required) by
+ *          {@code DISCORDE_NORM_EUCLIDEAN_3D}, and it may be {@code NULL} for any other norm.
+ * @param   norm
+ *          The norm used to compute the distance between two nodes. It must be one of the {@code DISCORDE_NORM_*}
+ *          constants.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds. It may be
+ *          {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_coords(int n_nodes, double *x, double *y, double *z, int norm,
+                        int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                        double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic
+ * implemented in Concorde library.
+ *
+ * The instance is given by the coordinates of its nodes and a norm, as in {@code linkernighan_coords}, but the
+ * candidate set of the heuristic is the union of the {@code k_alpha} alpha-nearest neighbors of each node (see
+ * {@code linkernighan_full_alpha}). The distances are computed row by row, so memory usage is still linear on the
+ * number of nodes.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   x
+ *          An array of length {@code n_nodes} with the x coordinate of each node. It is not copied.
+ * @param   y
+ *          An array of length {@code n_nodes} with the y coordinate of each node. It is not copied.
+ * @param   z
+ *          An array of length {@code n_nodes} with the z coordinate of each node. It is only used (and required) by
+ *          {@code DISCORDE_NORM_EUCLIDEAN_3D}, and it may be {@code NULL} for any other norm.
+ * @param   norm
+ *          The norm used to compute the distance between two nodes. It must be one of the {@code DISCORDE_NORM_*}
+ *          constants.
+ * @param   k_alpha
+ *          Number of alpha-nearest neighbors of each node included in the candidate set. If it is not positive, 5
+ *          neighbors are used, as in LKH.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output. If {@code false}, the progress log is
+ *          not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the runtime reaches {@code time_limit} seconds, including
+ *          the Held-Karp ascent. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          candidate set has too many edges, {@code DISCORDE_RETURN_NO_MEMORY} if a buffer cannot be allocated, or
+ *          {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_coords_alpha(int n_nodes, double *x, double *y, double *z, int norm, int k_alpha,
+                              int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                              double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) running several independent chains of the
+ * Lin-Kernighan heuristic at once (multi-start), each one with its own seed and kick type, and keeps the best tour
+ * found. All chains stop as soon as one of them reaches the target value or the time limit is reached. Unlike the
+ * single-chain functions, the time limit is measured on the wall clock. Without a time limit, each chain performs as
+ * many kicks as nodes.
+ *
+ * The lengths are queried from the cost matrix. The candidate set is the complete graph if {@code k_nearest} is zero,
+ * or the k nearest neighbors of each node otherwise (see {@code linkernighan_full_knn}).
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          An array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
+ *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
+ * @param   k_nearest
+ *          Number of nearest neighbors of each node in the candidate set, or zero for the complete graph.
+ * @param   n_chains
+ *          Number of chains run at once, each one on its own thread. If it is zero (or negative), the number of online
+ *          processors is used.
+ * @param   seeds
+ *          An array of length {@code n_chains} with the seed of the random number generator of each chain. It may be
+ *          {@code NULL}, in which case distinct seeds are chosen.
+ * @param   kick_types
+ *          An array of length {@code n_chains} with the kick type ({@code DISCORDE_KICK_*}) of each chain. It may be
+ *          {@code NULL}, in which case the chains use the random walk, random, close and (for coordinates only)
+ *          geometric kicks in turn.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives the starting tour of every chain in (node, node, ..., node)
+ *          format. It may be {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log of the first chain is printed on the standard output. If {@code false},
+ *          the progress log is not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed (wall-clock) time reaches {@code time_limit}
+ *          seconds. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_full_multistart(int n_nodes, int **cost_matrix, int k_nearest,
+                                 int n_chains, const int *seeds, const int *kick_types,
+                                 int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                                 double *time_limit, double *target);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) running several independent chains of the
+ * Lin-Kernighan heuristic at once (multi-start), each one with its own seed and kick type, and keeps the best tour
+ * found. All chains stop as soon as one of them reaches the target value or the time limit is reached. Unlike the
+ * single-chain functions, the time limit is measured on the wall clock. Without a time limit, each chain performs as
+ * many kicks as nodes.
+ *
+ * The candidate set is generated by Concorde from the coordinates, as in {@code linkernighan_coords}.
+ *
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   x
+ *          An array of length {@code n_nodes} with the x coordinate of each node. It is not copied.
+ * @param   y
+ *          An array of length {@code n_nodes} with the y coordinate of each node. It is not copied.
+ * @param   z
+ *          An array of length {@code n_nodes} with the z coordinate of each node. It is only used (and required) by
+ *          {@code DISCORDE_NORM_EUCLIDEAN_3D}, and it may be {@code NULL} for any other norm.
+ * @param   norm
+ *          The norm used to compute the distance between two nodes. It must be one of the {@code DISCORDE_NORM_*}
+ *          constants.
+ * @param   n_chains
+ *          Number of chains run at once, each one on its own thread. If it is zero (or negative), the number of online
+ *          processors is used.
+ * @param   seeds
+ *          An array of length {@code n_chains} with the seed of the random number generator of each chain. It may be
+ *          {@code NULL}, in which case distinct seeds are chosen.
+ * @param   kick_types
+ *          An array of length {@code n_chains} with the kick type ({@code DISCORDE_KICK_*}) of each chain. It may be
+ *          {@code NULL}, in which case the chains use the random walk, random, close and (for coordinates only)
+ *          geometric kicks in turn.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives the starting tour of every chain in (node, node, ..., node)
+ *          format. It may be {@code NULL} if no feasible tour is known.
+ * @param   verbose
+ *          If {@code true}, the progress log of the first chain is printed on the standard output. If {@code false},
+ *          the progress log is not printed.
+ * @param   time_limit
+ *          Indicates that the solver should stop as soon as the elapsed (wall-clock) time reaches {@code time_limit}
+ *          seconds. It may be {@code NULL} if no time limit is desired.
+ * @param   target
+ *          Indicates that the solver should stop as soon as it finds a tour with cost equal or better than
+ *          {@code target} value. It may be {@code NULL} if no target value is desired.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int linkernighan_coords_multistart(int n_nodes, double *x, double *y, double *z, int norm,
+                                   int n_chains, const int *seeds, const int *kick_types,
+                                   int *out_tour, double *out_cost, int *in_tour, bool verbose,
+                                   double *time_limit, double *target);
+
+/**
+ * Handle to a dynamic tour: a tour over a subset of the nodes of a cost matrix, kept up to date as nodes are inserted
+ * and removed (e.g., stops added and cancelled through the day) without solving the instance again. Each insertion goes
+ * to the cheapest position among the edges of the tour at the nearest neighbors of the node, and each change is
+ * followed by a bounded repair: the Lin-Kernighan heuristic re-optimizes a window of the tour around the change, over
+ * the nearest neighbors of its nodes that lie in the window. A handle may be used by one thread at a time and must be
+ * released with {@code discorde_dyntour_free}.
+ */
+typedef struct discorde_dyntour discorde_dyntour;
+
+/**
+ * Create a dynamic tour seeded from an existing tour. The k nearest neighbors of every node of the matrix are found
+ * once, by a parallel partial sort of its rows.
+ *
+ * @param   n_nodes
+ *          Number of nodes of the matrix, i.e., of the nodes that may be in the tour.
+ * @param   cost_matrix
+ *          A array of dimension {@code n_nodes} by {@code n_nodes}, as in {@code linkernighan_full}. It is borrowed by
+ *          the handle, so it must stay valid (and unchanged) until the handle is released.
+ * @param   tour_length
+ *          Number of nodes of the initial tour. It may be zero.
+ * @param   tour
+ *          An array of length {@code tour_length} with the initial tour in (node, node, ..., node) format. Its nodes
+ *          must be distinct.
+ * @param   k_nearest
+ *          Number of nearest neighbors of each node, at least 1.
+ * @param   repair_radius
+ *          Number of nodes re-optimized on each side of a change (at most 256). Repairs need windows of at least 8
+ *          nodes, so a radius below 4 disables them unless the whole tour is short enough to be re-optimized.
+ * @param   out_dyntour
+ *          A pointer to store the handle created. It is set to {@code NULL} on failure.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the handle has been created, {@code DISCORDE_RETURN_NO_MEMORY} if memory could
+ *          not be allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise (including when the tour is not valid).
+ */
+int discorde_dyntour_create(int n_nodes, int **cost_matrix, int tour_length, const int *tour, int k_nearest,
+                            int repair_radius, discorde_dyntour **out_dyntour);
+
+/**
+ * Release a dynamic tour. The cost matrix is not released. It does nothing if {@code dyntour} is {@code NULL}.
+ *
+ * @param   dyntour
+ *          The handle to release.
+ */
+void discorde_dyntour_free(discorde_dyntour *dyntour);
+
+/**
+ * Insert a batch of nodes into a dynamic tour. Each node goes to its cheapest position, and the tour is repaired
+ * around it before the next one is inserted.
+ *
+ * @param   dyntour
+ *          The tour to update.
+ * @param   n_insert
+ *          Number of nodes to insert.
+ * @param   nodes
+ *          An array of length {@code n_insert} with the nodes to insert. They must be distinct and out of the tour.
+ * @param   regret
+ *          If {@code false}, the nodes are inserted in the order given (cheapest insertion). If {@code true}, the next
+ *          node inserted is the one with the largest gap between the costs of its two cheapest positions (regret
+ *          insertion).
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the nodes have been inserted, {@code DISCORDE_RETURN_NO_MEMORY} if memory
+ *          could not be allocated, or {@code DISCORDE_RETURN_FAILURE} if a node is out of range, already in the tour
+ *          or given twice (in which case no node is inserted).
+ */
+int discorde_dyntour_insert(discorde_dyntour *dyntour, int n_insert, const int *nodes, bool regret);
+
+/**
+ * Remove a node from a dynamic tour, joining its two neighbors in the tour, and repair the tour around them.
+ *
+ * @param   dyntour
+ *          The tour to update.
+ * @param   node
+ *          The node to remove.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the node has been removed, or {@code DISCORDE_RETURN_FAILURE} if it is not in
+ *          the tour.
+ */
+int discorde_dyntour_remove(discorde_dyntour *dyntour, int node);
+
+/**
+ * Return the number of nodes of a dynamic tour.
+ *
+ * @param   dyntour
+ *          The tour to query.
+ */
+int discorde_dyntour_length(const discorde_dyntour *dyntour);
+
+/**
+ * Copy a dynamic tour and its cost.
+ *
+ * @param   dyntour
+ *          The tour to query.
+ * @param   out_tour
+ *          An array of length {@code discorde_dyntour_length(dyntour)} to store the tour in (node, node, ..., node)
+ *          format.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the tour.
+ */
+void discorde_dyntour_get(const discorde_dyntour *dyntour, int *out_tour, double *out_cost);
+
+/**
+ * Handle to a warm-start store: the last tour of a family of instances (e.g., the same routing problem day after day),
+ * kept as a sequence of node IDs given by the caller instead of node indices. When the node set changes, the tour is
+ * projected onto the new one, so it can be passed as {@code in_tour} to any solver of this library. A store may be used
+ * by one thread at a time and must be released with {@code discorde_warmstore_free}.
+ */
+typedef struct discorde_warmstore discorde_warmstore;
+
+/**
+ * Create an empty warm-start store.
+ *
+ * @param   out_store
+ *          A pointer to store the handle created. It is set to {@code NULL} on failure.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the store has been created, or {@code DISCORDE_RETURN_NO_MEMORY} if memory
+ *          could not be allocated.
+ */
+int discorde_warmstore_create(discorde_warmstore **out_store);
+
+/**
+ * Release a warm-start store. It does nothing if {@code store} is {@code NULL}.
+ *
+ * @param   store
+ *          The handle to release.
+ */
+void discorde_warmstore_free(discorde_warmstore *store);
+
+/**
+ * Save a tour into a warm-start store, replacing the tour saved before.
+ *
+ * @param   store
+ *          The store to update.
+ * @param   n_nodes
+ *          Number of nodes of the instance.
+ * @param   node_ids
+ *          An array of length {@code n_nodes} with the ID of each node of the instance. The IDs must be distinct.
+ * @param   tour
+ *          An array of length {@code n_nodes} with the tour in (node, node, ..., node) format, e.g., the
+ *          {@code out_tour} of a solver.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the tour has been saved, or {@code DISCORDE_RETURN_NO_MEMORY} if memory could
+ *          not be allocated (in which case the previous tour is kept).
+ */
+int discorde_warmstore_save(discorde_warmstore *store, int n_nodes, const long *node_ids, const int *tour);
+
+/**
+ * Project the tour of a warm-start store onto a new instance given as a list of edges. The nodes of the saved tour that
+ * are still in the instance keep their order, the nodes that are gone are dropped, and each new node is inserted at
+ * the cheapest position of the tour built so far (missing edges counting as longer than any tour over the list). The
+ * result is meant to be passed as {@code in_tour} to {@code concorde} or {@code linkernighan}.
+ *
+ * @param   store
+ *          The store to read.
+ * @param   n_nodes
+ *          Number of nodes of the new instance.
+ * @param   node_ids
+ *          An array of length {@code n_nodes} with the ID of each node of the new instance. The IDs must be distinct.
+ * @param   n_edges
+ *          Number of edges of the new instance.
+ * @param   edges
+ *          An array of dimension {@code n_edges} by 2 in (node, node, node, node, ...) format, as in {@code concorde}.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} with the costs of the edges.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the projected tour in (node, node, ..., node) format.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the tour has been projected, {@code DISCORDE_RETURN_NO_MEMORY} if memory could
+ *          not be allocated, {@code DISCORDE_RETURN_TOO_LARGE} if there are too many edges, or
+ *          {@code DISCORDE_RETURN_FAILURE} if the store is empty or the IDs are not distinct.
+ */
+int discorde_warmstore_project(const discorde_warmstore *store, int n_nodes, const long *node_ids, int n_edges,
+                               int *edges, int *edges_costs, int *out_tour);
+
+/**
+ * Project the tour of a warm-start store onto a new instance given as a cost matrix, as in
+ * {@code discorde_warmstore_project}. The result is meant to be passed as {@code in_tour} to {@code concorde_full} or
+ * {@code linkernighan_full}.
+ *
+ * @param   store
+ *          The store to read.
+ * @param   n_nodes
+ *          Number of nodes of the new instance.
+ * @param   node_ids
+ *          An array of length {@code n_nodes} with the ID of each node of the new instance. The IDs must be distinct.
+ * @param   cost_matrix
+ *          A array of dimension {@code n_nodes} by {@code n_nodes}, as in {@code concorde_full}.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the projected tour in (node, node, ..., node) format.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the tour has been projected, {@code DISCORDE_RETURN_NO_MEMORY} if memory could
+ *          not be allocated, or {@code DISCORDE_RETURN_FAILURE} if the store is empty or the IDs are not distinct.
+ */
+int discorde_warmstore_project_full(const discorde_warmstore *store, int n_nodes, const long *node_ids,
+                                    int **cost_matrix, int *out_tour);
+
+/**
+ * Handle to a reusable solver context: the options of the solver, its random state and the datagroups and edge lists
+ * built for the last instance solved. A call over a cost matrix of the same size, or over the same list of edges, as
+ * the previous call of the same kind only copies the new costs into the datagroup already built, so re-solving an
+ * instance with tweaked costs allocates nothing in the context. A context may be used by one thread at a time and must
+ * be released with {@code discorde_context_free}.
+ */
+typedef struct discorde_context discorde_context;
+
+/**
+ * Create a solver context with default options: not verbose, no time limit, no target and a random state seeded from
+ * the process id and a per-process call counter.
+ *
+ * @param   out_context
+ *          A pointer to store the handle created. It is set to {@code NULL} on failure.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if the context has been created, or {@code DISCORDE_RETURN_NO_MEMORY} otherwise.
+ */
+int discorde_context_create(discorde_context **out_context);
+
+/**
+ * Release a solver context and the buffers it owns. It does nothing if {@code context} is {@code NULL}.
+ *
+ * @param   context
+ *          The context to release.
+ */
+void discorde_context_free(discorde_context *context);
+
+/**
+ * Set whether the solver calls of a context print their progress log on the standard output.
+ *
+ * @param   context
+ *          The context to update.
+ * @param   verbose
+ *          If {@code true}, the progress log is printed on the standard output.
+ */
+void discorde_context_set_verbose(discorde_context *context, bool verbose);
+
+/**
+ * Set the time limit of the solver calls of a context.
+ *
+ * @param   context
+ *          The context to update.
+ * @param   time_limit
+ *          Time limit in seconds, copied into the context. It may be {@code NULL} if no time limit is desired.
+ */
+void discorde_context_set_time_limit(discorde_context *context, const double *time_limit);
+
+/**
+ * Set the target of the solver calls of a context.
+ *
+ * @param   context
+ *          The context to update.
+ * @param   target
+ *          Target cost, copied into the context. It may be {@code NULL} if no target value is desired.
+ */
+void discorde_context_set_target(discorde_context *context, const double *target);
+
+/**
+ * Seed the random state of a context. The random state carries over from call to call, so a sequence of calls after
+ * the same seed gives the same tours.
+ *
+ * @param   context
+ *          The context to update.
+ * @param   seed
+ *          Seed of the random state.
+ */
+void discorde_context_set_seed(discorde_context *context, int seed);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver, as
+ * {@code concorde} does, with the options and the random state of a context.
+ *
+ * @param   context
+ *          The context of the call (see {@code discorde_context_create}).
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges} with the endpoints of each edge, as in
+ *          {@code concorde}.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable to store the solver status. See the status constants above.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          instance has more edges than Concorde can index, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int discorde_context_concorde(discorde_context *context, int n_nodes, int n_edges, int *edges, int *edges_costs,
+                              int *out_tour, double *out_cost, int *out_status, int *in_tour);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Concorde solver, as
+ * {@code concorde_full} does, with the options and the random state of a context. The matrix norm datagroup of the
+ * context is allocated again only if {@code n_nodes} differs from the previous call.
+ *
+ * @param   context
+ *          The context of the call (see {@code discorde_context_create}).
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          A array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
+ *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   out_status
+ *          A pointer to an {@code int} variable to store the solver status. See the status constants above.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_NO_MEMORY} if the
+ *          datagroup could not be allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int discorde_context_concorde_full(discorde_context *context, int n_nodes, int **cost_matrix,
+                                   int *out_tour, double *out_cost, int *out_status, int *in_tour);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic, as
+ * {@code linkernighan} does, with the options and the random state of a context. If {@code edges} holds the same edges
+ * as in the previous call, the costs are copied in place into the sparse datagroup of the context; otherwise the
+ * datagroup is built again.
+ *
+ * @param   context
+ *          The context of the call (see {@code discorde_context_create}).
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   n_edges
+ *          Number of edges.
+ * @param   edges
+ *          An unidimensional array of length {@code 2 * n_edges} with the endpoints of each edge, as in
+ *          {@code linkernighan}.
+ * @param   edges_costs
+ *          An array of length {@code n_edges} that gives the costs (weights) of each edge, following the same order in
+ *          {@code edges} array.
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          instance has more edges than Concorde can index, {@code DISCORDE_RETURN_NO_MEMORY} if the buffers of the
+ *          context could not be allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int discorde_context_linkernighan(discorde_context *context, int n_nodes, int n_edges, int *edges, int *edges_costs,
+                                  int *out_tour, double *out_cost, int *in_tour);
+
+/**
+ * This function solves an instance of the traveling salesman problem (TSP) using the Lin-Kernighan heuristic, as
+ * {@code linkernighan_full} does, with the options and the random state of a context. The matrix norm datagroup and
+ * the complete graph of the context are built again only if {@code n_nodes} differs from the previous call.
+ *
+ * @param   context
+ *          The context of the call (see {@code discorde_context_create}).
+ * @param   n_nodes
+ *          Number of nodes.
+ * @param   cost_matrix
+ *          A array of dimension {@code n_nodes} by {@code n_nodes}. It is an upper triangular matrix where the element
+ *          {@code cost_matrix[i][j]}, with i less than j, is the cost (weight) of the edges (i,j) and (j,i).
+ * @param   out_tour
+ *          An array of length {@code n_nodes} to store the best tour found by the solver.
+ * @param   out_cost
+ *          A pointer to a {@code double} variable to store the cost of the best tour ({@code out_tour}) found by the
+ *          solver.
+ * @param   in_tour
+ *          An array of length {@code n_nodes} which gives a starting tour in (node, node, ..., node) format. It may be
+ *          {@code NULL} if no feasible tour is known.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if a feasible tour has been found, {@code DISCORDE_RETURN_TOO_LARGE} if the
+ *          complete graph has more edges than Concorde can index, {@code DISCORDE_RETURN_NO_MEMORY} if the buffers of
+ *          the context could not be allocated, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+int discorde_context_linkernighan_full(discorde_context *context, int n_nodes, int **cost_matrix,
+                                       int *out_tour, double *out_cost, int *in_tour);
+
+/**
+ * A job of a batch: one instance given by a cost matrix, the options used to solve it and the place where its results
+ * are stored. Initialize each job with {@code discorde_job_init} and then set its fields.
+ */
+#ifndef DISCORDE_JOB_DEFINED
+#define DISCORDE_JOB_DEFINED
+typedef struct discorde_job {
+
+    /* Instance */
+    int n_nodes;                /* Number of nodes */
+    int matrix_layout;          /* Layout of the cost matrix: DISCORDE_MATRIX_ROWS, _FLAT or _PACKED */
+    int **cost_matrix;          /* Cost matrix if matrix_layout is DISCORDE_MATRIX_ROWS (as in concorde_full) */
+    const int *cost_buffer;     /* Cost matrix if matrix_layout is DISCORDE_MATRIX_FLAT or DISCORDE_MATRIX_PACKED */
+
+    /* Options */
+    int solver;                 /* DISCORDE_SOLVER_CONCORDE or DISCORDE_SOLVER_LINKERNIGHAN */
+    int *in_tour;               /* Starting tour, or NULL */
+    double *time_limit;         /* Time limit in seconds, or NULL */
+    double *target;             /* Target cost, or NULL */
+
+    /* Results */
+    int *out_tour;              /* Array of n_nodes entries given by the caller to store the best tour found */
+    double out_cost;            /* Cost of the best tour found */
+    int out_status;             /* Solver status (DISCORDE_STATUS_*) */
+    int return_value;           /* Return value of the solver call (DISCORDE_RETURN_*) */
+
+} discorde_job;
+#endif /* DISCORDE_JOB_DEFINED */
+
+/**
+ * Initialize a job of a batch with default values: no instance, Concorde solver, rows layout, no starting tour, no time
+ * limit and no target.
+ *
+ * @param   job
+ *          The job to initialize.
+ */
+void discorde_job_init(discorde_job *job);
+
+/**
+ * This function solves a batch of independent instances of the traveling salesman problem (TSP), each one as a call to
+ * {@code concorde_full} or {@code linkernighan_full} (or their flat and packed variants) would. The jobs run on a pool
+ * of threads with one queue of jobs per thread: the jobs are dealt to the queues from the largest to the smallest
+ * (estimated from the number of nodes and the solver), each thread runs the largest job left in its queue and, once
+ * its queue is empty, steals the largest job left in the queue of another thread. Each job runs on a single thread.
+ *
+ * The time limit of a job is measured on the wall clock from the start of the job, unlike the CPU time of the whole
+ * process measured by Concorde (see the notes on thread safety), so it does not run out faster while other jobs run at
+ * the same time: the Lin-Kernighan heuristic runs as a single chain of short slices (as in
+ * {@code linkernighan_full_monitored}), and Concorde is stopped through its time bound at the deadline.
+ *
+ * @param   jobs
+ *          An array of {@code n_jobs} jobs. The results of each job are stored in its fields {@code out_tour},
+ *          {@code out_cost}, {@code out_status} and {@code return_value}.
+ * @param   n_jobs
+ *          Number of jobs.
+ * @param   n_threads
+ *          Number of threads of the pool, including the calling one. If it is zero (or negative), the number of online
+ *          processors is used.
+ *
+ * @return  {@code DISCORDE_RETURN_OK} if all jobs have returned {@code DISCORDE_RETURN_OK}, or the return value of
+ *          the first job which has not otherwise.
+ */
+int discorde_solve_batch(discorde_job *jobs, int n_jobs, int n_threads);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,299 @@
+#include "discorde.h"
+#include "discorde_internal.h"
+#include <stdlib.h>
+#include <pthread.h>
+
+
+/*
+ * Queue of jobs of a thread of the pool. The jobs are kept from the largest to the smallest and are always taken from
+ * the head, both by the owner and by the threads that steal from it, so the largest jobs left start first.
+ */
+typedef struct batch_queue {
+    pthread_mutex_t lock;
+    int* items;     /* Indices of the jobs */
+    int head;       /* Next job to take */
+    int tail;       /* One past the last job */
+} batch_queue;
+
+/*
+ * State shared by the threads of the pool.
+ */
+typedef struct batch_pool {
+    discorde_job* jobs;
+    double* estimates;      /* Estimated cost of each job */
+    batch_queue* queues;
+    int n_queues;
+} batch_pool;
+
+/*
+ * Argument of a thread of the pool.
+ */
+typedef struct batch_worker {
+    batch_pool* pool;
+    int id;                 /* Index of the own queue */
+} batch_worker;
+
+/*
+ * Job index and its estimated cost, used to sort the jobs.
+ */
+typedef struct batch_order {
+    double estimate;
+    int index;
+} batch_order;
+
+
+void discorde_job_init(discorde_job* job)
+{
+    job->n_nodes = 0;
+    job->matrix_layout = DISCORDE_MATRIX_ROWS;
+    job->cost_matrix = NULL;
+    job->cost_buffer = NULL;
+    job->solver = DISCORDE_SOLVER_CONCORDE;
+    job->in_tour = NULL;
+    job->time_limit = NULL;
+    job->target = NULL;
+    job->out_tour = NULL;
+    job->out_cost = 0;
+    job->out_status = DISCORDE_STATUS_UNKNOWN;
+    job->return_value = DISCORDE_RETURN_FAILURE;
+}
+
+/*
+ * Estimated cost of a job, only used to order the jobs. Branch-and-cut grows much faster with the number of nodes than
+ * the Lin-Kernighan heuristic, whose setup is dominated by the quadratic cost of reading the cost matrix.
+ */
+static double batch_estimate(const discorde_job* job)
+{
+    double n;
+
+    n = (double) job->n_nodes;
+    return (job->solver == DISCORDE_SOLVER_CONCORDE) ? n * n * n : n * n;
+}
+
+/*
+ * Order of the jobs from the largest to the smallest.
+ */
+static int batch_compare(const void* a, const void* b)
+{
+    const batch_order* x;
+    const batch_order* y;
+
+    x = (const batch_order*) a;
+    y = (const batch_order*) b;
+    if (x->estimate != y->estimate) {
+        return (x->estimate > y->estimate) ? -1 : 1;
+    }
+
+    return x->index - y->index;
+}
+
+/*
+ * Solve a job with the solver and layout it asks for.
+ */
+static void batch_run(discorde_job* job)
+{
+    job->out_status = DISCORDE_STATUS_UNKNOWN;
+    job->return_value = discorde_solve_job(job);
+
+    /* Lin-Kernighan heuristic only reports whether the target has been reached */
+    if (job->solver == DISCORDE_SOLVER_LINKERNIGHAN && job->return_value == DISCORDE_RETURN_OK &&
+        job->target != NULL && job->out_cost <= *job->target) {
+        job->out_status = DISCORDE_STATUS_TARGET;
+    }
+}
+
+/*
+ * Take the job at the head of a queue. Returns -1 if the queue is empty.
+ */
+static int batch_take(batch_queue* queue)
+{
+    int index;
+
+    index = -1;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->head < queue->tail) {
+        index = queue->items[queue->head++];
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    return index;
+}
+
+/*
+ * Steal a job from the queue of another thread: the one whose next job is the largest. Returns -1 if all queues are
+ * empty.
+ */
+static int batch_steal(batch_pool* pool, int id)
+{
+    int q, victim, index;
+    double best;
+
+    for (;;) {
+
+        /* Look for the largest job left (the heads may change meanwhile, so it is only a hint) */
+        victim = -1;
+        best = -1;
+        for (q = 0; q < pool->n_queues; ++q) {
+            if (q == id) {
+                continue;
+            }
+            pthread_mutex_lock(&pool->queues[q].lock);
+            if (pool->queues[q].head < pool->queues[q].tail &&
+                pool->estimates[pool->queues[q].items[pool->queues[q].head]] > best) {
+                best = pool->estimates[pool->queues[q].items[pool->queues[q].head]];
+                victim = q;
+            }
+            pthread_mutex_unlock(&pool->queues[q].lock);
+        }
+
+        if (victim == -1) {
+            return -1;
+        }
+
+        /* Jobs are never added, so retrying only happens while other threads drain the queues */
+        index = batch_take(&pool->queues[victim]);
+        if (index != -1) {
+            return index;
+        }
+    }
+}
+
+static void* batch_worker_run(void* data)
+{
+    batch_worker* worker;
+    batch_pool* pool;
+    int index, serial;
+
+    worker = (batch_worker*) data;
+    pool = worker->pool;
+
+    /* Each job runs on this thread only: the pool already uses all the threads */
+    serial = discorde_parallel_set_serial(1);
+    for (;;) {
+        index = batch_take(&pool->queues[worker->id]);
+        if (index == -1) {
+            index = batch_steal(pool, worker->id);
+        }
+        if (index == -1) {
+            break;
+        }
+        batch_run(&pool->jobs[index]);
+    }
+
+    /* The calling thread runs a queue too, and may itself be a worker of another pool */
+    discorde_parallel_set_serial(serial);
+
+    return NULL;
+}
+
+int discorde_solve_batch(discorde_job* jobs, int n_jobs, int n_threads)
+{
+
+    /* Auxiliary variables */
+    int i, q, n_started;
+    batch_order* order;
+    batch_worker* workers;
+    pthread_t* threads;
+    batch_pool pool;
+
+    if (n_jobs <= 0) {
+        return DISCORDE_RETURN_OK;
+    }
+
+    /* Size of the pool */
+    if (n_threads <= 0) {
+        n_threads = discorde_num_threads();
+    }
+    if (n_threads > n_jobs) {
+        n_threads = n_jobs;
+    }
+
+    /* Order the jobs from the largest to the smallest */
+    order = (batch_order*) malloc(sizeof(batch_order) * n_jobs);
+    pool.estimates = (double*) malloc(sizeof(double) * n_jobs);
+    if (order == NULL || pool.estimates == NULL) {
+        free(order);
+        free(pool.estimates);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    for (i = 0; i < n_jobs; ++i) {
+        pool.estimates[i] = batch_estimate(&jobs[i]);
+        order[i].estimate = pool.estimates[i];
+        order[i].index = i;
+    }
+    qsort(order, n_jobs, sizeof(batch_order), batch_compare);
+
+    /* A single thread runs the jobs in order, letting each job use parallel loops */
+    if (n_threads == 1) {
+        for (i = 0; i < n_jobs; ++i) {
+            batch_run(&jobs[order[i].index]);
+        }
+    } else {
+
+        /* Deal the jobs to the queues round-robin, so every queue is ordered and gets a share of the large jobs */
+        pool.jobs = jobs;
+        pool.n_queues = n_threads;
+        pool.queues = (batch_queue*) malloc(sizeof(batch_queue) * n_threads);
+        workers = (batch_worker*) malloc(sizeof(batch_worker) * n_threads);
+        threads = (pthread_t*) malloc(sizeof(pthread_t) * n_threads);
+        if (pool.queues == NULL || workers == NULL || threads == NULL) {
+            free(pool.queues);
+            free(workers);
+            free(threads);
+            free(order);
+            free(pool.estimates);
+            return DISCORDE_RETURN_NO_MEMORY;
+        }
+        for (q = 0; q < n_threads; ++q) {
+            pool.queues[q].items = (int*) malloc(sizeof(int) * ((n_jobs + n_threads - 1) / n_threads));
+            pool.queues[q].head = 0;
+            pool.queues[q].tail = 0;
+            pthread_mutex_init(&pool.queues[q].lock, NULL);
+            workers[q].pool = &pool;
+            workers[q].id = q;
+        }
+        for (i = 0; i < n_jobs; ++i) {
+            q = i % n_threads;
+            if (pool.queues[q].items != NULL) {
+                pool.queues[q].items[pool.queues[q].tail++] = order[i].index;
+            } else {
+                batch_run(&jobs[order[i].index]);
+            }
+        }
+
+        /* Start the helper threads (the calling thread runs the first queue) */
+        n_started = 0;
+        for (q = 1; q < n_threads; ++q) {
+            if (pthread_create(&threads[n_started], NULL, batch_worker_run, &workers[q]) == 0) {
+                ++n_started;
+            }
+        }
+
+        /* Queues of threads that could not be started are stolen by the others */
+        batch_worker_run(&workers[0]);
+
+        for (i = 0; i < n_started; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+
+        for (q = 0; q < n_threads; ++q) {
+            pthread_mutex_destroy(&pool.queues[q].lock);
+            free(pool.queues[q].items);
+        }
+        free(pool.queues);
+        free(workers);
+        free(threads);
+    }
+
+    free(order);
+    free(pool.estimates);
+
+    /* Report the first job that failed */
+    for (i = 0; i < n_jobs; ++i) {
+        if (jobs[i].return_value != DISCORDE_RETURN_OK) {
+            return jobs[i].return_value;
+        }
+    }
+
+    return DISCORDE_RETURN_OK;
+}
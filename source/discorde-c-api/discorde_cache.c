@@ -0,0 +1,585 @@
+#include "discorde.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/*
+ * Cache file format: a header, a table of slots and a ring buffer of records. The slot of an instance is picked by its
+ * key, and holds the position of its last record in the ring; a record is valid until the ring wraps around over it
+ * (or its slot is taken by another instance), which bounds the size of the file. Each record holds the key, the size,
+ * the result and the tour of a solve. The file is shared by the processes that open it, through a shared mapping
+ * guarded by file locks.
+ */
+#define CACHE_MAGIC         "DISCACHE"
+#define CACHE_VERSION       2
+#define CACHE_MIN_BYTES     65536       /* Smallest size of a cache file */
+#define CACHE_BYTES_SLOT    1024        /* Bytes of the file per slot of the table */
+
+/*
+ * Kinds of instances, mixed into the keys so that a list of edges and a matrix never share a key.
+ */
+#define CACHE_KIND_EDGES    1
+#define CACHE_KIND_MATRIX   2
+
+typedef struct cache_header {
+    char magic[8];
+    unsigned int version;
+    unsigned int n_slots;
+    unsigned long capacity;             /* Size of the ring of records */
+    unsigned long offset;               /* Offset in the ring of the next record */
+    unsigned long lap;                  /* Number of times the ring has wrapped around */
+} cache_header;
+
+typedef struct cache_slot {
+    uint64_t key[2];
+    unsigned int used;
+    unsigned long offset;               /* Offset in the ring of the record */
+    unsigned long lap;                  /* Lap of the ring when the record was written */
+} cache_slot;
+
+typedef struct cache_record {
+    double cost;
+    double time_limit;                  /* Time limit of the solve, or -1 if it had none */
+    uint64_t key[2];
+    int n_nodes;
+    int n_edges;                        /* Number of edges of the list, or 0 for a matrix */
+    int status;
+    unsigned long size;                 /* Size of the record with its tour, a multiple of 8 */
+} cache_record;
+
+struct discorde_cache {
+    int file;
+    size_t map_size;
+    void* map;
+    cache_header* header;
+    cache_slot* slots;
+    char* ring;
+    pthread_mutex_t lock;               /* File locks do not tell apart the threads of a process */
+};
+
+/*
+ * Instance looked up in the cache: a list of edges, or a cost matrix if {@code cost_matrix} is not NULL. The key is
+ * filled by {@code cache_key_edges} or {@code cache_key_matrix}.
+ */
+typedef struct cache_instance {
+    int n_nodes;
+    int n_edges;                        /* Number of edges of the list, or 0 for a matrix */
+    const int* edges;
+    const int* edges_costs;
+    int** cost_matrix;
+    uint64_t key[2];
+} cache_instance;
+
+/*
+ * Mix a 64-bit value into a 64-bit hash, as the finalizer of MurmurHash3.
+ */
+static uint64_t cache_mix(uint64_t hash, uint64_t value)
+{
+    hash ^= value;
+    hash ^= hash >> 33;
+    hash *= UINT64_C(0xFF51AFD7ED558CCD);
+    hash ^= hash >> 33;
+    hash *= UINT64_C(0xC4CEB9FE1A85EC53);
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+/*
+ * Finish the two 64-bit lanes of the key of an instance with its size and kind.
+ */
+static void cache_key_finish(cache_instance* instance, uint64_t lane0, uint64_t lane1, int kind)
+{
+    uint64_t size;
+
+    size = ((uint64_t) (unsigned int) instance->n_nodes << 32) | (uint64_t) (unsigned int) instance->n_edges;
+    instance->key[0] = cache_mix(cache_mix(lane0, (uint64_t) kind), size);
+    instance->key[1] = cache_mix(cache_mix(lane1 ^ UINT64_C(0x5BD1E9955BD1E995), size), (uint64_t) kind);
+}
+
+/*
+ * Key of an instance given by a list of edges. It does not depend on the order of the edges nor on the order of the
+ * endpoints of each edge: each edge is hashed on its own, into 128 bits over two lanes seeded apart, and the hashes of
+ * the edges are summed. A collision only costs a solve, since a cached tour is checked against the instance.
+ */
+static void cache_key_edges(cache_instance* instance)
+{
+    int e;
+    uint64_t a, b, pair, cost, lane0, lane1;
+
+    lane0 = 0;
+    lane1 = 0;
+    for (e = 0; e < instance->n_edges; ++e) {
+        a = (uint64_t) (unsigned int) instance->edges[2 * e];
+        b = (uint64_t) (unsigned int) instance->edges[2 * e + 1];
+        cost = (uint64_t) (unsigned int) instance->edges_costs[e];
+        pair = (a < b) ? (a << 32 | b) : (b << 32 | a);
+        lane0 += cache_mix(cache_mix(UINT64_C(0x9747B28C9747B28C), pair), cost);
+        lane1 += cache_mix(cache_mix(UINT64_C(0x2545F4914F6CDD1D), cost), pair);
+    }
+
+    cache_key_finish(instance, lane0, lane1, CACHE_KIND_EDGES);
+}
+
+/*
+ * Key of an instance given by a cost matrix. Only its upper triangle is read, with one multiplication per entry and
+ * lane (as FNV-1a on words).
+ */
+static void cache_key_matrix(cache_instance* instance)
+{
+    int i, j;
+    uint64_t value, lane0, lane1;
+
+    lane0 = UINT64_C(14695981039346656037);
+    lane1 = UINT64_C(14695981039346656037) ^ UINT64_C(0xA5A5A5A5A5A5A5A5);
+    for (i = 0; i < instance->n_nodes; ++i) {
+        for (j = i + 1; j < instance->n_nodes; ++j) {
+            value = (uint64_t) (unsigned int) instance->cost_matrix[i][j];
+            lane0 = (lane0 ^ value) * UINT64_C(1099511628211);
+            lane1 = (lane1 ^ value) * UINT64_C(0x9E3779B97F4A7C15);
+        }
+    }
+
+    cache_key_finish(instance, lane0, lane1, CACHE_KIND_MATRIX);
+}
+
+/*
+ * Compute the cost of a tour over an instance. Returns 0 on success, or a non-zero value if the tour does not visit
+ * every node once, uses a pair of nodes that is not an edge of the list, or memory could not be allocated.
+ */
+static int cache_tour_cost(const cache_instance* instance, const int* tour, double* out_cost)
+{
+    int i, e, n, p, q, u, v;
+    int* position;
+    double* tour_costs;     /* tour_costs[i]: cheapest edge from tour[i] to the next node, or DBL_MAX */
+    double cost;
+
+    n = instance->n_nodes;
+    position = (int*) malloc(sizeof(int) * (size_t) n);
+    tour_costs = (double*) malloc(sizeof(double) * (size_t) n);
+    if (position == NULL || tour_costs == NULL) {
+        free(position);
+        free(tour_costs);
+        return 1;
+    }
+
+    for (i = 0; i < n; ++i) {
+        position[i] = -1;
+        tour_costs[i] = DBL_MAX;
+    }
+    for (i = 0; i < n; ++i) {
+        if (tour[i] < 0 || tour[i] >= n || position[tour[i]] >= 0) {
+            free(position);
+            free(tour_costs);
+            return 1;
+        }
+        position[tour[i]] = i;
+    }
+
+    if (instance->cost_matrix != NULL) {
+        for (i = 0; i < n; ++i) {
+            u = tour[i];
+            v = tour[(i + 1) % n];
+            tour_costs[i] = (u == v) ? 0 : (u < v) ? instance->cost_matrix[u][v] : instance->cost_matrix[v][u];
+        }
+    } else {
+        /* An edge of the list joins tour[p] to the next node if its other endpoint is at q = p + 1 (modulo n) */
+        for (e = 0; e < instance->n_edges; ++e) {
+            u = instance->edges[2 * e];
+            v = instance->edges[2 * e + 1];
+            if (u < 0 || u >= n || v < 0 || v >= n) {
+                continue;
+            }
+            p = position[u];
+            q = position[v];
+            if (q == (p + 1) % n && instance->edges_costs[e] < tour_costs[p]) {
+                tour_costs[p] = instance->edges_costs[e];
+            }
+            if (p == (q + 1) % n && instance->edges_costs[e] < tour_costs[q]) {
+                tour_costs[q] = instance->edges_costs[e];
+            }
+        }
+    }
+
+    cost = 0;
+    for (i = 0; i < n && n > 1 && tour_costs[i] < DBL_MAX; ++i) {
+        cost += tour_costs[i];
+    }
+
+    free(position);
+    free(tour_costs);
+    *out_cost = cost;
+
+    return n > 1 && i < n;
+}
+
+/*
+ * Offset of the ring of a file of {@code n_slots} slots: the slots and the ring follow the header, each aligned to 8
+ * bytes.
+ */
+static size_t cache_ring_offset(unsigned int n_slots)
+{
+    return (sizeof(cache_header) + (size_t) n_slots * sizeof(cache_slot) + 7) / 8 * 8;
+}
+
+/*
+ * Return whether a header read from a file of {@code file_size} bytes describes a valid layout of that file.
+ */
+static int cache_header_valid(const cache_header* header, size_t file_size)
+{
+    size_t ring_offset;
+
+    if (memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic)) != 0 || header->version != CACHE_VERSION
+        || header->n_slots == 0 || header->n_slots > file_size / CACHE_BYTES_SLOT || file_size % 8 != 0) {
+        return 0;
+    }
+    ring_offset = cache_ring_offset(header->n_slots);
+
+    return ring_offset < file_size && header->capacity == (unsigned long) (file_size - ring_offset)
+           && header->offset <= header->capacity && header->offset % 8 == 0;
+}
+
+/*
+ * Return whether a header has never been written: the file was created (and sized) by a process that died before
+ * writing it, so no process can have the file mapped.
+ */
+static int cache_header_blank(const cache_header* header)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(header->magic); ++i) {
+        if (header->magic[i] != '\0') {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int discorde_cache_open(const char* path, size_t max_bytes, discorde_cache** out_cache)
+{
+    discorde_cache* cache;
+    struct stat info;
+    cache_header header;
+    unsigned int n_slots;
+    size_t ring_offset;
+    int fresh;
+
+    *out_cache = NULL;
+    if (path == NULL || max_bytes < CACHE_MIN_BYTES || max_bytes > (size_t) (LONG_MAX / 2)) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    cache = (discorde_cache*) malloc(sizeof(discorde_cache));
+    if (cache == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    cache->file = open(path, O_RDWR | O_CREAT, 0600);
+    if (cache->file < 0) {
+        free(cache);
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    /*
+     * Other processes may have the file mapped, so a valid file keeps its layout whatever the size asked for: it is
+     * never truncated under them. Only a new file (or one whose header has never been written) is laid out for
+     * max_bytes; any other file is not a cache of this version, and it is left alone.
+     */
+    flock(cache->file, LOCK_EX);
+    memset(&header, 0, sizeof(header));
+    if (fstat(cache->file, &info) != 0 || (info.st_size > 0 && pread(cache->file, &header, sizeof(header), 0) < 0)) {
+        flock(cache->file, LOCK_UN);
+        close(cache->file);
+        free(cache);
+        return DISCORDE_RETURN_FAILURE;
+    }
+    fresh = info.st_size == 0;
+    if (!fresh) {
+        if (cache_header_valid(&header, (size_t) info.st_size)) {
+            cache->map_size = (size_t) info.st_size;
+            n_slots = header.n_slots;
+        } else if (cache_header_blank(&header)) {
+            fresh = 1;
+        } else {
+            flock(cache->file, LOCK_UN);
+            close(cache->file);
+            free(cache);
+            return DISCORDE_RETURN_FAILURE;
+        }
+    }
+    if (fresh) {
+        cache->map_size = max_bytes / 8 * 8;
+        n_slots = (unsigned int) (max_bytes / CACHE_BYTES_SLOT);
+        if (ftruncate(cache->file, 0) != 0 || ftruncate(cache->file, (off_t) cache->map_size) != 0) {
+            flock(cache->file, LOCK_UN);
+            close(cache->file);
+            free(cache);
+            return DISCORDE_RETURN_FAILURE;
+        }
+    }
+    ring_offset = cache_ring_offset(n_slots);
+
+    cache->map = mmap(NULL, cache->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, cache->file, 0);
+    if (cache->map == MAP_FAILED) {
+        flock(cache->file, LOCK_UN);
+        close(cache->file);
+        free(cache);
+        return DISCORDE_RETURN_FAILURE;
+    }
+    cache->header = (cache_header*) cache->map;
+    cache->slots = (cache_slot*) ((char*) cache->map + sizeof(cache_header));
+    cache->ring = (char*) cache->map + ring_offset;
+    if (fresh) {
+        memset(cache->map, 0, ring_offset);
+        cache->header->n_slots = n_slots;
+        cache->header->capacity = (unsigned long) (cache->map_size - ring_offset);
+        cache->header->version = CACHE_VERSION;
+        memcpy(cache->header->magic, CACHE_MAGIC, sizeof(cache->header->magic));
+    }
+    flock(cache->file, LOCK_UN);
+
+    pthread_mutex_init(&cache->lock, NULL);
+    *out_cache = cache;
+
+    return DISCORDE_RETURN_OK;
+}
+
+void discorde_cache_close(discorde_cache* cache)
+{
+    if (cache == NULL) {
+        return;
+    }
+
+    munmap(cache->map, cache->map_size);
+    close(cache->file);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+}
+
+/*
+ * Return the record of an instance, or NULL if it has none or the ring has wrapped around over it. It must be called
+ * with the cache locked.
+ */
+static const cache_record* cache_find(const discorde_cache* cache, const cache_instance* instance)
+{
+    const cache_header* header;
+    const cache_slot* slot;
+    const cache_record* record;
+    int intact;
+
+    header = cache->header;
+    slot = &cache->slots[instance->key[0] % header->n_slots];
+    if (!slot->used || slot->key[0] != instance->key[0] || slot->key[1] != instance->key[1]) {
+        return NULL;
+    }
+
+    /* A record of the current lap lies before the offset, one of the previous lap after it */
+    intact = (slot->lap == header->lap && slot->offset < header->offset)
+             || (slot->lap + 1 == header->lap && slot->offset >= header->offset);
+    if (!intact || slot->offset + sizeof(cache_record) > header->capacity) {
+        return NULL;
+    }
+
+    record = (const cache_record*) (cache->ring + slot->offset);
+    if (record->key[0] != instance->key[0] || record->key[1] != instance->key[1]
+        || record->n_nodes != instance->n_nodes || record->n_edges != instance->n_edges
+        || record->size > header->capacity - slot->offset
+        || record->size < sizeof(cache_record) + sizeof(int) * (size_t) instance->n_nodes) {
+        return NULL;
+    }
+
+    return record;
+}
+
+/*
+ * Look up the result of an instance. An optimal result is always reused, as is one that reaches the target of the new
+ * solve; one stopped by its time limit is reused if the new time limit is not larger. A result is only reused if its
+ * tour visits every node once and costs, on the instance, the cost recorded with it, so that a collision of keys (or a
+ * corrupted record) is a miss. Returns {@code DISCORDE_RETURN_OK} if a result has been copied.
+ */
+static int cache_lookup(discorde_cache* cache, const cache_instance* instance, int* out_tour, double* out_cost,
+                        int* out_status, double* time_limit, double* target)
+{
+    const cache_record* record;
+    int status;
+    double cost;
+
+    pthread_mutex_lock(&cache->lock);
+    flock(cache->file, LOCK_SH);
+
+    record = cache_find(cache, instance);
+    status = DISCORDE_STATUS_UNKNOWN;
+    if (record != NULL) {
+        if (record->status == DISCORDE_STATUS_OPTIMAL) {
+            status = DISCORDE_STATUS_OPTIMAL;
+        } else if (target != NULL && record->cost <= *target) {
+            status = DISCORDE_STATUS_TARGET;
+        } else if (record->status == DISCORDE_STATUS_TIMELIMIT && time_limit != NULL
+                   && *time_limit <= record->time_limit) {
+            status = DISCORDE_STATUS_TIMELIMIT;
+        } else {
+            record = NULL;
+        }
+    }
+    if (record != NULL
+        && (cache_tour_cost(instance, (const int*) (record + 1), &cost) != 0 || cost != record->cost)) {
+        record = NULL;
+    }
+    if (record != NULL) {
+        memcpy(out_tour, record + 1, sizeof(int) * (size_t) instance->n_nodes);
+        *out_cost = record->cost;
+        if (out_status != NULL) {
+            *out_status = status;
+        }
+    }
+
+    flock(cache->file, LOCK_UN);
+    pthread_mutex_unlock(&cache->lock);
+
+    return (record != NULL) ? DISCORDE_RETURN_OK : DISCORDE_RETURN_FAILURE;
+}
+
+/*
+ * Store the result of a solve, unless it is larger than the ring. The record is appended to the ring (wrapping around
+ * to its start if it does not fit before the end) and the slot of the instance is pointed to it.
+ */
+static void cache_store(discorde_cache* cache, const cache_instance* instance, const int* tour, double cost,
+                        int status, double* time_limit)
+{
+    cache_header* header;
+    cache_slot* slot;
+    cache_record* record;
+    unsigned long size;
+
+    size = (unsigned long) (sizeof(cache_record) + sizeof(int) * (size_t) instance->n_nodes);
+    size = (size + 7) / 8 * 8;
+
+    pthread_mutex_lock(&cache->lock);
+    flock(cache->file, LOCK_EX);
+
+    header = cache->header;
+    if (size <= header->capacity) {
+        if (size > header->capacity - header->offset) {
+            header->offset = 0;
+            ++header->lap;
+        }
+
+        /* The slot is cleared first, so that a process killed while writing leaves no half-written record behind */
+        slot = &cache->slots[instance->key[0] % header->n_slots];
+        slot->used = 0;
+
+        record = (cache_record*) (cache->ring + header->offset);
+        record->cost = cost;
+        record->time_limit = (time_limit != NULL) ? *time_limit : -1;
+        record->key[0] = instance->key[0];
+        record->key[1] = instance->key[1];
+        record->n_nodes = instance->n_nodes;
+        record->n_edges = instance->n_edges;
+        record->status = status;
+        record->size = size;
+        memcpy(record + 1, tour, sizeof(int) * (size_t) instance->n_nodes);
+
+        slot->key[0] = instance->key[0];
+        slot->key[1] = instance->key[1];
+        slot->offset = header->offset;
+        slot->lap = header->lap;
+        slot->used = 1;
+        header->offset += size;
+    }
+
+    flock(cache->file, LOCK_UN);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/*
+ * Store the result of a solve if it may be reused: only tours that are optimal, or that were stopped by the time limit
+ * or by the target, are kept.
+ */
+static void cache_store_result(discorde_cache* cache, const cache_instance* instance, const int* tour, double cost,
+                               int status, double* time_limit)
+{
+    if (status == DISCORDE_STATUS_OPTIMAL || status == DISCORDE_STATUS_TIMELIMIT || status == DISCORDE_STATUS_TARGET) {
+        cache_store(cache, instance, tour, cost, status, time_limit);
+    }
+}
+
+int concorde_cached(discorde_cache* cache, int n_nodes, int n_edges, int* edges, int* edges_costs,
+                    int* out_tour, double* out_cost, int* out_status,
+                    int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    int return_value, status;
+    cache_instance instance;
+
+    if (n_nodes < 1 || n_edges < 0) {
+        return concorde(n_nodes, n_edges, edges, edges_costs, out_tour, out_cost, out_status, in_tour, verbose,
+                        time_limit, target);
+    }
+
+    status = DISCORDE_STATUS_UNKNOWN;
+    instance.n_nodes = n_nodes;
+    instance.n_edges = n_edges;
+    instance.edges = edges;
+    instance.edges_costs = edges_costs;
+    instance.cost_matrix = NULL;
+    cache_key_edges(&instance);
+    if (cache_lookup(cache, &instance, out_tour, out_cost, out_status, time_limit, target) == DISCORDE_RETURN_OK) {
+        return DISCORDE_RETURN_OK;
+    }
+
+    return_value = concorde(n_nodes, n_edges, edges, edges_costs, out_tour, out_cost, &status, in_tour, verbose,
+                            time_limit, target);
+    if (return_value == DISCORDE_RETURN_OK) {
+        cache_store_result(cache, &instance, out_tour, *out_cost, status, time_limit);
+    }
+    if (out_status != NULL) {
+        *out_status = status;
+    }
+
+    return return_value;
+}
+
+int concorde_full_cached(discorde_cache* cache, int n_nodes, int** cost_matrix,
+                         int* out_tour, double* out_cost, int* out_status,
+                         int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    int return_value, status;
+    cache_instance instance;
+
+    if (n_nodes < 1) {
+        return concorde_full(n_nodes, cost_matrix, out_tour, out_cost, out_status, in_tour, verbose, time_limit,
+                             target);
+    }
+
+    status = DISCORDE_STATUS_UNKNOWN;
+    instance.n_nodes = n_nodes;
+    instance.n_edges = 0;
+    instance.edges = NULL;
+    instance.edges_costs = NULL;
+    instance.cost_matrix = cost_matrix;
+    cache_key_matrix(&instance);
+    if (cache_lookup(cache, &instance, out_tour, out_cost, out_status, time_limit, target) == DISCORDE_RETURN_OK) {
+        return DISCORDE_RETURN_OK;
+    }
+
+    return_value = concorde_full(n_nodes, cost_matrix, out_tour, out_cost, &status, in_tour, verbose, time_limit,
+                                 target);
+    if (return_value == DISCORDE_RETURN_OK) {
+        cache_store_result(cache, &instance, out_tour, *out_cost, status, time_limit);
+    }
+    if (out_status != NULL) {
+        *out_status = status;
+    }
+
+    return return_value;
+}
@@ -0,0 +1,322 @@
+#include "discorde.h"
+#include "discorde_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <inttypes.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+
+/*
+ * Checkpoint file format: a text file with a header line, the numbers of nodes and edges and the fingerprint of the
+ * instance, the cost of the tour, whether it is optimal, and the tour itself. It is written to a temporary file first
+ * and then renamed over the previous checkpoint, so a process killed while writing leaves the previous checkpoint
+ * intact.
+ */
+#define CHECKPOINT_HEADER "DISCORDE_CHECKPOINT 2"
+#define CHECKPOINT_FILE   "checkpoint"
+
+/*
+ * Files of the branch-and-bound tree of a checkpointed call, next to the checkpoint file: the tree file (the
+ * labelling of the nodes given to Concorde, the next id of a problem and the active nodes, in the text format of the
+ * checkpoint file), the cut pool written by Concorde, and the directory of the problem files of the active nodes. The
+ * tree file is renamed over the previous one only once the pool and the problem files it refers to are on disk.
+ */
+#define CHECKPOINT_TREE_HEADER "DISCORDE_TREE 2"
+#define CHECKPOINT_TREE_FILE   "tree"
+#define CHECKPOINT_POOL_FILE   "pool"
+#define CHECKPOINT_PROBLEMS    "problems"
+#define CHECKPOINT_PROBLEM     "problem"
+
+/*
+ * Room left in the paths of a checkpoint for the suffixes Concorde appends to the name of its problem files.
+ */
+#define CHECKPOINT_SUFFIX_MAX 32
+
+/*
+ * Offset basis of the 64-bit FNV-1a hash.
+ */
+#define CHECKPOINT_HASH_BASIS UINT64_C(14695981039346656037)
+
+/*
+ * Mix {@code count} integers into a 64-bit FNV-1a hash.
+ */
+static uint64_t checkpoint_hash(uint64_t hash, const int* values, size_t count)
+{
+    size_t i, k;
+    uint64_t value;
+
+    for (i = 0; i < count; ++i) {
+        value = (uint64_t) (unsigned int) values[i];
+        for (k = 0; k < 4; ++k) {
+            hash ^= (value >> (8 * k)) & 0xFF;
+            hash *= UINT64_C(1099511628211);
+        }
+    }
+
+    return hash;
+}
+
+/*
+ * Sync to the disk the directory of {@code path}, so that a file just renamed into it keeps its new name after a
+ * crash of the machine. Returns {@code DISCORDE_RETURN_OK} on success, or {@code DISCORDE_RETURN_FAILURE} otherwise.
+ */
+static int checkpoint_sync_directory(const char* path)
+{
+    char directory[DISCORDE_SCRATCH_PATH_SIZE];
+    char* slash;
+    int fd, failed;
+
+    strncpy(directory, path, sizeof(directory) - 1);
+    directory[sizeof(directory) - 1] = '\0';
+    slash = strrchr(directory, '/');
+    if (slash == NULL) {
+        strcpy(directory, ".");
+    } else if (slash == directory) {
+        slash[1] = '\0';
+    } else {
+        *slash = '\0';
+    }
+
+    fd = open(directory, O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+    failed = fsync(fd) != 0;
+    failed = close(fd) != 0 || failed;
+
+    return failed ? DISCORDE_RETURN_FAILURE : DISCORDE_RETURN_OK;
+}
+
+int discorde_checkpoint_init(discorde_checkpoint *checkpoint, const char *directory, int n_nodes, int n_edges,
+                             const int *edges, const int *edges_costs)
+{
+    int sizes[2];
+
+    if (directory == NULL
+        || strlen(directory) + sizeof(CHECKPOINT_PROBLEMS) + sizeof(CHECKPOINT_PROBLEM) + CHECKPOINT_SUFFIX_MAX
+           > DISCORDE_SCRATCH_PATH_SIZE
+        || access(directory, W_OK | X_OK) != 0) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    sprintf(checkpoint->path, "%s/%s", directory, CHECKPOINT_FILE);
+    sprintf(checkpoint->temp_path, "%s/%s.tmp", directory, CHECKPOINT_FILE);
+    sprintf(checkpoint->tree_path, "%s/%s", directory, CHECKPOINT_TREE_FILE);
+    sprintf(checkpoint->tree_temp_path, "%s/%s.tmp", directory, CHECKPOINT_TREE_FILE);
+    sprintf(checkpoint->pool_path, "%s/%s", directory, CHECKPOINT_POOL_FILE);
+    sprintf(checkpoint->pool_temp_path, "%s/%s.tmp", directory, CHECKPOINT_POOL_FILE);
+    sprintf(checkpoint->problems, "%s/%s", directory, CHECKPOINT_PROBLEMS);
+    sprintf(checkpoint->problem_name, "%s/%s/%s", directory, CHECKPOINT_PROBLEMS, CHECKPOINT_PROBLEM);
+
+    sizes[0] = n_nodes;
+    sizes[1] = n_edges;
+    checkpoint->fingerprint = checkpoint_hash(CHECKPOINT_HASH_BASIS, sizes, 2);
+    checkpoint->fingerprint = checkpoint_hash(checkpoint->fingerprint, edges, 2 * (size_t) n_edges);
+    checkpoint->fingerprint = checkpoint_hash(checkpoint->fingerprint, edges_costs, (size_t) n_edges);
+    checkpoint->n_nodes = n_nodes;
+    checkpoint->n_edges = n_edges;
+    checkpoint->written = 0;
+    checkpoint->cost = 0;
+    checkpoint->failed = 0;
+
+    return DISCORDE_RETURN_OK;
+}
+
+int discorde_checkpoint_read(const discorde_checkpoint *checkpoint, int *tour, double *cost, bool *optimal)
+{
+    FILE* file;
+    char header[sizeof(CHECKPOINT_HEADER) + 1];
+    int i, n_nodes, n_edges, is_optimal, matched;
+    uint64_t fingerprint;
+
+    file = fopen(checkpoint->path, "r");
+    if (file == NULL) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    /* The checkpoint must belong to the same instance, which is checked through its sizes and fingerprint */
+    matched = fgets(header, sizeof(header), file) != NULL
+              && strncmp(header, CHECKPOINT_HEADER, strlen(CHECKPOINT_HEADER)) == 0
+              && fscanf(file, "%d %d %" SCNu64 " %lf %d", &n_nodes, &n_edges, &fingerprint, cost, &is_optimal) == 5
+              && n_nodes == checkpoint->n_nodes && n_edges == checkpoint->n_edges
+              && fingerprint == checkpoint->fingerprint;
+    for (i = 0; i < checkpoint->n_nodes && matched; ++i) {
+        matched = fscanf(file, "%d", &tour[i]) == 1 && tour[i] >= 0 && tour[i] < n_nodes;
+    }
+    fclose(file);
+
+    *optimal = matched && is_optimal != 0;
+
+    return matched ? DISCORDE_RETURN_OK : DISCORDE_RETURN_FAILURE;
+}
+
+int discorde_checkpoint_commit(FILE *file, int failed, const char *temp_path, const char *path)
+{
+    failed = fflush(file) != 0 || failed;
+    failed = fsync(fileno(file)) != 0 || failed;
+    failed = fclose(file) != 0 || failed;
+    if (failed || rename(temp_path, path) != 0) {
+        unlink(temp_path);
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    /* The rename is only durable once the directory is on the disk too */
+    return checkpoint_sync_directory(path);
+}
+
+int discorde_checkpoint_write(discorde_checkpoint *checkpoint, const int *tour, double cost, bool optimal)
+{
+    FILE* file;
+    int i, failed;
+
+    /* Only improvements (or a proof of optimality) replace the checkpoint */
+    if (checkpoint->written && cost > checkpoint->cost) {
+        return DISCORDE_RETURN_OK;
+    }
+    if (checkpoint->written && cost == checkpoint->cost && !optimal) {
+        return DISCORDE_RETURN_OK;
+    }
+
+    file = fopen(checkpoint->temp_path, "w");
+    if (file == NULL) {
+        checkpoint->failed = 1;
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    failed = fprintf(file, "%s\n%d %d %" PRIu64 " %.17g %d\n", CHECKPOINT_HEADER, checkpoint->n_nodes,
+                     checkpoint->n_edges, checkpoint->fingerprint, cost, optimal ? 1 : 0) < 0;
+    for (i = 0; i < checkpoint->n_nodes && !failed; ++i) {
+        failed = fprintf(file, "%d\n", tour[i]) < 0;
+    }
+    if (discorde_checkpoint_commit(file, failed, checkpoint->temp_path, checkpoint->path) != DISCORDE_RETURN_OK) {
+        checkpoint->failed = 1;
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    checkpoint->written = 1;
+    checkpoint->cost = cost;
+
+    return DISCORDE_RETURN_OK;
+}
+
+int discorde_checkpoint_reset(const discorde_checkpoint *checkpoint)
+{
+    DIR* dir;
+    struct dirent* entry;
+    char path[DISCORDE_SCRATCH_PATH_SIZE + 256];
+
+    unlink(checkpoint->tree_path);
+    unlink(checkpoint->pool_path);
+
+    /* The problems directory only ever holds the problem files of Concorde */
+    dir = opendir(checkpoint->problems);
+    if (dir != NULL) {
+        while ((entry = readdir(dir)) != NULL) {
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+                continue;
+            }
+            sprintf(path, "%s/%.255s", checkpoint->problems, entry->d_name);
+            unlink(path);
+        }
+        closedir(dir);
+    }
+
+    if (mkdir(checkpoint->problems, 0700) != 0 && errno != EEXIST) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    return DISCORDE_RETURN_OK;
+}
+
+int discorde_checkpoint_write_tree(discorde_checkpoint *checkpoint, const discorde_bb_tree *tree)
+{
+    FILE* file;
+    int i, failed;
+
+    file = fopen(checkpoint->tree_temp_path, "w");
+    if (file == NULL) {
+        checkpoint->failed = 1;
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    failed = fprintf(file, "%s\n%d %d %" PRIu64 " %d %d\n", CHECKPOINT_TREE_HEADER, checkpoint->n_nodes,
+                     checkpoint->n_edges, checkpoint->fingerprint, tree->next_id, tree->n_active) < 0;
+    for (i = 0; i < checkpoint->n_nodes && !failed; ++i) {
+        failed = fprintf(file, "%d\n", tree->perm[i]) < 0;
+    }
+    for (i = 0; i < tree->n_active && !failed; ++i) {
+        failed = fprintf(file, "%d %d %.17g\n", tree->active[i].id, tree->active[i].cut,
+                         tree->active[i].lower_bound) < 0;
+    }
+    if (discorde_checkpoint_commit(file, failed, checkpoint->tree_temp_path, checkpoint->tree_path)
+        != DISCORDE_RETURN_OK) {
+        checkpoint->failed = 1;
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    return DISCORDE_RETURN_OK;
+}
+
+int discorde_checkpoint_read_tree(const discorde_checkpoint *checkpoint, discorde_bb_tree *tree)
+{
+    FILE* file;
+    char header[sizeof(CHECKPOINT_TREE_HEADER) + 1];
+    int i, n_nodes, n_edges, matched;
+    uint64_t fingerprint;
+
+    tree->perm = NULL;
+    tree->active = NULL;
+    tree->n_active = 0;
+    tree->capacity = 0;
+
+    file = fopen(checkpoint->tree_path, "r");
+    if (file == NULL) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    /* The tree must belong to the same instance, which is checked through its sizes and fingerprint */
+    matched = fgets(header, sizeof(header), file) != NULL
+              && strncmp(header, CHECKPOINT_TREE_HEADER, strlen(CHECKPOINT_TREE_HEADER)) == 0
+              && fscanf(file, "%d %d %" SCNu64 " %d %d", &n_nodes, &n_edges, &fingerprint, &tree->next_id,
+                        &tree->capacity) == 5
+              && n_nodes == checkpoint->n_nodes && n_edges == checkpoint->n_edges
+              && fingerprint == checkpoint->fingerprint
+              && tree->next_id >= 0 && tree->capacity >= 0;
+    if (matched) {
+        tree->perm = (int*) malloc(sizeof(int) * (size_t) n_nodes);
+        tree->active = (discorde_bb_node*) malloc(sizeof(discorde_bb_node) * (size_t) (tree->capacity + 1));
+        matched = tree->perm != NULL && tree->active != NULL;
+    }
+    for (i = 0; i < checkpoint->n_nodes && matched; ++i) {
+        matched = fscanf(file, "%d", &tree->perm[i]) == 1 && tree->perm[i] >= 0 && tree->perm[i] < n_nodes;
+    }
+    for (i = 0; i < tree->capacity && matched; ++i) {
+        matched = fscanf(file, "%d %d %lf", &tree->active[i].id, &tree->active[i].cut,
+                         &tree->active[i].lower_bound) == 3;
+    }
+    fclose(file);
+
+    if (!matched) {
+        discorde_bb_tree_free(tree);
+        return DISCORDE_RETURN_FAILURE;
+    }
+    tree->n_active = tree->capacity;
+
+    return DISCORDE_RETURN_OK;
+}
+
+void discorde_bb_tree_free(discorde_bb_tree *tree)
+{
+    free(tree->perm);
+    free(tree->active);
+    tree->perm = NULL;
+    tree->active = NULL;
+    tree->n_active = 0;
+    tree->capacity = 0;
+}
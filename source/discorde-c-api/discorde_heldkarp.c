@@ -0,0 +1,717 @@
+#include "discorde.h"
+#include "discorde_internal.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <float.h>
+
+
+/*
+ * Bounds of the number of 1-trees of the first period of the ascent. As in LKH, the first period is half the number of
+ * nodes, and each later period is half the previous one.
+ */
+#define ASCENT_PERIOD_MIN 100
+#define ASCENT_PERIOD_MAX 500
+
+/*
+ * Initial step size of the ascent, relative to the average cost of the edges of the first 1-tree.
+ */
+#define ASCENT_STEP 0.01
+
+/*
+ * Number of nodes per chunk of the parallel penalty updates.
+ */
+#define ASCENT_GRAIN 4096
+
+/*
+ * Number of nodes per chunk of the parallel search of the alpha-nearest neighbors.
+ */
+#define ALPHA_GRAIN 16
+
+/*
+ * Key of the nodes already in the tree: no modified cost is ever below it, so their key is never updated.
+ */
+#define ONETREE_IN_TREE (-DBL_MAX)
+
+/*
+ * Minimum 1-tree of a complete graph under node penalties: a spanning tree of the nodes but node 0, plus the two
+ * cheapest edges of node 0. The modified cost of edge (u,v) is {@code c(u,v) + pi[u] + pi[v]}. The tree is built by
+ * Prim's algorithm, either over the dense rows of costs or, with a heap, over a sparse graph.
+ */
+typedef struct onetree {
+    int n_nodes;
+    const discorde_costs* costs;
+    int* buffer;            /* Row filled by the row function */
+    double* key;            /* Cheapest modified cost of an edge joining each node to the tree */
+    int* parent;            /* Node of the tree joined by that edge; once built, the edges of the tree */
+    int* rest;              /* Nodes not yet in the tree (dense) */
+    int* order;             /* Nodes in the order they joined the tree (dense), from node 1 */
+    int* degree;            /* Degree of each node in the 1-tree */
+    int special[2];         /* Nodes joined to node 0 */
+
+    /* Sparse graph: the neighbors of node u, and the costs of their edges, are at [first[u], first[u + 1]) */
+    int* first;
+    int* neighbors;
+    int* weights;
+    int* heap;              /* Binary heap of the nodes reached but not yet in the tree, by key */
+    int* position;          /* Position of each node in the heap, or -1 */
+} onetree;
+
+/*
+ * Work shared by the threads that update the node penalties.
+ */
+typedef struct ascent_update {
+    const int* degree;
+    int* last;              /* Degree minus 2 of each node in the previous 1-tree */
+    double* pi;
+    double step;
+} ascent_update;
+
+static void onetree_free(onetree* tree)
+{
+    free(tree->buffer);
+    free(tree->key);
+    free(tree->parent);
+    free(tree->rest);
+    free(tree->order);
+    free(tree->degree);
+    free(tree->first);
+    free(tree->neighbors);
+    free(tree->weights);
+    free(tree->heap);
+    free(tree->position);
+}
+
+static int onetree_init(onetree* tree, const discorde_costs* costs)
+{
+    int n_nodes;
+
+    n_nodes = costs->n_nodes;
+    tree->n_nodes = n_nodes;
+    tree->costs = costs;
+    tree->buffer = (int*) malloc(sizeof(int) * (size_t) n_nodes);
+    tree->key = (double*) malloc(sizeof(double) * (size_t) n_nodes);
+    tree->parent = (int*) malloc(sizeof(int) * (size_t) n_nodes);
+    tree->rest = (int*) malloc(sizeof(int) * (size_t) n_nodes);
+    tree->order = (int*) malloc(sizeof(int) * (size_t) n_nodes);
+    tree->degree = (int*) malloc(sizeof(int) * (size_t) n_nodes);
+    tree->first = NULL;
+    tree->neighbors = NULL;
+    tree->weights = NULL;
+    tree->heap = NULL;
+    tree->position = NULL;
+    if (tree->buffer == NULL || tree->key == NULL || tree->parent == NULL || tree->rest == NULL
+        || tree->order == NULL || tree->degree == NULL) {
+        onetree_free(tree);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Relax the keys of every node by the edges of node {@code u}, which has just joined the tree. The nodes of the tree
+ * are skipped through their key, and the parent is selected by a mask as wide as the key, so the loop has no branch and
+ * is vectorized over the dense row.
+ */
+static void onetree_relax(int n_nodes, const int* row, const double* pi, double pi_u, int u, double* key, int* parent)
+{
+    int v, previous;
+    long mask;
+    double cost, current;
+
+    for (v = 0; v < n_nodes; ++v) {
+        cost = (double) row[v] + pi[v] + pi_u;
+        current = key[v];
+        previous = parent[v];
+        mask = -(long) (cost < current);
+        key[v] = (cost < current) ? cost : current;
+        parent[v] = previous + (int) (mask & (u - previous));
+    }
+}
+
+/*
+ * Join node 0 to the tree by its two cheapest edges to the {@code n_candidates} nodes {@code nodes} (all the nodes if
+ * it is NULL), whose costs to node 0 are {@code costs}, and return the modified cost of both edges.
+ */
+static double onetree_join_special(onetree* tree, const double* pi, int n_candidates, const int* nodes,
+                                   const int* costs)
+{
+    int k, v;
+    double cost, first, second;
+
+    first = DBL_MAX;
+    second = DBL_MAX;
+    tree->special[0] = 1;
+    tree->special[1] = 2;
+    for (k = 0; k < n_candidates; ++k) {
+        v = (nodes != NULL) ? nodes[k] : k;
+        if (v == 0) {
+            continue;
+        }
+        cost = (double) costs[k] + pi[v];
+        if (cost < first) {
+            second = first;
+            tree->special[1] = tree->special[0];
+            first = cost;
+            tree->special[0] = v;
+        } else if (cost < second && v != tree->special[0]) {
+            second = cost;
+            tree->special[1] = v;
+        }
+    }
+    tree->degree[0] = 2;
+    ++tree->degree[tree->special[0]];
+    ++tree->degree[tree->special[1]];
+
+    return first + second + 2 * pi[0];
+}
+
+/*
+ * Return the modified cost {@code length} of a 1-tree minus twice the sum of the penalties, i.e., the Held-Karp bound
+ * given by {@code pi}.
+ */
+static double onetree_bound(const onetree* tree, const double* pi, double length)
+{
+    int v;
+    double pi_sum;
+
+    pi_sum = 0;
+    for (v = 0; v < tree->n_nodes; ++v) {
+        pi_sum += pi[v];
+    }
+
+    return length - 2 * pi_sum;
+}
+
+/*
+ * Start a new 1-tree. Node 0 is joined by the special edges only, so it is kept out of the tree, which grows from
+ * node 1.
+ */
+static void onetree_reset(onetree* tree)
+{
+    int v;
+
+    for (v = 0; v < tree->n_nodes; ++v) {
+        tree->key[v] = DBL_MAX;
+        tree->parent[v] = -1;
+        tree->degree[v] = 0;
+    }
+    tree->key[0] = ONETREE_IN_TREE;
+    tree->key[1] = ONETREE_IN_TREE;
+}
+
+/*
+ * Build the minimum 1-tree under the penalties {@code pi} over the dense rows of costs, and return its bound.
+ */
+static double onetree_build_dense(onetree* tree, const double* pi)
+{
+    int i, k, u, v, n_rest;
+    double length;
+    const int* row;
+
+    onetree_reset(tree);
+    n_rest = 0;
+    for (v = 2; v < tree->n_nodes; ++v) {
+        tree->rest[n_rest++] = v;
+    }
+
+    /* Prim's algorithm from node 1: the cheapest node to join is looked up among the nodes left only */
+    length = 0;
+    u = 1;
+    tree->order[0] = 1;
+    while (n_rest > 0) {
+        row = tree->costs->row(tree->costs->arg, u, tree->buffer);
+        onetree_relax(tree->n_nodes, row, pi, pi[u], u, tree->key, tree->parent);
+
+        k = 0;
+        for (i = 1; i < n_rest; ++i) {
+            if (tree->key[tree->rest[i]] < tree->key[tree->rest[k]]) {
+                k = i;
+            }
+        }
+        u = tree->rest[k];
+        tree->rest[k] = tree->rest[--n_rest];
+        tree->order[tree->n_nodes - 1 - n_rest - 1] = u;
+
+        length += tree->key[u];
+        ++tree->degree[u];
+        ++tree->degree[tree->parent[u]];
+        tree->key[u] = ONETREE_IN_TREE;
+    }
+
+    row = tree->costs->row(tree->costs->arg, 0, tree->buffer);
+    length += onetree_join_special(tree, pi, tree->n_nodes, NULL, row);
+
+    return onetree_bound(tree, pi, length);
+}
+
+/*
+ * Move the node at position {@code i} of the heap up to its place.
+ */
+static void heap_up(onetree* tree, int i)
+{
+    int v, above;
+
+    v = tree->heap[i];
+    while (i > 0) {
+        above = (i - 1) / 2;
+        if (tree->key[tree->heap[above]] <= tree->key[v]) {
+            break;
+        }
+        tree->heap[i] = tree->heap[above];
+        tree->position[tree->heap[i]] = i;
+        i = above;
+    }
+    tree->heap[i] = v;
+    tree->position[v] = i;
+}
+
+/*
+ * Move the node at position {@code i} of a heap of {@code size} nodes down to its place.
+ */
+static void heap_down(onetree* tree, int i, int size)
+{
+    int v, below;
+
+    v = tree->heap[i];
+    for (;;) {
+        below = 2 * i + 1;
+        if (below >= size) {
+            break;
+        }
+        if (below + 1 < size && tree->key[tree->heap[below + 1]] < tree->key[tree->heap[below]]) {
+            ++below;
+        }
+        if (tree->key[v] <= tree->key[tree->heap[below]]) {
+            break;
+        }
+        tree->heap[i] = tree->heap[below];
+        tree->position[tree->heap[i]] = i;
+        i = below;
+    }
+    tree->heap[i] = v;
+    tree->position[v] = i;
+}
+
+/*
+ * Build the minimum 1-tree under the penalties {@code pi} over the sparse graph, and return its bound. The sparse graph
+ * holds a 1-tree, so the spanning tree always reaches every node.
+ */
+static double onetree_build_sparse(onetree* tree, const double* pi)
+{
+    int e, u, v, size;
+    double cost, length;
+
+    onetree_reset(tree);
+    for (v = 0; v < tree->n_nodes; ++v) {
+        tree->position[v] = -1;
+    }
+
+    /* Prim's algorithm from node 1 */
+    length = 0;
+    size = 0;
+    u = 1;
+    for (;;) {
+        for (e = tree->first[u]; e < tree->first[u + 1]; ++e) {
+            v = tree->neighbors[e];
+            cost = (double) tree->weights[e] + pi[u] + pi[v];
+            if (cost < tree->key[v]) {
+                tree->key[v] = cost;
+                tree->parent[v] = u;
+                if (tree->position[v] < 0) {
+                    tree->heap[size] = v;
+                    heap_up(tree, size++);
+                } else {
+                    heap_up(tree, tree->position[v]);
+                }
+            }
+        }
+        if (size == 0) {
+            break;
+        }
+
+        u = tree->heap[0];
+        tree->heap[0] = tree->heap[--size];
+        heap_down(tree, 0, size);
+
+        length += tree->key[u];
+        ++tree->degree[u];
+        ++tree->degree[tree->parent[u]];
+        tree->key[u] = ONETREE_IN_TREE;
+    }
+
+    length += onetree_join_special(tree, pi, tree->first[1] - tree->first[0], tree->neighbors + tree->first[0],
+                                   tree->weights + tree->first[0]);
+
+    return onetree_bound(tree, pi, length);
+}
+
+/*
+ * Build the sparse graph of the ascent out of the candidate edges and the edges of the 1-tree just built, so that it
+ * holds a 1-tree whatever the candidates. Each edge is stored at both of its ends. Returns {@code DISCORDE_RETURN_OK}
+ * on success, or {@code DISCORDE_RETURN_NO_MEMORY} otherwise.
+ */
+static int onetree_sparsify(onetree* tree)
+{
+    int k, u, v, cost;
+    int n_edges;
+    size_t n_entries;
+    const discorde_costs* costs;
+
+    costs = tree->costs;
+    n_edges = costs->n_edges;
+    n_entries = 2 * ((size_t) n_edges + (size_t) tree->n_nodes);
+    tree->first = (int*) calloc((size_t) tree->n_nodes + 1, sizeof(int));
+    tree->neighbors = (int*) malloc(sizeof(int) * n_entries);
+    tree->weights = (int*) malloc(sizeof(int) * n_entries);
+    tree->heap = (int*) malloc(sizeof(int) * (size_t) tree->n_nodes);
+    tree->position = (int*) malloc(sizeof(int) * (size_t) tree->n_nodes);
+    if (tree->first == NULL || tree->neighbors == NULL || tree->weights == NULL || tree->heap == NULL
+        || tree->position == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    /* The edges of the 1-tree are (parent[v], v) for v > 1, and the special edges, stored as those of nodes 0 and 1 */
+    tree->parent[0] = tree->special[0];
+    tree->parent[1] = tree->special[1];
+
+    /* Count the neighbors of each node, then place them */
+    for (k = 0; k < n_edges + tree->n_nodes; ++k) {
+        u = (k < n_edges) ? costs->edges[2 * k] : tree->parent[k - n_edges];
+        v = (k < n_edges) ? costs->edges[2 * k + 1] : ((k - n_edges == 1) ? 0 : k - n_edges);
+        ++tree->first[u + 1];
+        ++tree->first[v + 1];
+    }
+    for (v = 0; v < tree->n_nodes; ++v) {
+        tree->position[v] = tree->first[v];
+        tree->first[v + 1] += tree->first[v];
+    }
+    for (k = 0; k < n_edges + tree->n_nodes; ++k) {
+        u = (k < n_edges) ? costs->edges[2 * k] : tree->parent[k - n_edges];
+        v = (k < n_edges) ? costs->edges[2 * k + 1] : ((k - n_edges == 1) ? 0 : k - n_edges);
+        cost = costs->cost(costs->arg, u, v);
+        tree->neighbors[tree->position[u]] = v;
+        tree->weights[tree->position[u]++] = cost;
+        tree->neighbors[tree->position[v]] = u;
+        tree->weights[tree->position[v]++] = cost;
+    }
+
+    return DISCORDE_RETURN_OK;
+}
+
+/*
+ * Return whether every node has degree 2 in the 1-tree, i.e., the 1-tree is a tour (and its bound is optimal).
+ */
+static bool onetree_is_tour(const onetree* tree)
+{
+    int v;
+
+    for (v = 0; v < tree->n_nodes; ++v) {
+        if (tree->degree[v] != 2) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Move the penalties of the nodes {@code [begin, end)} along the subgradient, i.e., the degree minus 2 of each node in
+ * the 1-tree, blended with the subgradient of the previous 1-tree as in LKH.
+ */
+static void ascent_update_range(void* arg, int begin, int end)
+{
+    ascent_update* update;
+    int v, direction;
+
+    update = (ascent_update*) arg;
+    for (v = begin; v < end; ++v) {
+        direction = update->degree[v] - 2;
+        update->pi[v] += update->step * (0.7 * direction + 0.3 * update->last[v]);
+        update->last[v] = direction;
+    }
+}
+
+int discorde_held_karp_ascent(const discorde_costs* costs, int max_iterations, double time_limit, double* pi,
+                              double* out_bound)
+{
+
+    /* Auxiliary variables */
+    int v, p;
+    int n_nodes;
+    int return_value;
+    int iterations;         /* Number of 1-trees built */
+    int period;             /* Number of 1-trees of the current period */
+    int initial_period;
+    bool initial_phase;     /* Whether the step is still being doubled as long as the bound improves */
+    bool sparse;            /* Whether the 1-trees of the ascent are built over the sparse graph */
+    bool stop;
+    double start;
+    double bound;           /* Bound of the last 1-tree */
+    double best_bound;
+    double initial_bound;   /* Bound of the penalties given by the caller */
+    double* best_pi;        /* Penalties of the best bound */
+    double* initial_pi;
+
+    /* Structures of the ascent */
+    onetree tree;
+    ascent_update update;
+
+    n_nodes = costs->n_nodes;
+    best_pi = (double*) malloc(sizeof(double) * (size_t) n_nodes);
+    initial_pi = (double*) malloc(sizeof(double) * (size_t) n_nodes);
+    update.last = (int*) malloc(sizeof(int) * (size_t) n_nodes);
+    if (best_pi == NULL || initial_pi == NULL || update.last == NULL
+        || onetree_init(&tree, costs) != DISCORDE_RETURN_OK) {
+        free(best_pi);
+        free(initial_pi);
+        free(update.last);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+    start = discorde_wall_time();
+
+    /* First 1-tree, under the penalties given by the caller, over the dense rows */
+    initial_bound = onetree_build_dense(&tree, pi);
+    best_bound = initial_bound;
+    memcpy(best_pi, pi, sizeof(double) * (size_t) n_nodes);
+    memcpy(initial_pi, pi, sizeof(double) * (size_t) n_nodes);
+    iterations = 1;
+    for (v = 0; v < n_nodes; ++v) {
+        update.last[v] = tree.degree[v] - 2;
+    }
+    update.degree = tree.degree;
+    update.pi = pi;
+
+    /* The next ones are built over the candidate edges, if any, joined with the edges of the first one */
+    sparse = costs->n_edges > 0 && !onetree_is_tour(&tree);
+    return_value = sparse ? onetree_sparsify(&tree) : DISCORDE_RETURN_OK;
+
+    /* The step starts as a fraction of the average cost of an edge of the 1-tree */
+    update.step = ASCENT_STEP * (initial_bound / n_nodes);
+    if (update.step <= 0) {
+        update.step = ASCENT_STEP;
+    }
+    period = n_nodes / 2;
+    period = (period < ASCENT_PERIOD_MIN) ? ASCENT_PERIOD_MIN : period;
+    period = (period > ASCENT_PERIOD_MAX) ? ASCENT_PERIOD_MAX : period;
+    initial_period = period;
+    initial_phase = true;
+
+    /* Subgradient ascent, with the schedule of step sizes and periods of LKH. It stops once a 1-tree is a tour */
+    stop = return_value != DISCORDE_RETURN_OK || onetree_is_tour(&tree)
+           || (max_iterations > 0 && iterations >= max_iterations);
+    for (; !stop && period > 0; period /= 2, update.step /= 2) {
+        for (p = 1; !stop && p <= period; ++p) {
+            discorde_parallel_for(n_nodes, ASCENT_GRAIN, ascent_update_range, &update);
+            bound = sparse ? onetree_build_sparse(&tree, pi) : onetree_build_dense(&tree, pi);
+            ++iterations;
+
+            if (bound > best_bound) {
+                best_bound = bound;
+                memcpy(best_pi, pi, sizeof(double) * (size_t) n_nodes);
+                if (initial_phase) {
+                    update.step *= 2;
+                }
+                if (p == period) {
+                    period = (2 * period > initial_period) ? initial_period : 2 * period;
+                }
+            } else if (initial_phase && p > period / 2) {
+                initial_phase = false;
+                p = 0;
+                update.step *= 0.75;
+            }
+
+            stop = onetree_is_tour(&tree) || (max_iterations > 0 && iterations >= max_iterations)
+                   || (time_limit >= 0 && discorde_wall_time() - start >= time_limit);
+        }
+    }
+
+    /* A 1-tree over the sparse graph may cost more than the one over the complete graph, so the bound of the best
+     * penalties is that of a last 1-tree over the dense rows (kept only if it improves on the first one) */
+    memcpy(pi, best_pi, sizeof(double) * (size_t) n_nodes);
+    if (sparse && best_bound > initial_bound) {
+        best_bound = onetree_build_dense(&tree, pi);
+        if (best_bound < initial_bound) {
+            best_bound = initial_bound;
+            memcpy(pi, initial_pi, sizeof(double) * (size_t) n_nodes);
+        }
+    }
+    if (return_value == DISCORDE_RETURN_OK) {
+        *out_bound = best_bound;
+    }
+
+    /* Free resources */
+    onetree_free(&tree);
+    free(best_pi);
+    free(initial_pi);
+    free(update.last);
+
+    return return_value;
+}
+
+/*
+ * Work shared by the threads that look up the alpha-nearest neighbors of the nodes.
+ */
+typedef struct alpha_search {
+    const discorde_costs* costs;
+    const onetree* tree;
+    const double* pi;
+    const double* weight;   /* Modified cost of the edge joining each node to its parent in the tree */
+    double special_cost;    /* Modified cost of the dearer special edge */
+    int k;
+    int* neighbors;
+    char* failed;           /* Set for each chunk of ALPHA_GRAIN nodes whose buffers could not be allocated */
+} alpha_search;
+
+/*
+ * Find the alpha-nearest neighbors of the nodes {@code [begin, end)}. The alpha-value of edge (i,j) is the increase of
+ * the cost of the minimum 1-tree when it is forced to hold the edge, i.e., the modified cost of the edge minus the
+ * dearest edge on the path from i to j in the tree (beta), or minus the dearer special edge for the edges of node 0.
+ * As in LKH, the beta-values of node i to every node are found in a single pass over the nodes in the order they
+ * joined the tree, once those on the path from i to the root are set.
+ */
+static void alpha_rows(void* arg, int begin, int end)
+{
+    alpha_search* search;
+    const onetree* tree;
+    const double* pi;
+    const int* row;
+    int i, j, l, t, u, n_nodes, k, count, failed;
+    int* buffer;
+    int* mark;              /* Node whose path to the root has been walked last through each node */
+    int* best;              /* Neighbors of node i found so far, by increasing alpha-value and cost */
+    double alpha;
+    double* beta;
+    double* best_alpha;
+
+    search = (alpha_search*) arg;
+    tree = search->tree;
+    pi = search->pi;
+    n_nodes = tree->n_nodes;
+    k = search->k;
+    buffer = (int*) malloc(sizeof(int) * (size_t) n_nodes);
+    mark = (int*) malloc(sizeof(int) * (size_t) n_nodes);
+    beta = (double*) malloc(sizeof(double) * (size_t) n_nodes);
+    best = (int*) malloc(sizeof(int) * (size_t) k);
+    best_alpha = (double*) malloc(sizeof(double) * (size_t) k);
+    /* Each chunk has a flag of its own, read once all the threads have joined */
+    failed = buffer == NULL || mark == NULL || beta == NULL || best == NULL || best_alpha == NULL;
+    if (failed) {
+        search->failed[begin / ALPHA_GRAIN] = 1;
+    } else {
+        for (j = 0; j < n_nodes; ++j) {
+            mark[j] = -1;
+        }
+    }
+
+    for (i = begin; i < end && !failed; ++i) {
+
+        /* Beta-values of node i: first along its path to the root, then from the parent of each node */
+        if (i != 0) {
+            beta[i] = -DBL_MAX;
+            mark[i] = i;
+            for (u = i; u != 1; u = tree->parent[u]) {
+                beta[tree->parent[u]] = (beta[u] > search->weight[u]) ? beta[u] : search->weight[u];
+                mark[tree->parent[u]] = i;
+            }
+            for (t = 1; t < n_nodes - 1; ++t) {
+                j = tree->order[t];
+                if (mark[j] != i) {
+                    u = tree->parent[j];
+                    beta[j] = (beta[u] > search->weight[j]) ? beta[u] : search->weight[j];
+                }
+            }
+        }
+
+        /* The k smallest alpha-values, ties broken by cost */
+        row = search->costs->row(search->costs->arg, i, buffer);
+        count = 0;
+        for (j = 0; j < n_nodes; ++j) {
+            if (j == i) {
+                continue;
+            }
+            if (i != 0 && j != 0) {
+                alpha = (double) row[j] + pi[i] + pi[j] - beta[j];
+            } else {
+                u = i + j;  /* Endpoint other than node 0 */
+                alpha = (u == tree->special[0] || u == tree->special[1])
+                        ? 0 : (double) row[j] + pi[i] + pi[j] - search->special_cost;
+            }
+            if (count == k && (alpha > best_alpha[k - 1]
+                               || (alpha == best_alpha[k - 1] && row[j] >= row[best[k - 1]]))) {
+                continue;
+            }
+            l = (count < k) ? count++ : k - 1;
+            for (; l > 0 && (alpha < best_alpha[l - 1] || (alpha == best_alpha[l - 1] && row[j] < row[best[l - 1]]));
+                 --l) {
+                best_alpha[l] = best_alpha[l - 1];
+                best[l] = best[l - 1];
+            }
+            best_alpha[l] = alpha;
+            best[l] = j;
+        }
+        memcpy(search->neighbors + (size_t) i * k, best, sizeof(int) * (size_t) k);
+    }
+
+    free(buffer);
+    free(mark);
+    free(beta);
+    free(best);
+    free(best_alpha);
+}
+
+int discorde_alpha_nearest(const discorde_costs* costs, const double* pi, int k, int* out_neighbors)
+{
+
+    /* Auxiliary variables */
+    int v, u, return_value;
+    int n_nodes, n_chunks;
+    double* weight;
+
+    /* Structures of the search */
+    onetree tree;
+    alpha_search search;
+
+    n_nodes = costs->n_nodes;
+    n_chunks = (n_nodes + ALPHA_GRAIN - 1) / ALPHA_GRAIN;
+    weight = (double*) malloc(sizeof(double) * (size_t) n_nodes);
+    search.failed = (char*) calloc((size_t) n_chunks, sizeof(char));
+    if (weight == NULL || search.failed == NULL || onetree_init(&tree, costs) != DISCORDE_RETURN_OK) {
+        free(weight);
+        free(search.failed);
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    /* Minimum 1-tree under the penalties, over the dense rows */
+    onetree_build_dense(&tree, pi);
+    weight[0] = 0;
+    weight[1] = 0;
+    for (v = 2; v < n_nodes; ++v) {
+        u = tree.parent[v];
+        weight[v] = (double) costs->cost(costs->arg, u, v) + pi[u] + pi[v];
+    }
+
+    search.costs = costs;
+    search.tree = &tree;
+    search.pi = pi;
+    search.weight = weight;
+    search.special_cost = (double) costs->cost(costs->arg, 0, tree.special[1]) + pi[0] + pi[tree.special[1]];
+    search.k = k;
+    search.neighbors = out_neighbors;
+    discorde_parallel_for(n_nodes, ALPHA_GRAIN, alpha_rows, &search);
+
+    return_value = DISCORDE_RETURN_OK;
+    for (v = 0; v < n_chunks; ++v) {
+        if (search.failed[v]) {
+            return_value = DISCORDE_RETURN_NO_MEMORY;
+        }
+    }
+
+    /* Free resources */
+    onetree_free(&tree);
+    free(weight);
+    free(search.failed);
+
+    return return_value;
+}
@@ -0,0 +1,269 @@
+#ifndef DISCORDE_INTERNAL_H
+#define DISCORDE_INTERNAL_H
+
+/*
+ * Internal helpers shared by the translation units of Discorde C API. This header is not installed.
+ */
+
+#include "discorde.h"
+#include <stdio.h>
+#include <stdint.h>
+
+
+/**
+ * Function applied by {@code discorde_parallel_for} to each range of items {@code [begin, end)}.
+ */
+typedef void (*discorde_range_fn)(void *arg, int begin, int end);
+
+/**
+ * Return the number of worker threads used by Discorde, i.e., the number of online processors (at least 1).
+ */
+int discorde_num_threads(void);
+
+/**
+ * Return the time in seconds of a monotonic wall clock. Unlike the CPU time used by Concorde for its time limits, it
+ * does not run faster when several threads are busy.
+ */
+double discorde_wall_time(void);
+
+/**
+ * Apply {@code fn} to the items {@code [0, n_items)} split into chunks of {@code grain} items. The chunks are handed
+ * out dynamically to up to {@code discorde_num_threads()} threads, including the calling one. The function returns
+ * when all items have been processed. If threads cannot be created, the remaining work runs on the calling thread.
+ */
+void discorde_parallel_for(int n_items, int grain, discorde_range_fn fn, void *arg);
+
+/**
+ * Make the parallel loops started by the calling thread run serially on it (if {@code serial} is non-zero), or restore
+ * the default behavior. It is used by threads that are themselves workers of a pool, to avoid oversubscription. Returns
+ * the previous setting of the calling thread, so that it can be restored.
+ */
+int discorde_parallel_set_serial(int serial);
+
+/**
+ * Solve a job of a batch as {@code concorde_full} or {@code linkernighan_full} (or their flat and packed variants)
+ * would, except that its time limit is measured on the wall clock: the Lin-Kernighan heuristic runs as a single chain
+ * of short slices, and the time bound of Concorde is zeroed by a timer at the deadline. Sets {@code out_status} and
+ * returns the return value of the job.
+ */
+int discorde_solve_job(discorde_job *job);
+
+/**
+ * Function that gives the costs of the edges (u, v) of a complete graph for every node v, as a row of {@code n_nodes}
+ * entries (the entry of u itself is ignored). It either fills {@code buffer} and returns it, or returns a row it holds.
+ */
+typedef const int *(*discorde_row_fn)(void *arg, int u, int *buffer);
+
+/**
+ * Function that gives the cost of the edge (u, v).
+ */
+typedef int (*discorde_cost_fn)(void *arg, int u, int v);
+
+/**
+ * Costs of a complete graph of {@code n_nodes} nodes, given both row by row and edge by edge, along with
+ * {@code n_edges} candidate edges (pairs of nodes in {@code edges}) among which the edges of short tours are likely to
+ * be found. Without candidates ({@code n_edges} is 0), only the rows are used.
+ */
+typedef struct discorde_costs {
+    int n_nodes;
+    discorde_row_fn row;
+    discorde_cost_fn cost;
+    void *arg;
+    int n_edges;
+    const int *edges;
+} discorde_costs;
+
+/**
+ * Subgradient ascent of Held and Karp over the node penalties {@code pi} of the minimum 1-tree of a complete graph.
+ * The 1-trees of the ascent are built over the candidate edges joined with the edges of a first 1-tree of the complete
+ * graph, and the bound of the best penalties is that of a last 1-tree of the complete graph, so it is always valid.
+ * The ascent starts from the penalties given in {@code pi}, and leaves there those of the best bound, stored in
+ * {@code out_bound}. It stops once a 1-tree is a tour, after {@code max_iterations} 1-trees (no limit if it is not
+ * positive) or after {@code time_limit} seconds of wall-clock time (no limit if it is negative). Returns
+ * {@code DISCORDE_RETURN_OK} on success, or {@code DISCORDE_RETURN_NO_MEMORY} otherwise.
+ */
+int discorde_held_karp_ascent(const discorde_costs *costs, int max_iterations, double time_limit, double *pi,
+                              double *out_bound);
+
+/**
+ * Find the {@code k} alpha-nearest neighbors of each node of a complete graph, as in LKH: the alpha-value of an edge is
+ * the increase of the cost of the minimum 1-tree under the penalties {@code pi} when it is forced to hold the edge. The
+ * neighbors of node i are stored at {@code [i * k, (i + 1) * k)} of {@code out_neighbors}, by increasing alpha-value
+ * (ties broken by cost), so {@code k} must be less than {@code n_nodes}. Returns {@code DISCORDE_RETURN_OK} on
+ * success, or {@code DISCORDE_RETURN_NO_MEMORY} otherwise.
+ */
+int discorde_alpha_nearest(const discorde_costs *costs, const double *pi, int k, int *out_neighbors);
+
+/**
+ * Stop signals of a run registered with a monitor, so that cancelling the monitor raises them: the time bound of a
+ * Concorde run, set to zero (Concorde reads it between the nodes of its branch-and-bound, so it returns its best tour
+ * at the next one, but not before its root LP is done), and the stop flag of a branch-and-bound driven by Discorde, set
+ * to 1 and polled between its nodes. Either may be NULL. The caller owns the storage of the entry.
+ *
+ * The signals are written by the cancelling thread while the run reads them without a lock. The stop flag is only
+ * accessed with atomic builtins, so it is free of data races. The time bound is a known data race: Concorde reads it
+ * through a plain pointer, in code Discorde does not build, and it is the only way to stop CCtsp_solve_dat or
+ * CCtsp_solve_sparse before they return. It is zeroed with an atomic store (see {@code discorde_stop_time_bound}), so
+ * the store is never torn, but nothing orders it with the reads of Concorde: a stale read delays the stop to a later
+ * check, and a compiler that inlined the checks of Concorde into one loop (e.g., under link-time optimization of both
+ * libraries together) could miss it. Calls that must be cancelled reliably run the branch-and-bound driver of
+ * Discorde, which polls the stop flag.
+ */
+typedef struct discorde_watch {
+    double *time_bound;
+    int *stop;
+    struct discorde_watch *next;
+} discorde_watch;
+
+/**
+ * Register {@code time_bound} and {@code stop} (either may be NULL) with {@code monitor}; they are raised at once if
+ * the monitor is already cancelled. It does nothing if {@code monitor} is {@code NULL}.
+ */
+void discorde_monitor_watch(discorde_monitor *monitor, discorde_watch *watch, double *time_bound, int *stop);
+
+/**
+ * Zero the time bound of a Concorde run from another thread, so that Concorde returns its best tour at its next check
+ * of the bound, between two nodes of its branch-and-bound (see {@code discorde_watch} for the race this entails).
+ */
+void discorde_stop_time_bound(double *time_bound);
+
+/**
+ * Remove an entry registered with {@code discorde_monitor_watch}. It does nothing if {@code monitor} is {@code NULL}.
+ */
+void discorde_monitor_unwatch(discorde_monitor *monitor, discorde_watch *watch);
+
+/**
+ * Fire the callback of {@code monitor} (if any) for a new best tour. The wall-clock time elapsed is measured from
+ * {@code start} (as given by {@code discorde_wall_time}). The calls of the callback never overlap, and the monitor is
+ * cancelled if it returns a non-zero value. It does nothing if {@code monitor} is {@code NULL}.
+ */
+void discorde_monitor_report(discorde_monitor *monitor, int n_nodes, const int *tour, double cost,
+                             bool lower_bound_known, double lower_bound, double start);
+
+/**
+ * Size of the buffers of the paths of the scratch directory of a Concorde run and of the name of its files.
+ */
+#define DISCORDE_SCRATCH_PATH_SIZE 1024
+
+/**
+ * Scratch directory of a Concorde run: its path, the name given to Concorde for its files, and the descriptor of the
+ * lock file held by the run while the directory is in use, which tells the sweeps of other runs that it is alive.
+ */
+typedef struct discorde_scratch {
+    char directory[DISCORDE_SCRATCH_PATH_SIZE];
+    char filename[DISCORDE_SCRATCH_PATH_SIZE];
+    int lock;
+} discorde_scratch;
+
+/**
+ * Create the scratch directory of a Concorde run under the scratch directory of the process (see
+ * {@code discorde_set_scratch_dir}), with a name drawn from the host, the process id, {@code call_id} and a random
+ * nonce, and lock it. Returns {@code DISCORDE_RETURN_OK} on success, or {@code DISCORDE_RETURN_FAILURE} if the
+ * directory could not be created.
+ */
+int discorde_scratch_open(unsigned long call_id, discorde_scratch *scratch);
+
+/**
+ * Remove the scratch directory of a Concorde run and every file created in it, and release its lock.
+ */
+void discorde_scratch_close(discorde_scratch *scratch);
+
+/**
+ * Checkpoint of a solver call: the file where the best tour found is saved, the files of the branch-and-bound tree
+ * (its frontier, its cut pool and the problem files of its active nodes), and the fingerprint of the instance, which
+ * ties the files to it.
+ */
+typedef struct discorde_checkpoint {
+    char path[DISCORDE_SCRATCH_PATH_SIZE];          /* Checkpoint file */
+    char temp_path[DISCORDE_SCRATCH_PATH_SIZE];     /* File written before it is renamed over the checkpoint file */
+    char tree_path[DISCORDE_SCRATCH_PATH_SIZE];     /* Frontier of the branch-and-bound tree */
+    char tree_temp_path[DISCORDE_SCRATCH_PATH_SIZE];
+    char pool_path[DISCORDE_SCRATCH_PATH_SIZE];     /* Cut pool of the branch-and-bound, written by Concorde */
+    char pool_temp_path[DISCORDE_SCRATCH_PATH_SIZE];
+    char problems[DISCORDE_SCRATCH_PATH_SIZE];      /* Directory of the problem files of the active nodes */
+    char problem_name[DISCORDE_SCRATCH_PATH_SIZE];  /* Name given to Concorde for its problem files */
+    int n_nodes;
+    int n_edges;
+    uint64_t fingerprint;                           /* 64-bit hash of the sizes, the edges and the costs */
+    int written;                                    /* Set to 1 once a tour has been written by this call */
+    double cost;                                    /* Cost of the last tour written */
+    int failed;                                     /* Set to 1 if a write has failed */
+} discorde_checkpoint;
+
+/**
+ * Active node of a branch-and-bound tree: the id of its problem file, whether its cutting loop has run (it is then
+ * waiting to be branched on) and its lower bound.
+ */
+typedef struct discorde_bb_node {
+    int id;
+    int cut;
+    double lower_bound;
+} discorde_bb_node;
+
+/**
+ * Frontier of a branch-and-bound tree: the labelling of the nodes of the instance given to Concorde (node i of the
+ * problems is node perm[i] of the instance), the id of the next problem file and the active nodes.
+ */
+typedef struct discorde_bb_tree {
+    int *perm;
+    int next_id;
+    int n_active;
+    int capacity;
+    discorde_bb_node *active;
+} discorde_bb_tree;
+
+/**
+ * Free the arrays of a tree read by {@code discorde_checkpoint_read_tree}.
+ */
+void discorde_bb_tree_free(discorde_bb_tree *tree);
+
+/**
+ * Initialize the checkpoint of an instance given by a list of edges, saved in {@code directory}. Returns
+ * {@code DISCORDE_RETURN_OK} on success, or {@code DISCORDE_RETURN_FAILURE} if the directory is not writable or its
+ * path is too long.
+ */
+int discorde_checkpoint_init(discorde_checkpoint *checkpoint, const char *directory, int n_nodes, int n_edges,
+                             const int *edges, const int *edges_costs);
+
+/**
+ * Read the tour saved in a checkpoint, its cost and whether it is optimal. Returns {@code DISCORDE_RETURN_OK} on
+ * success, or {@code DISCORDE_RETURN_FAILURE} if there is no checkpoint or it belongs to another instance.
+ */
+int discorde_checkpoint_read(const discorde_checkpoint *checkpoint, int *tour, double *cost, bool *optimal);
+
+/**
+ * Save a tour of the instance to the checkpoint file, unless a better one (or an optimal one of the same cost) has
+ * already been saved by this call. Returns {@code DISCORDE_RETURN_OK} on success; a failed write is also flagged in
+ * the checkpoint.
+ */
+int discorde_checkpoint_write(discorde_checkpoint *checkpoint, const int *tour, double cost, bool optimal);
+
+/**
+ * Flush a file written to {@code temp_path} to the disk, close it, rename it over {@code path} and sync the directory
+ * of {@code path}, so a process killed or a machine crashed meanwhile leaves the previous file intact. Returns
+ * {@code DISCORDE_RETURN_OK} on success; otherwise the temporary file is removed if it has not been renamed yet.
+ */
+int discorde_checkpoint_commit(FILE *file, int failed, const char *temp_path, const char *path);
+
+/**
+ * Remove the branch-and-bound tree of a checkpoint (its tree file, its pool and its problem files), and create its
+ * problems directory if needed. Returns {@code DISCORDE_RETURN_OK} on success, or {@code DISCORDE_RETURN_FAILURE} if
+ * the problems directory cannot be created.
+ */
+int discorde_checkpoint_reset(const discorde_checkpoint *checkpoint);
+
+/**
+ * Save the frontier of a branch-and-bound tree to the tree file of a checkpoint. The pool and the problem files of
+ * the active nodes must already be on disk. Returns {@code DISCORDE_RETURN_OK} on success; a failed write is also
+ * flagged in the checkpoint.
+ */
+int discorde_checkpoint_write_tree(discorde_checkpoint *checkpoint, const discorde_bb_tree *tree);
+
+/**
+ * Read the frontier of a branch-and-bound tree saved in a checkpoint, allocating its arrays (its capacity is its
+ * number of active nodes). Returns {@code DISCORDE_RETURN_OK} on success, or {@code DISCORDE_RETURN_FAILURE} if
+ * there is no tree, it belongs to another instance or memory runs out.
+ */
+int discorde_checkpoint_read_tree(const discorde_checkpoint *checkpoint, discorde_bb_tree *tree);
+
+#endif /* DISCORDE_INTERNAL_H */
@@ -0,0 +1,165 @@
+#include "discorde.h"
+#include "discorde_internal.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+
+/*
+ * Monitor of solver calls: the callback fired on every new best tour and the cancellation token. The stop signals of
+ * the runs in progress are kept in a list, so a cancellation can raise them.
+ */
+struct discorde_monitor {
+    pthread_mutex_t lock;           /* Guards the flag and the list of time bounds */
+    pthread_mutex_t report_lock;    /* Serializes the calls of the callback */
+    discorde_callback callback;
+    void* user_data;
+    int cancelled;
+    discorde_watch* watches;        /* Stop signals of the runs in progress */
+};
+
+
+/*
+ * Raise the stop signals of an entry (see discorde_internal.h for the unlocked accesses of the runs).
+ */
+static void monitor_raise(discorde_watch* watch)
+{
+    if (watch->time_bound != NULL) {
+        discorde_stop_time_bound(watch->time_bound);
+    }
+    if (watch->stop != NULL) {
+        __atomic_store_n(watch->stop, 1, __ATOMIC_RELAXED);
+    }
+}
+
+void discorde_stop_time_bound(double* time_bound)
+{
+    double zero;
+
+    zero = 0;
+    __atomic_store(time_bound, &zero, __ATOMIC_RELAXED);
+}
+
+int discorde_monitor_create(discorde_callback callback, void* user_data, discorde_monitor** out_monitor)
+{
+    discorde_monitor* monitor;
+
+    monitor = (discorde_monitor*) malloc(sizeof(discorde_monitor));
+    *out_monitor = monitor;
+    if (monitor == NULL) {
+        return DISCORDE_RETURN_NO_MEMORY;
+    }
+
+    pthread_mutex_init(&monitor->lock, NULL);
+    pthread_mutex_init(&monitor->report_lock, NULL);
+    monitor->callback = callback;
+    monitor->user_data = user_data;
+    monitor->cancelled = 0;
+    monitor->watches = NULL;
+
+    return DISCORDE_RETURN_OK;
+}
+
+void discorde_monitor_cancel(discorde_monitor* monitor)
+{
+    discorde_watch* watch;
+
+    pthread_mutex_lock(&monitor->lock);
+    monitor->cancelled = 1;
+    for (watch = monitor->watches; watch != NULL; watch = watch->next) {
+        monitor_raise(watch);
+    }
+    pthread_mutex_unlock(&monitor->lock);
+}
+
+bool discorde_monitor_cancelled(discorde_monitor* monitor)
+{
+    int cancelled;
+
+    if (monitor == NULL) {
+        return false;
+    }
+
+    pthread_mutex_lock(&monitor->lock);
+    cancelled = monitor->cancelled;
+    pthread_mutex_unlock(&monitor->lock);
+
+    return cancelled != 0;
+}
+
+void discorde_monitor_reset(discorde_monitor* monitor)
+{
+    pthread_mutex_lock(&monitor->lock);
+    monitor->cancelled = 0;
+    pthread_mutex_unlock(&monitor->lock);
+}
+
+void discorde_monitor_free(discorde_monitor* monitor)
+{
+    if (monitor == NULL) {
+        return;
+    }
+
+    pthread_mutex_destroy(&monitor->lock);
+    pthread_mutex_destroy(&monitor->report_lock);
+    free(monitor);
+}
+
+void discorde_monitor_watch(discorde_monitor* monitor, discorde_watch* watch, double* time_bound, int* stop)
+{
+    if (monitor == NULL) {
+        return;
+    }
+
+    watch->time_bound = time_bound;
+    watch->stop = stop;
+    pthread_mutex_lock(&monitor->lock);
+    if (monitor->cancelled) {
+        monitor_raise(watch);
+    }
+    watch->next = monitor->watches;
+    monitor->watches = watch;
+    pthread_mutex_unlock(&monitor->lock);
+}
+
+void discorde_monitor_unwatch(discorde_monitor* monitor, discorde_watch* watch)
+{
+    discorde_watch** link;
+
+    if (monitor == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&monitor->lock);
+    for (link = &monitor->watches; *link != NULL; link = &(*link)->next) {
+        if (*link == watch) {
+            *link = watch->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&monitor->lock);
+}
+
+void discorde_monitor_report(discorde_monitor* monitor, int n_nodes, const int* tour, double cost,
+                             bool lower_bound_known, double lower_bound, double start)
+{
+    discorde_progress progress;
+
+    if (monitor == NULL || monitor->callback == NULL) {
+        return;
+    }
+
+    progress.n_nodes = n_nodes;
+    progress.tour = tour;
+    progress.cost = cost;
+    progress.lower_bound_known = lower_bound_known;
+    progress.lower_bound = lower_bound_known ? lower_bound : 0;
+    progress.elapsed = discorde_wall_time() - start;
+
+    /* A non-zero return value of the callback cancels the calls monitored */
+    pthread_mutex_lock(&monitor->report_lock);
+    if (monitor->callback(&progress, monitor->user_data) != 0) {
+        discorde_monitor_cancel(monitor);
+    }
+    pthread_mutex_unlock(&monitor->report_lock);
+}
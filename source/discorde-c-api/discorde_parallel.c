@@ -0,0 +1,146 @@
+#include "discorde_internal.h"
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+
+
+/*
+ * Shared state of a parallel loop: the next chunk is taken under the mutex.
+ */
+typedef struct parallel_loop {
+    pthread_mutex_t mutex;
+    int next;
+    int n_items;
+    int grain;
+    discorde_range_fn fn;
+    void* arg;
+} parallel_loop;
+
+
+/*
+ * Thread-specific flag set by the threads that must run parallel loops serially (workers of a batch).
+ */
+static pthread_key_t serial_key;
+static pthread_once_t serial_once = PTHREAD_ONCE_INIT;
+
+static void serial_key_create(void)
+{
+    pthread_key_create(&serial_key, NULL);
+}
+
+int discorde_parallel_set_serial(int serial)
+{
+    static int serial_flag = 1;
+    int previous;
+
+    pthread_once(&serial_once, serial_key_create);
+    previous = pthread_getspecific(serial_key) != NULL;
+    pthread_setspecific(serial_key, serial ? &serial_flag : NULL);
+
+    return previous;
+}
+
+static int parallel_is_serial(void)
+{
+    pthread_once(&serial_once, serial_key_create);
+    return pthread_getspecific(serial_key) != NULL;
+}
+
+int discorde_num_threads(void)
+{
+    long n_threads;
+
+    n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n_threads < 1) {
+        n_threads = 1;
+    }
+
+    return (int) n_threads;
+}
+
+double discorde_wall_time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec * 1e-9;
+}
+
+static void* parallel_worker(void* data)
+{
+    parallel_loop* loop;
+    int begin, end;
+
+    loop = (parallel_loop*) data;
+    for (;;) {
+
+        /* Take the next chunk */
+        pthread_mutex_lock(&loop->mutex);
+        begin = loop->next;
+        end = (loop->n_items - begin > loop->grain) ? begin + loop->grain : loop->n_items;
+        loop->next = end;
+        pthread_mutex_unlock(&loop->mutex);
+
+        if (begin >= end) {
+            break;
+        }
+        loop->fn(loop->arg, begin, end);
+    }
+
+    return NULL;
+}
+
+void discorde_parallel_for(int n_items, int grain, discorde_range_fn fn, void* arg)
+{
+
+    /* Auxiliary variables */
+    int i, n_threads, n_started;
+    pthread_t* threads;
+    parallel_loop loop;
+
+    if (n_items <= 0) {
+        return;
+    }
+    if (grain < 1) {
+        grain = 1;
+    }
+
+    /* Do not start more threads than chunks (nor any thread if the caller runs loops serially) */
+    n_threads = parallel_is_serial() ? 1 : discorde_num_threads();
+    if (n_threads > (n_items + grain - 1) / grain) {
+        n_threads = (n_items + grain - 1) / grain;
+    }
+    if (n_threads <= 1) {
+        fn(arg, 0, n_items);
+        return;
+    }
+
+    loop.next = 0;
+    loop.n_items = n_items;
+    loop.grain = grain;
+    loop.fn = fn;
+    loop.arg = arg;
+    pthread_mutex_init(&loop.mutex, NULL);
+
+    /* Start the helper threads (the calling thread is also a worker) */
+    n_started = 0;
+    threads = (pthread_t*) malloc(sizeof(pthread_t) * (n_threads - 1));
+    if (threads != NULL) {
+        for (i = 0; i < n_threads - 1; ++i) {
+            if (pthread_create(&threads[n_started], NULL, parallel_worker, &loop) == 0) {
+                ++n_started;
+            }
+        }
+    }
+
+    parallel_worker(&loop);
+
+    /* Wait for the helper threads */
+    for (i = 0; i < n_started; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    free(threads);
+    pthread_mutex_destroy(&loop.mutex);
+}
@@ -0,0 +1,254 @@
+#include "discorde.h"
+#include "discorde_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+
+/*
+ * Length of the longest name of a call directory, "discorde_<host>_<pid>_<call id>_<nonce>/concorde" (with room for the
+ * names Concorde derives from it).
+ */
+#define SCRATCH_NAME_MAX 128
+
+/*
+ * Longest part of the host name kept in the name of a call directory.
+ */
+#define SCRATCH_HOST_MAX 32
+
+/*
+ * Number of names tried for the directory of a call before giving up.
+ */
+#define SCRATCH_ATTEMPTS 16
+
+/*
+ * File held locked (flock) by the run owning a call directory for as long as it runs. The lock is released by the
+ * system when the run dies, whatever its host or pid namespace, so a directory whose lock can be taken is stale.
+ */
+#define SCRATCH_LOCK_FILE "lock"
+
+/*
+ * Scratch directory set by the caller, or an empty string to use the default one. The directories of the calls of the
+ * process are created under it and the directories left behind by dead runs are swept once per process (and again
+ * when it changes).
+ */
+static char scratch_base[DISCORDE_SCRATCH_PATH_SIZE - SCRATCH_NAME_MAX] = "";
+static int scratch_swept = 0;
+static pthread_mutex_t scratch_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Return whether {@code path} is a directory where files can be created.
+ */
+static int scratch_writable(const char* path)
+{
+    struct stat info;
+
+    return path != NULL && path[0] != '\0' && stat(path, &info) == 0 && S_ISDIR(info.st_mode)
+           && access(path, W_OK | X_OK) == 0;
+}
+
+/*
+ * Write the default scratch directory: the shared memory file system if available (so the files of Concorde stay in
+ * memory), else the directory given by TMPDIR, else /tmp, else the working directory.
+ */
+static void scratch_default(char* base)
+{
+    const char* tmpdir;
+
+    tmpdir = getenv("TMPDIR");
+    if (scratch_writable("/dev/shm")) {
+        strcpy(base, "/dev/shm");
+    } else if (scratch_writable(tmpdir) && strlen(tmpdir) < DISCORDE_SCRATCH_PATH_SIZE - SCRATCH_NAME_MAX) {
+        strcpy(base, tmpdir);
+    } else if (scratch_writable("/tmp")) {
+        strcpy(base, "/tmp");
+    } else {
+        strcpy(base, ".");
+    }
+}
+
+/*
+ * Remove the files of a call directory and the directory itself.
+ */
+static void scratch_remove(const char* directory)
+{
+    DIR* dir;
+    struct dirent* entry;
+    char path[DISCORDE_SCRATCH_PATH_SIZE];
+
+    dir = opendir(directory);
+    if (dir != NULL) {
+        while ((entry = readdir(dir)) != NULL) {
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+                continue;
+            }
+            if (strlen(directory) + strlen(entry->d_name) + 2 <= sizeof(path)) {
+                sprintf(path, "%s/%s", directory, entry->d_name);
+                unlink(path);
+            }
+        }
+        closedir(dir);
+    }
+    rmdir(directory);
+}
+
+/*
+ * Remove the call directories left under {@code base} by runs that are no longer running, i.e., whose lock file is not
+ * held by anyone. A directory without a lock file may be in the middle of its creation, so it is left alone.
+ */
+static void scratch_sweep(const char* base)
+{
+    DIR* dir;
+    struct dirent* entry;
+    int lock;
+    char path[DISCORDE_SCRATCH_PATH_SIZE];
+    char lock_path[DISCORDE_SCRATCH_PATH_SIZE + sizeof(SCRATCH_LOCK_FILE) + 1];
+
+    dir = opendir(base);
+    if (dir == NULL) {
+        return;
+    }
+
+    while ((entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, "discorde_", 9) != 0 || strlen(base) + strlen(entry->d_name) + 2 > sizeof(path)) {
+            continue;
+        }
+        sprintf(path, "%s/%s", base, entry->d_name);
+        sprintf(lock_path, "%s/%s", path, SCRATCH_LOCK_FILE);
+        lock = open(lock_path, O_RDWR);
+        if (lock == -1) {
+            continue;
+        }
+        if (flock(lock, LOCK_EX | LOCK_NB) == 0) {
+            scratch_remove(path);
+        }
+        close(lock);
+    }
+
+    closedir(dir);
+}
+
+/*
+ * Write to {@code host} the name of the host, with the characters other than letters, digits and '-' replaced, so that
+ * runs sharing a scratch directory from several hosts (e.g., over NFS) never pick the same names.
+ */
+static void scratch_host(char* host)
+{
+    int i;
+
+    if (gethostname(host, SCRATCH_HOST_MAX + 1) != 0) {
+        strcpy(host, "host");
+    }
+    host[SCRATCH_HOST_MAX] = '\0';
+    for (i = 0; host[i] != '\0'; ++i) {
+        if (!((host[i] >= 'a' && host[i] <= 'z') || (host[i] >= 'A' && host[i] <= 'Z')
+              || (host[i] >= '0' && host[i] <= '9') || host[i] == '-')) {
+            host[i] = '-';
+        }
+    }
+}
+
+/*
+ * Random component of the name of a call directory, mixed from the real time clock, the process id, the call id and
+ * the attempt. Processes that share the pid and the call ids (e.g., containers that all run as pid 1) still differ in
+ * it; an unlucky collision is caught by mkdir, and the next attempt draws another name.
+ */
+static unsigned long scratch_nonce(unsigned long call_id, int attempt)
+{
+    struct timespec now;
+    unsigned long z;
+
+    clock_gettime(CLOCK_REALTIME, &now);
+    z = (unsigned long) now.tv_nsec ^ ((unsigned long) now.tv_sec << 30) ^ ((unsigned long) getpid() << 12);
+    z ^= call_id * 0x9E3779B9UL + (unsigned long) attempt;
+    z = ((z >> 16) ^ z) * 0x45D9F3BUL;
+    z = ((z >> 16) ^ z) * 0x45D9F3BUL;
+    z = (z >> 16) ^ z;
+
+    return z & 0xFFFFFFFFUL;
+}
+
+int discorde_set_scratch_dir(const char* path)
+{
+    if (path != NULL && (strlen(path) >= DISCORDE_SCRATCH_PATH_SIZE - SCRATCH_NAME_MAX || !scratch_writable(path))) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    pthread_mutex_lock(&scratch_lock);
+    strcpy(scratch_base, (path != NULL) ? path : "");
+    scratch_swept = 0;
+    pthread_mutex_unlock(&scratch_lock);
+
+    return DISCORDE_RETURN_OK;
+}
+
+int discorde_scratch_open(unsigned long call_id, discorde_scratch* scratch)
+{
+    char base[DISCORDE_SCRATCH_PATH_SIZE - SCRATCH_NAME_MAX];
+    char name[SCRATCH_NAME_MAX - 24];   /* Name of the call directory (the rest is left to the names of its files) */
+    char host[SCRATCH_HOST_MAX + 1];
+    char lock_path[DISCORDE_SCRATCH_PATH_SIZE];
+    int sweep, attempt, created, lock;
+
+    pthread_mutex_lock(&scratch_lock);
+    if (scratch_base[0] != '\0') {
+        strcpy(base, scratch_base);
+    } else {
+        scratch_default(base);
+    }
+    sweep = !scratch_swept;
+    scratch_swept = 1;
+    pthread_mutex_unlock(&scratch_lock);
+
+    if (sweep) {
+        scratch_sweep(base);
+    }
+
+    /* The host and the process id tell apart the processes sharing the directory, the call id the calls of a process,
+     * and the nonce the processes that share both (a name left by a dead run is never reused: another one is drawn) */
+    scratch_host(host);
+    created = 0;
+    for (attempt = 0; attempt < SCRATCH_ATTEMPTS && !created; ++attempt) {
+        sprintf(name, "discorde_%s_%ld_%lu_%08lx", host, (long) getpid(), call_id, scratch_nonce(call_id, attempt));
+        sprintf(scratch->directory, "%s/%s", base, name);
+        if (mkdir(scratch->directory, 0700) == 0) {
+            created = 1;
+        } else if (errno != EEXIST) {
+            return DISCORDE_RETURN_FAILURE;
+        }
+    }
+    if (!created) {
+        return DISCORDE_RETURN_FAILURE;
+    }
+
+    /* The lock file is locked before it gets its name, so a sweep never finds it unlocked while the run is alive */
+    sprintf(scratch->filename, "%s/%s/%s.new", base, name, SCRATCH_LOCK_FILE);
+    sprintf(lock_path, "%s/%s/%s", base, name, SCRATCH_LOCK_FILE);
+    lock = open(scratch->filename, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (lock == -1 || flock(lock, LOCK_EX) != 0 || rename(scratch->filename, lock_path) != 0) {
+        if (lock != -1) {
+            close(lock);
+        }
+        scratch_remove(scratch->directory);
+        return DISCORDE_RETURN_FAILURE;
+    }
+    scratch->lock = lock;
+    sprintf(scratch->filename, "%s/%s/concorde", base, name);
+
+    return DISCORDE_RETURN_OK;
+}
+
+void discorde_scratch_close(discorde_scratch* scratch)
+{
+    scratch_remove(scratch->directory);
+    close(scratch->lock);
+}
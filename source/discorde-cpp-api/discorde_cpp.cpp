@@ -1,7 +1,55 @@
 #include "discorde_cpp.h"
 #include <discorde.h>
+#include <new>
 
 
+int discorde::discorde_set_scratch_dir(const char* path)
+{
+    return ::discorde_set_scratch_dir(path);
+}
+
+int discorde::discorde_graph_strided(int n_nodes, int n_edges, const int* edges, size_t edges_stride,
+                                     const int* edges_costs, size_t costs_stride, discorde_graph** out_graph)
+{
+    return ::discorde_graph_strided(n_nodes, n_edges, edges, edges_stride, edges_costs, costs_stride, out_graph);
+}
+
+int discorde::discorde_graph_csr(int n_nodes, const int* offsets, const int* targets, const int* weights,
+                                 discorde_graph** out_graph)
+{
+    return ::discorde_graph_csr(n_nodes, offsets, targets, weights, out_graph);
+}
+
+void discorde::discorde_graph_free(discorde_graph* graph)
+{
+    ::discorde_graph_free(graph);
+}
+
+int discorde::discorde_monitor_create(discorde_callback callback, void* user_data, discorde_monitor** out_monitor)
+{
+    return ::discorde_monitor_create(callback, user_data, out_monitor);
+}
+
+void discorde::discorde_monitor_cancel(discorde_monitor* monitor)
+{
+    ::discorde_monitor_cancel(monitor);
+}
+
+bool discorde::discorde_monitor_cancelled(discorde_monitor* monitor)
+{
+    return ::discorde_monitor_cancelled(monitor);
+}
+
+void discorde::discorde_monitor_reset(discorde_monitor* monitor)
+{
+    ::discorde_monitor_reset(monitor);
+}
+
+void discorde::discorde_monitor_free(discorde_monitor* monitor)
+{
+    ::discorde_monitor_free(monitor);
+}
+
 int discorde::concorde(int n_nodes, int n_edges, int* edges, int* edges_costs,
                        int* out_tour, double* out_cost, int* out_status, int* in_tour,
                        bool verbose, double* time_limit, double* target)
@@ -10,6 +58,14 @@ int discorde::concorde(int n_nodes, int n_edges, int* edges, int* edges_costs,
                       out_status, in_tour, verbose, time_limit, target);
 }
 
+int discorde::concorde_monitored(int n_nodes, int n_edges, int* edges, int* edges_costs, discorde_monitor* monitor,
+                                 int* out_tour, double* out_cost, int* out_status, int* in_tour,
+                                 bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_monitored(n_nodes, n_edges, edges, edges_costs, monitor, out_tour, out_cost,
+                                out_status, in_tour, verbose, time_limit, target);
+}
+
 int discorde::concorde_sparse(int n_nodes, int n_edges, int** edges,
                               int* edges_costs, int* out_tour, double* out_cost, int* out_status,
                               int* in_tour, bool verbose, double* time_limit, double* target)
@@ -18,6 +74,13 @@ int discorde::concorde_sparse(int n_nodes, int n_edges, int** edges,
                              out_cost, out_status, in_tour, verbose, time_limit, target);
 }
 
+int discorde::concorde_graph(const discorde_graph* graph,
+                             int* out_tour, double* out_cost, int* out_status, int* in_tour,
+                             bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_graph(graph, out_tour, out_cost, out_status, in_tour, verbose, time_limit, target);
+}
+
 int discorde::concorde_full(int n_nodes, int** cost_matrix,
                             int* out_tour, double* out_cost, int* out_status,
                             int* in_tour, bool verbose, double* time_limit, double* target)
@@ -26,6 +89,181 @@ int discorde::concorde_full(int n_nodes, int** cost_matrix,
                            in_tour, verbose, time_limit, target);
 }
 
+int discorde::concorde_full_monitored(int n_nodes, int** cost_matrix, discorde_monitor* monitor,
+                                      int* out_tour, double* out_cost, int* out_status,
+                                      int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_full_monitored(n_nodes, cost_matrix, monitor, out_tour, out_cost, out_status,
+                                     in_tour, verbose, time_limit, target);
+}
+
+int discorde::concorde_full_flat(int n_nodes, const int* cost_matrix,
+                                 int* out_tour, double* out_cost, int* out_status,
+                                 int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_full_flat(n_nodes, cost_matrix, out_tour, out_cost, out_status,
+                                in_tour, verbose, time_limit, target);
+}
+
+int discorde::concorde_full_packed(int n_nodes, const int* cost_matrix,
+                                   int* out_tour, double* out_cost, int* out_status,
+                                   int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_full_packed(n_nodes, cost_matrix, out_tour, out_cost, out_status,
+                                  in_tour, verbose, time_limit, target);
+}
+
+int discorde::concorde_coords(int n_nodes, double* x, double* y, double* z, int norm,
+                              int* out_tour, double* out_cost, int* out_status,
+                              int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_coords(n_nodes, x, y, z, norm, out_tour, out_cost, out_status,
+                             in_tour, verbose, time_limit, target);
+}
+
+int discorde::concorde_portfolio(int n_nodes, int n_edges, int* edges, int* edges_costs, int n_chains,
+                                 int* out_tour, double* out_cost, int* out_status,
+                                 int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_portfolio(n_nodes, n_edges, edges, edges_costs, n_chains, out_tour, out_cost,
+                                out_status, in_tour, verbose, time_limit, target);
+}
+
+int discorde::concorde_full_portfolio(int n_nodes, int** cost_matrix, int n_chains,
+                                      int* out_tour, double* out_cost, int* out_status,
+                                      int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_full_portfolio(n_nodes, cost_matrix, n_chains, out_tour, out_cost, out_status,
+                                     in_tour, verbose, time_limit, target);
+}
+
+int discorde::concorde_coords_portfolio(int n_nodes, double* x, double* y, double* z, int norm, int n_chains,
+                                        int* out_tour, double* out_cost, int* out_status,
+                                        int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_coords_portfolio(n_nodes, x, y, z, norm, n_chains, out_tour, out_cost, out_status,
+                                       in_tour, verbose, time_limit, target);
+}
+
+int discorde::concorde_checkpoint(int n_nodes, int n_edges, int* edges, int* edges_costs, const char* checkpoint_dir,
+                                  int* out_tour, double* out_cost, int* out_status,
+                                  int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_checkpoint(n_nodes, n_edges, edges, edges_costs, checkpoint_dir, out_tour, out_cost,
+                                 out_status, in_tour, verbose, time_limit, target);
+}
+
+int discorde::concorde_resume(int n_nodes, int n_edges, int* edges, int* edges_costs, const char* checkpoint_dir,
+                              int* out_tour, double* out_cost, int* out_status,
+                              bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_resume(n_nodes, n_edges, edges, edges_costs, checkpoint_dir, out_tour, out_cost,
+                             out_status, verbose, time_limit, target);
+}
+
+int discorde::discorde_cutpool_create(discorde_cutpool** out_pool)
+{
+    return ::discorde_cutpool_create(out_pool);
+}
+
+void discorde::discorde_cutpool_free(discorde_cutpool* pool)
+{
+    ::discorde_cutpool_free(pool);
+}
+
+int discorde::discorde_cutpool_size(const discorde_cutpool* pool)
+{
+    return ::discorde_cutpool_size(pool);
+}
+
+int discorde::concorde_pooled(int n_nodes, int n_edges, int* edges, int* edges_costs, discorde_cutpool* pool,
+                              int* out_tour, double* out_cost, int* out_status,
+                              int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_pooled(n_nodes, n_edges, edges, edges_costs, pool, out_tour, out_cost, out_status,
+                             in_tour, verbose, time_limit, target);
+}
+
+int discorde::discorde_reopt_create(int n_nodes, int n_edges, const int* edges, const int* edges_costs,
+                                   discorde_reopt** out_reopt)
+{
+    return ::discorde_reopt_create(n_nodes, n_edges, edges, edges_costs, out_reopt);
+}
+
+void discorde::discorde_reopt_free(discorde_reopt* reopt)
+{
+    ::discorde_reopt_free(reopt);
+}
+
+int discorde::discorde_reopt_update(discorde_reopt* reopt, int n_updates, const int* edge_ids, const int* new_costs)
+{
+    return ::discorde_reopt_update(reopt, n_updates, edge_ids, new_costs);
+}
+
+int discorde::discorde_reopt_solve(discorde_reopt* reopt, int* out_tour, double* out_cost, int* out_status,
+                                   bool verbose, double* time_limit, double* target)
+{
+    return ::discorde_reopt_solve(reopt, out_tour, out_cost, out_status, verbose, time_limit, target);
+}
+
+int discorde::discorde_cache_open(const char* path, size_t max_bytes, discorde_cache** out_cache)
+{
+    return ::discorde_cache_open(path, max_bytes, out_cache);
+}
+
+void discorde::discorde_cache_close(discorde_cache* cache)
+{
+    ::discorde_cache_close(cache);
+}
+
+int discorde::concorde_cached(discorde_cache* cache, int n_nodes, int n_edges, int* edges, int* edges_costs,
+                              int* out_tour, double* out_cost, int* out_status,
+                              int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_cached(cache, n_nodes, n_edges, edges, edges_costs, out_tour, out_cost, out_status, in_tour,
+                             verbose, time_limit, target);
+}
+
+int discorde::concorde_full_cached(discorde_cache* cache, int n_nodes, int** cost_matrix,
+                                   int* out_tour, double* out_cost, int* out_status,
+                                   int* in_tour, bool verbose, double* time_limit, double* target)
+{
+    return ::concorde_full_cached(cache, n_nodes, cost_matrix, out_tour, out_cost, out_status, in_tour, verbose,
+                                  time_limit, target);
+}
+
+int discorde::discorde_lower_bound(int n_nodes, int n_edges, int* edges, int* edges_costs, int mode, double* out_bound,
+                                   double* out_x, double* out_time, bool verbose)
+{
+    return ::discorde_lower_bound(n_nodes, n_edges, edges, edges_costs, mode, out_bound, out_x, out_time, verbose);
+}
+
+int discorde::discorde_lower_bound_full(int n_nodes, int** cost_matrix, int mode, double* out_bound, double* out_x,
+                                        double* out_time, bool verbose)
+{
+    return ::discorde_lower_bound_full(n_nodes, cost_matrix, mode, out_bound, out_x, out_time, verbose);
+}
+
+int discorde::discorde_held_karp_full(int n_nodes, int** cost_matrix, int max_iterations, double* time_limit,
+                                      double* out_bound, double* out_pi, double* out_time)
+{
+    return ::discorde_held_karp_full(n_nodes, cost_matrix, max_iterations, time_limit, out_bound, out_pi, out_time);
+}
+
+int discorde::discorde_held_karp_full_flat(int n_nodes, const int* cost_matrix, int max_iterations, double* time_limit,
+                                           double* out_bound, double* out_pi, double* out_time)
+{
+    return ::discorde_held_karp_full_flat(n_nodes, cost_matrix, max_iterations, time_limit, out_bound, out_pi,
+                                          out_time);
+}
+
+int discorde::discorde_held_karp_coords(int n_nodes, double* x, double* y, double* z, int norm, int max_iterations,
+                                        double* time_limit, double* out_bound, double* out_pi, double* out_time)
+{
+    return ::discorde_held_karp_coords(n_nodes, x, y, z, norm, max_iterations, time_limit, out_bound, out_pi,
+                                       out_time);
+}
+
 int discorde::linkernighan(int n_nodes, int n_edges, int* edges,
                            int* edges_costs, int* out_tour, double* out_cost, int* in_tour,
                            bool verbose, double* time_limit, double* target)
@@ -34,6 +272,23 @@ int discorde::linkernighan(int n_nodes, int n_edges, int* edges,
                           out_cost, in_tour, verbose, time_limit, target);
 }
 
+int discorde::linkernighan_monitored(int n_nodes, int n_edges, int* edges, int* edges_costs,
+                                     discorde_monitor* monitor, int* out_tour, double* out_cost, int* in_tour,
+                                     bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_monitored(n_nodes, n_edges, edges, edges_costs, monitor, out_tour,
+                                    out_cost, in_tour, verbose, time_limit, target);
+}
+
+int discorde::linkernighan_multistart(int n_nodes, int n_edges, int* edges, int* edges_costs,
+                                      int n_chains, const int* seeds, const int* kick_types,
+                                      int* out_tour, double* out_cost, int* in_tour,
+                                      bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_multistart(n_nodes, n_edges, edges, edges_costs, n_chains, seeds, kick_types,
+                                     out_tour, out_cost, in_tour, verbose, time_limit, target);
+}
+
 int discorde::linkernighan_sparse(int n_nodes, int n_edges, int** edges,
                                   int* edges_costs, int* out_tour, double* out_cost, int* in_tour,
                                   bool verbose, double* time_limit, double* target)
@@ -42,6 +297,13 @@ int discorde::linkernighan_sparse(int n_nodes, int n_edges, int** edges,
                                  out_cost, in_tour, verbose, time_limit, target);
 }
 
+int discorde::linkernighan_graph(const discorde_graph* graph,
+                                 int* out_tour, double* out_cost, int* in_tour,
+                                 bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_graph(graph, out_tour, out_cost, in_tour, verbose, time_limit, target);
+}
+
 int discorde::linkernighan_full(int n_nodes, int** cost_matrix,
                                 int* out_tour, double* out_cost, int* in_tour,
                                 bool verbose, double* time_limit, double* target)
@@ -49,3 +311,212 @@ int discorde::linkernighan_full(int n_nodes, int** cost_matrix,
     return ::linkernighan_full(n_nodes, cost_matrix, out_tour, out_cost, in_tour,
                                verbose, time_limit, target);
 }
+
+int discorde::linkernighan_full_monitored(int n_nodes, int** cost_matrix, discorde_monitor* monitor,
+                                          int* out_tour, double* out_cost, int* in_tour,
+                                          bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_full_monitored(n_nodes, cost_matrix, monitor, out_tour, out_cost, in_tour,
+                                         verbose, time_limit, target);
+}
+
+int discorde::linkernighan_full_flat(int n_nodes, const int* cost_matrix,
+                                     int* out_tour, double* out_cost, int* in_tour,
+                                     bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_full_flat(n_nodes, cost_matrix, out_tour, out_cost, in_tour,
+                                    verbose, time_limit, target);
+}
+
+int discorde::linkernighan_full_packed(int n_nodes, const int* cost_matrix,
+                                       int* out_tour, double* out_cost, int* in_tour,
+                                       bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_full_packed(n_nodes, cost_matrix, out_tour, out_cost, in_tour,
+                                      verbose, time_limit, target);
+}
+
+int discorde::linkernighan_full_knn(int n_nodes, int** cost_matrix, int k_nearest,
+                                    int* out_tour, double* out_cost, int* in_tour,
+                                    bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_full_knn(n_nodes, cost_matrix, k_nearest, out_tour, out_cost, in_tour,
+                                   verbose, time_limit, target);
+}
+
+int discorde::linkernighan_full_alpha(int n_nodes, int** cost_matrix, int k_alpha,
+                                      int* out_tour, double* out_cost, int* in_tour,
+                                      bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_full_alpha(n_nodes, cost_matrix, k_alpha, out_tour, out_cost, in_tour,
+                                     verbose, time_limit, target);
+}
+
+int discorde::linkernighan_coords(int n_nodes, double* x, double* y, double* z, int norm,
+                                  int* out_tour, double* out_cost, int* in_tour,
+                                  bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_coords(n_nodes, x, y, z, norm, out_tour, out_cost, in_tour,
+                                 verbose, time_limit, target);
+}
+
+int discorde::linkernighan_coords_alpha(int n_nodes, double* x, double* y, double* z, int norm, int k_alpha,
+                                        int* out_tour, double* out_cost, int* in_tour,
+                                        bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_coords_alpha(n_nodes, x, y, z, norm, k_alpha, out_tour, out_cost, in_tour,
+                                       verbose, time_limit, target);
+}
+
+int discorde::linkernighan_full_multistart(int n_nodes, int** cost_matrix, int k_nearest,
+                                           int n_chains, const int* seeds, const int* kick_types,
+                                           int* out_tour, double* out_cost, int* in_tour,
+                                           bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_full_multistart(n_nodes, cost_matrix, k_nearest, n_chains, seeds, kick_types,
+                                          out_tour, out_cost, in_tour, verbose, time_limit, target);
+}
+
+int discorde::linkernighan_coords_multistart(int n_nodes, double* x, double* y, double* z, int norm,
+                                             int n_chains, const int* seeds, const int* kick_types,
+                                             int* out_tour, double* out_cost, int* in_tour,
+                                             bool verbose, double* time_limit, double* target)
+{
+    return ::linkernighan_coords_multistart(n_nodes, x, y, z, norm, n_chains, seeds, kick_types,
+                                            out_tour, out_cost, in_tour, verbose, time_limit, target);
+}
+
+int discorde::discorde_dyntour_create(int n_nodes, int** cost_matrix, int tour_length, const int* tour,
+                                      int k_nearest, int repair_radius, discorde_dyntour** out_dyntour)
+{
+    return ::discorde_dyntour_create(n_nodes, cost_matrix, tour_length, tour, k_nearest, repair_radius, out_dyntour);
+}
+
+void discorde::discorde_dyntour_free(discorde_dyntour* dyntour)
+{
+    ::discorde_dyntour_free(dyntour);
+}
+
+int discorde::discorde_dyntour_insert(discorde_dyntour* dyntour, int n_insert, const int* nodes, bool regret)
+{
+    return ::discorde_dyntour_insert(dyntour, n_insert, nodes, regret);
+}
+
+int discorde::discorde_dyntour_remove(discorde_dyntour* dyntour, int node)
+{
+    return ::discorde_dyntour_remove(dyntour, node);
+}
+
+int discorde::discorde_dyntour_length(const discorde_dyntour* dyntour)
+{
+    return ::discorde_dyntour_length(dyntour);
+}
+
+void discorde::discorde_dyntour_get(const discorde_dyntour* dyntour, int* out_tour, double* out_cost)
+{
+    ::discorde_dyntour_get(dyntour, out_tour, out_cost);
+}
+
+int discorde::discorde_warmstore_create(discorde_warmstore** out_store)
+{
+    return ::discorde_warmstore_create(out_store);
+}
+
+void discorde::discorde_warmstore_free(discorde_warmstore* store)
+{
+    ::discorde_warmstore_free(store);
+}
+
+int discorde::discorde_warmstore_save(discorde_warmstore* store, int n_nodes, const long* node_ids, const int* tour)
+{
+    return ::discorde_warmstore_save(store, n_nodes, node_ids, tour);
+}
+
+int discorde::discorde_warmstore_project(const discorde_warmstore* store, int n_nodes, const long* node_ids,
+                                         int n_edges, int* edges, int* edges_costs, int* out_tour)
+{
+    return ::discorde_warmstore_project(store, n_nodes, node_ids, n_edges, edges, edges_costs, out_tour);
+}
+
+int discorde::discorde_warmstore_project_full(const discorde_warmstore* store, int n_nodes, const long* node_ids,
+                                              int** cost_matrix, int* out_tour)
+{
+    return ::discorde_warmstore_project_full(store, n_nodes, node_ids, cost_matrix, out_tour);
+}
+
+void discorde::discorde_job_init(discorde_job* job)
+{
+    ::discorde_job_init(job);
+}
+
+int discorde::solve_batch(std::vector<discorde_job>& jobs, int n_threads)
+{
+    if (jobs.empty()) {
+        return DISCORDE_RETURN_OK;
+    }
+
+    return ::discorde_solve_batch(&jobs[0], (int) jobs.size(), n_threads);
+}
+
+discorde::Solver::Solver()
+{
+    if (::discorde_context_create(&context_) != DISCORDE_RETURN_OK) {
+        throw std::bad_alloc();
+    }
+}
+
+discorde::Solver::~Solver()
+{
+    ::discorde_context_free(context_);
+}
+
+void discorde::Solver::set_verbose(bool verbose)
+{
+    ::discorde_context_set_verbose(context_, verbose);
+}
+
+void discorde::Solver::set_time_limit(const double* time_limit)
+{
+    ::discorde_context_set_time_limit(context_, time_limit);
+}
+
+void discorde::Solver::set_target(const double* target)
+{
+    ::discorde_context_set_target(context_, target);
+}
+
+void discorde::Solver::set_seed(int seed)
+{
+    ::discorde_context_set_seed(context_, seed);
+}
+
+int discorde::Solver::concorde(int n_nodes, int n_edges, int* edges, int* edges_costs,
+                               int* out_tour, double* out_cost, int* out_status, int* in_tour)
+{
+    return ::discorde_context_concorde(context_, n_nodes, n_edges, edges, edges_costs,
+                                       out_tour, out_cost, out_status, in_tour);
+}
+
+int discorde::Solver::concorde_full(int n_nodes, int** cost_matrix,
+                                    int* out_tour, double* out_cost, int* out_status, int* in_tour)
+{
+    return ::discorde_context_concorde_full(context_, n_nodes, cost_matrix, out_tour, out_cost, out_status, in_tour);
+}
+
+int discorde::Solver::linkernighan(int n_nodes, int n_edges, int* edges, int* edges_costs,
+                                   int* out_tour, double* out_cost, int* in_tour)
+{
+    return ::discorde_context_linkernighan(context_, n_nodes, n_edges, edges, edges_costs,
+                                           out_tour, out_cost, in_tour);
+}
+
+int discorde::Solver::linkernighan_full(int n_nodes, int** cost_matrix,
+                                        int* out_tour, double* out_cost, int* in_tour)
+{
+    return ::discorde_context_linkernighan_full(context_, n_nodes, cost_matrix, out_tour, out_cost, in_tour);
+}
+
+discorde_context* discorde::Solver::context()
+{
+    return context_;
+}
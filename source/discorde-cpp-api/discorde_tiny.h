@@ -0,0 +1,499 @@
+#ifndef DISCORDE_TINY_H
+#define DISCORDE_TINY_H
+
+#include "discorde_cpp.h"
+
+
+/**
+ * Exact solver for tiny instances (at most 16 nodes), header-only: the dynamic program of Held and Karp with the
+ * number of nodes fixed at compile time, so its loops have constant bounds and its table has a fixed layout. It runs
+ * no Concorde code at all, which makes it the fastest path for the micro-routes solved in bulk.
+ */
+namespace discorde {
+
+namespace tiny {
+
+    /**
+     * Largest number of nodes of an instance solved by {@code discorde::tiny::solve}.
+     */
+    const int MAX_NODES = 16;
+
+    /**
+     * Largest number of nodes of an instance whose table is kept on the stack by {@code discorde::tiny::solve}. The
+     * table of a larger instance (up to 4 MB) is allocated on the heap.
+     */
+    const int MAX_STACK_NODES = 10;
+
+    /**
+     * Exact solver of the instances of {@code N} nodes. The table of the dynamic program is a member of the engine,
+     * so an engine kept by the caller solves instance after instance without allocating anything. An engine may be
+     * used by one thread at a time.
+     */
+    template <int N>
+    class Engine {
+
+    public:
+
+        /**
+         * Solve an instance of {@code N} nodes to optimality.
+         *
+         * @param   cost_matrix
+         *          A array of dimension {@code N} by {@code N}, either an {@code int[N][N]} array or an {@code int**}
+         *          array of rows. It is an upper triangular matrix where the element {@code cost_matrix[i][j]}, with
+         *          {@code i < j}, is the cost (weight) of the edges (i,j) and (j,i).
+         * @param   out_tour
+         *          An array of length {@code N} to store the optimal tour.
+         * @param   out_cost
+         *          A pointer to a {@code double} variable to store the cost of the optimal tour.
+         *
+         * @return  {@code DISCORDE_RETURN_OK}.
+         */
+        template <typename Matrix>
+        int solve(const Matrix& cost_matrix, int* out_tour, double* out_cost);
+
+    private:
+
+        enum {
+            M = (N > 1) ? N - 1 : 1,        /* Nodes of the paths of the table; they start at node N - 1 */
+            SETS = 1 << M                   /* Subsets of those nodes */
+        };
+
+        /* Compile-time check of the number of nodes */
+        typedef char size_check[(N >= 1 && N <= MAX_NODES) ? 1 : -1];
+
+        /* Cost of a path through a node out of its set: large, but far from overflowing when added to a cost */
+        static double unreachable() { return 1e300; }
+
+        /* Symmetric copy of the costs */
+        double cost_[M + 1][M + 1];
+
+        /* best_[set][j]: cheapest path from node N - 1 through the nodes of set ending at node j, or unreachable() if
+         * j is out of set (which keeps the predecessors of the inner loop free of branches) */
+        double best_[SETS][M];
+    };
+
+    template <int N>
+    template <typename Matrix>
+    int Engine<N>::solve(const Matrix& cost_matrix, int* out_tour, double* out_cost)
+    {
+        int i, j, k, last;
+        unsigned int set, prev;
+        double value, cost;
+
+        if (N == 1) {
+            out_tour[0] = 0;
+            *out_cost = 0;
+            return DISCORDE_RETURN_OK;
+        }
+
+        for (i = 0; i < N; ++i) {
+            cost_[i][i] = 0;
+            for (j = i + 1; j < N; ++j) {
+                cost_[i][j] = cost_matrix[i][j];
+                cost_[j][i] = cost_matrix[i][j];
+            }
+        }
+
+        /* Each set extends the paths of the sets with one node less. Since the costs are symmetric, the predecessors
+         * of node j and their costs to it are two contiguous rows, so the inner loop is a branchless min-reduction
+         * the compiler turns into SIMD code */
+        for (set = 1; set < (unsigned int) SETS; ++set) {
+            for (j = 0; j < M; ++j) {
+                if ((set & (1u << j)) == 0) {
+                    best_[set][j] = unreachable();
+                } else if (set == (1u << j)) {
+                    best_[set][j] = cost_[M][j];
+                } else {
+                    const double* from = best_[set ^ (1u << j)];
+                    const double* into = cost_[j];
+                    value = unreachable();
+                    for (k = 0; k < M; ++k) {
+                        cost = from[k] + into[k];
+                        value = (cost < value) ? cost : value;
+                    }
+                    best_[set][j] = value;
+                }
+            }
+        }
+
+        /* Close the cheapest path through all nodes back to its start */
+        set = (unsigned int) SETS - 1;
+        last = 0;
+        value = unreachable();
+        for (j = 0; j < M; ++j) {
+            cost = best_[set][j] + cost_[j][M];
+            if (cost < value) {
+                value = cost;
+                last = j;
+            }
+        }
+        *out_cost = value;
+
+        /* Walk the path back: the costs are integers, so the predecessor of each node matches its entry exactly */
+        out_tour[0] = M;
+        for (i = M; i >= 1; --i) {
+            out_tour[i] = last;
+            prev = set ^ (1u << last);
+            for (k = 0; prev != 0 && k < M; ++k) {
+                if ((prev & (1u << k)) != 0 && best_[prev][k] + cost_[k][last] == best_[set][last]) {
+                    break;
+                }
+            }
+            set = prev;
+            last = k;
+        }
+
+        return DISCORDE_RETURN_OK;
+    }
+
+    /**
+     * Run an engine on the stack (small tables) or on the heap (large ones).
+     */
+    template <int N, bool Stack = (N <= MAX_STACK_NODES)>
+    struct Run {
+        template <typename Matrix>
+        static int solve(const Matrix& cost_matrix, int* out_tour, double* out_cost)
+        {
+            Engine<N> engine;
+            return engine.solve(cost_matrix, out_tour, out_cost);
+        }
+    };
+
+    template <int N>
+    struct Run<N, false> {
+        template <typename Matrix>
+        static int solve(const Matrix& cost_matrix, int* out_tour, double* out_cost)
+        {
+            Engine<N>* engine;
+            int return_value;
+
+            engine = new Engine<N>;
+            return_value = engine->solve(cost_matrix, out_tour, out_cost);
+            delete engine;
+
+            return return_value;
+        }
+    };
+
+    /**
+     * Solve an instance of {@code N} nodes (at most {@code discorde::tiny::MAX_NODES}) to optimality, with an engine
+     * of its own. See {@code discorde::tiny::Engine::solve} for the arguments and the return value.
+     */
+    template <int N, typename Matrix>
+    int solve(const Matrix& cost_matrix, int* out_tour, double* out_cost)
+    {
+        return Run<N>::solve(cost_matrix, out_tour, out_cost);
+    }
+
+    /**
+     * Solve an instance of at most {@code discorde::tiny::MAX_NODES} nodes to optimality, dispatching on its number of
+     * nodes to the engine compiled for it.
+     *
+     * @param   n_nodes
+     *          Number of nodes.
+     * @param   cost_matrix
+     *          A array of dimension {@code n_nodes} by {@code n_nodes}, as in {@code discorde::concorde_full}.
+     * @param   out_tour
+     *          An array of length {@code n_nodes} to store the optimal tour.
+     * @param   out_cost
+     *          A pointer to a {@code double} variable to store the cost of the optimal tour.
+     *
+     * @return  {@code DISCORDE_RETURN_OK} if the instance has been solved, or {@code DISCORDE_RETURN_TOO_LARGE} if it
+     *          has more than {@code discorde::tiny::MAX_NODES} nodes (or no node).
+     */
+    inline int solve(int n_nodes, int** cost_matrix, int* out_tour, double* out_cost)
+    {
+        switch (n_nodes) {
+            case 1:  return solve<1>(cost_matrix, out_tour, out_cost);
+            case 2:  return solve<2>(cost_matrix, out_tour, out_cost);
+            case 3:  return solve<3>(cost_matrix, out_tour, out_cost);
+            case 4:  return solve<4>(cost_matrix, out_tour, out_cost);
+            case 5:  return solve<5>(cost_matrix, out_tour, out_cost);
+            case 6:  return solve<6>(cost_matrix, out_tour, out_cost);
+            case 7:  return solve<7>(cost_matrix, out_tour, out_cost);
+            case 8:  return solve<8>(cost_matrix, out_tour, out_cost);
+            case 9:  return solve<9>(cost_matrix, out_tour, out_cost);
+            case 10: return solve<10>(cost_matrix, out_tour, out_cost);
+            case 11: return solve<11>(cost_matrix, out_tour, out_cost);
+            case 12: return solve<12>(cost_matrix, out_tour, out_cost);
+            case 13: return solve<13>(cost_matrix, out_tour, out_cost);
+            case 14: return solve<14>(cost_matrix, out_tour, out_cost);
+            case 15: return solve<15>(cost_matrix, out_tour, out_cost);
+            case 16: return solve<16>(cost_matrix, out_tour, out_cost);
+            default: return DISCORDE_RETURN_TOO_LARGE;
+        }
+    }
+
+
+    /**
+     * Largest number of nodes of the instances solved by {@code discorde::tiny::solve_batch}.
+     */
+    const int MAX_BATCH_NODES = 12;
+
+    /**
+     * Number of instances solved together by {@code discorde::tiny::BatchEngine}, one per lane of its table.
+     */
+    const int BATCH_LANES = 16;
+
+    /**
+     * Largest absolute cost of an edge of an instance solved in the lanes of {@code discorde::tiny::BatchEngine}: its
+     * table holds 32-bit integers, and the costs of the paths of 12 nodes must not overflow them. A group of instances
+     * with a larger cost is solved one instance at a time by {@code discorde::tiny::Engine} instead.
+     */
+    const int MAX_BATCH_COST = 1 << 26;
+
+    /**
+     * Exact solver of batches of instances of {@code N} nodes (at most {@code discorde::tiny::MAX_BATCH_NODES}). The
+     * instances are solved {@code discorde::tiny::BATCH_LANES} at a time, laid out structure-of-arrays: each entry of
+     * the table holds one value per instance, and all the instances follow the same control flow since they have the
+     * same size, so the innermost loop runs over the lanes and the compiler vectorizes it. The entries are 32-bit
+     * integers, so a group fills one AVX-512 vector or two AVX2 vectors, and the table (up to 1.4 MB) takes half the
+     * cache lines it would with doubles. An engine may be used by one thread at a time.
+     */
+    template <int N>
+    class BatchEngine {
+
+    public:
+
+        /**
+         * Solve a batch of instances of {@code N} nodes to optimality.
+         *
+         * @param   n_instances
+         *          Number of instances.
+         * @param   cost_matrices
+         *          An array of length {@code n_instances} with the cost matrices, each as in
+         *          {@code discorde::tiny::Engine::solve}.
+         * @param   out_tours
+         *          An array of length {@code n_instances * N} to store the optimal tours, the tour of instance
+         *          {@code i} starting at {@code out_tours[i * N]}.
+         * @param   out_costs
+         *          An array of length {@code n_instances} to store the costs of the optimal tours.
+         *
+         * @return  {@code DISCORDE_RETURN_OK}.
+         */
+        template <typename Matrix>
+        int solve(int n_instances, const Matrix* cost_matrices, int* out_tours, double* out_costs);
+
+    private:
+
+        enum {
+            M = (N > 1) ? N - 1 : 1,        /* Nodes of the paths of the table; they start at node N - 1 */
+            SETS = 1 << M,                  /* Subsets of those nodes */
+            L = BATCH_LANES
+        };
+
+        /* Compile-time check of the number of nodes */
+        typedef char size_check[(N >= 1 && N <= MAX_BATCH_NODES) ? 1 : -1];
+
+        /* Cost of a path through a node out of its set, as in discorde::tiny::Engine; a path costs at most
+         * MAX_BATCH_NODES * MAX_BATCH_COST in absolute value, so adding one to it cannot overflow */
+        static int unreachable() { return 1 << 30; }
+
+        /* Lower each lane of values to the cost through a predecessor, if cheaper (the kernel of the batch) */
+        static void relax(int* values, const int* from, const int* edge)
+        {
+            int l;
+            int cost, value;
+
+            for (l = 0; l < L; ++l) {
+                cost = from[l] + edge[l];
+                value = values[l];
+                values[l] = (cost < value) ? cost : value;
+            }
+        }
+
+        /* Solve the instances of one group of lanes */
+        template <typename Matrix>
+        void solve_lanes(int n_lanes, const Matrix* cost_matrices, int* out_tours, double* out_costs);
+
+        /* Symmetric copies of the costs, one lane per instance */
+        int cost_[M + 1][M + 1][L];
+
+        /* best_[set][j][lane]: as in discorde::tiny::Engine, for the instance of the lane */
+        int best_[SETS][M][L];
+    };
+
+    template <int N>
+    template <typename Matrix>
+    int BatchEngine<N>::solve(int n_instances, const Matrix* cost_matrices, int* out_tours, double* out_costs)
+    {
+        int first, n_lanes;
+
+        for (first = 0; first < n_instances; first += L) {
+            n_lanes = (n_instances - first < L) ? n_instances - first : L;
+            solve_lanes(n_lanes, cost_matrices + first, out_tours + (size_t) first * N, out_costs + first);
+        }
+
+        return DISCORDE_RETURN_OK;
+    }
+
+    template <int N>
+    template <typename Matrix>
+    void BatchEngine<N>::solve_lanes(int n_lanes, const Matrix* cost_matrices, int* out_tours, double* out_costs)
+    {
+        int i, j, k, l, last;
+        unsigned int set, prev;
+        int value, cost;
+        bool fits;
+        int values[L];           /* Accumulator of the min-reduction, kept in registers */
+
+        if (N == 1) {
+            for (l = 0; l < n_lanes; ++l) {
+                out_tours[l] = 0;
+                out_costs[l] = 0;
+            }
+            return;
+        }
+
+        /* Instances with costs too large for the lanes are solved one at a time */
+        fits = true;
+        for (l = 0; l < n_lanes && fits; ++l) {
+            for (i = 0; i < N && fits; ++i) {
+                for (j = i + 1; j < N && fits; ++j) {
+                    fits = cost_matrices[l][i][j] <= MAX_BATCH_COST && cost_matrices[l][i][j] >= -MAX_BATCH_COST;
+                }
+            }
+        }
+        if (!fits) {
+            for (l = 0; l < n_lanes; ++l) {
+                tiny::solve<N>(cost_matrices[l], out_tours + l * N, out_costs + l);
+            }
+            return;
+        }
+
+        /* Lanes without an instance repeat the first one, so their values stay finite */
+        for (i = 0; i < N; ++i) {
+            for (l = 0; l < L; ++l) {
+                cost_[i][i][l] = 0;
+            }
+            for (j = i + 1; j < N; ++j) {
+                for (l = 0; l < L; ++l) {
+                    cost_[i][j][l] = cost_matrices[(l < n_lanes) ? l : 0][i][j];
+                    cost_[j][i][l] = cost_[i][j][l];
+                }
+            }
+        }
+
+        /* The dynamic program of discorde::tiny::Engine, with the lanes as the innermost loop. The members of a set are
+         * the same in every lane, so the predecessors out of the set are skipped instead of being masked */
+        for (set = 1; set < (unsigned int) SETS; ++set) {
+            for (j = 0; j < M; ++j) {
+                int* into = best_[set][j];
+                if ((set & (1u << j)) == 0) {
+                    for (l = 0; l < L; ++l) {
+                        into[l] = unreachable();
+                    }
+                } else if (set == (1u << j)) {
+                    for (l = 0; l < L; ++l) {
+                        into[l] = cost_[M][j][l];
+                    }
+                } else {
+                    for (l = 0; l < L; ++l) {
+                        values[l] = unreachable();
+                    }
+                    prev = set ^ (1u << j);
+                    for (k = 0; k < M; ++k) {
+                        if ((prev & (1u << k)) == 0) {
+                            continue;
+                        }
+                        relax(values, best_[prev][k], cost_[k][j]);
+                    }
+                    for (l = 0; l < L; ++l) {
+                        into[l] = values[l];
+                    }
+                }
+            }
+        }
+
+        /* Close the paths and walk them back, one instance at a time */
+        for (l = 0; l < n_lanes; ++l) {
+            set = (unsigned int) SETS - 1;
+            last = 0;
+            value = unreachable();
+            for (j = 0; j < M; ++j) {
+                cost = best_[set][j][l] + cost_[j][M][l];
+                if (cost < value) {
+                    value = cost;
+                    last = j;
+                }
+            }
+            out_costs[l] = value;
+
+            out_tours[l * N] = M;
+            for (i = M; i >= 1; --i) {
+                out_tours[l * N + i] = last;
+                prev = set ^ (1u << last);
+                for (k = 0; prev != 0 && k < M; ++k) {
+                    if ((prev & (1u << k)) != 0 && best_[prev][k][l] + cost_[k][last][l] == best_[set][last][l]) {
+                        break;
+                    }
+                }
+                set = prev;
+                last = k;
+            }
+        }
+    }
+
+    /**
+     * Solve a batch of instances of {@code N} nodes (at most {@code discorde::tiny::MAX_BATCH_NODES}) to optimality,
+     * with an engine of its own allocated on the heap. See {@code discorde::tiny::BatchEngine::solve} for the arguments
+     * and the return value.
+     */
+    template <int N, typename Matrix>
+    int solve_batch(int n_instances, const Matrix* cost_matrices, int* out_tours, double* out_costs)
+    {
+        BatchEngine<N>* engine;
+        int return_value;
+
+        engine = new BatchEngine<N>;
+        return_value = engine->solve(n_instances, cost_matrices, out_tours, out_costs);
+        delete engine;
+
+        return return_value;
+    }
+
+    /**
+     * Solve a batch of instances of the same number of nodes (at most {@code discorde::tiny::MAX_BATCH_NODES}) to
+     * optimality, dispatching on the number of nodes to the batch engine compiled for it. Batches of instances of
+     * mixed sizes should be grouped by size by the caller.
+     *
+     * @param   n_nodes
+     *          Number of nodes of every instance.
+     * @param   n_instances
+     *          Number of instances.
+     * @param   cost_matrices
+     *          An array of length {@code n_instances} with the cost matrices, each as in
+     *          {@code discorde::concorde_full}.
+     * @param   out_tours
+     *          An array of length {@code n_instances * n_nodes} to store the optimal tours, the tour of instance
+     *          {@code i} starting at {@code out_tours[i * n_nodes]}.
+     * @param   out_costs
+     *          An array of length {@code n_instances} to store the costs of the optimal tours.
+     *
+     * @return  {@code DISCORDE_RETURN_OK} if the instances have been solved, or {@code DISCORDE_RETURN_TOO_LARGE} if
+     *          they have more than {@code discorde::tiny::MAX_BATCH_NODES} nodes (or no node).
+     */
+    inline int solve_batch(int n_nodes, int n_instances, int*** cost_matrices, int* out_tours, double* out_costs)
+    {
+        switch (n_nodes) {
+            case 1:  return solve_batch<1>(n_instances, cost_matrices, out_tours, out_costs);
+            case 2:  return solve_batch<2>(n_instances, cost_matrices, out_tours, out_costs);
+            case 3:  return solve_batch<3>(n_instances, cost_matrices, out_tours, out_costs);
+            case 4:  return solve_batch<4>(n_instances, cost_matrices, out_tours, out_costs);
+            case 5:  return solve_batch<5>(n_instances, cost_matrices, out_tours, out_costs);
+            case 6:  return solve_batch<6>(n_instances, cost_matrices, out_tours, out_costs);
+            case 7:  return solve_batch<7>(n_instances, cost_matrices, out_tours, out_costs);
+            case 8:  return solve_batch<8>(n_instances, cost_matrices, out_tours, out_costs);
+            case 9:  return solve_batch<9>(n_instances, cost_matrices, out_tours, out_costs);
+            case 10: return solve_batch<10>(n_instances, cost_matrices, out_tours, out_costs);
+            case 11: return solve_batch<11>(n_instances, cost_matrices, out_tours, out_costs);
+            case 12: return solve_batch<12>(n_instances, cost_matrices, out_tours, out_costs);
+            default: return DISCORDE_RETURN_TOO_LARGE;
+        }
+    }
+
+}
+
+}
+
+#endif /* DISCORDE_TINY_H */
@@ -0,0 +1,175 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <discorde.h>
+#include <discorde_internal.h>
+
+/*
+ * Check a batch of jobs of mixed solvers, sizes and matrix layouts against direct calls of the solvers on the same
+ * instances, run on pools of several sizes, and check that the batch restores the setting of the calling thread that
+ * makes its parallel loops run serially. The instances are points on a circle, labelled at random, whose only optimal
+ * tour follows the circle, so the heuristic finds the same tour in the batch and in a direct call.
+ */
+
+#define N_JOBS      18
+#define RADIUS      100000.0
+
+static const int sizes[] = { 5, 8, 12, 20, 40, 80 };
+
+static int n_failures = 0;
+
+static void check(int condition, const char* what, int job)
+{
+    if (!condition) {
+        fprintf(stderr, "FAILED: %s (job %d)\n", what, job);
+        ++n_failures;
+    }
+}
+
+/*
+ * Cost of a tour over a cost matrix, or -1 if it is not a permutation of the nodes.
+ */
+static double tour_cost(int n_nodes, int** cost_matrix, const int* tour)
+{
+    int i;
+    int* seen;
+    double cost;
+
+    seen = (int*) calloc((size_t) n_nodes, sizeof(int));
+    cost = 0;
+    for (i = 0; i < n_nodes; ++i) {
+        if (tour[i] < 0 || tour[i] >= n_nodes || seen[tour[i]]) {
+            free(seen);
+            return -1;
+        }
+        seen[tour[i]] = 1;
+        cost += cost_matrix[tour[i]][tour[(i + 1) % n_nodes]];
+    }
+    free(seen);
+
+    return cost;
+}
+
+/*
+ * Fill a cost matrix (in rows, flat and packed layouts) with the rounded distances between {@code n_nodes} points on a
+ * circle, each point given a random node.
+ */
+static void circle_instance(int n_nodes, int** cost_matrix, int* flat, int* packed)
+{
+    int i, j, k, swap;
+    int* node_of;
+    double dx, dy, angle_i, angle_j;
+
+    node_of = (int*) malloc(sizeof(int) * (size_t) n_nodes);
+    for (i = 0; i < n_nodes; ++i) {
+        node_of[i] = i;
+    }
+    for (i = n_nodes - 1; i > 0; --i) {
+        j = rand() % (i + 1);
+        swap = node_of[i];
+        node_of[i] = node_of[j];
+        node_of[j] = swap;
+    }
+
+    for (i = 0; i < n_nodes; ++i) {
+        for (j = 0; j < n_nodes; ++j) {
+            angle_i = 2 * 3.14159265358979 * node_of[i] / n_nodes;
+            angle_j = 2 * 3.14159265358979 * node_of[j] / n_nodes;
+            dx = RADIUS * (cos(angle_i) - cos(angle_j));
+            dy = RADIUS * (sin(angle_i) - sin(angle_j));
+            cost_matrix[i][j] = (i == j) ? 0 : (int) (sqrt(dx * dx + dy * dy) + 0.5);
+            flat[i * n_nodes + j] = cost_matrix[i][j];
+        }
+    }
+    k = 0;
+    for (i = 0; i < n_nodes; ++i) {
+        for (j = i + 1; j < n_nodes; ++j) {
+            packed[k++] = cost_matrix[i][j];
+        }
+    }
+
+    free(node_of);
+}
+
+int main(void)
+{
+    int i, j, n, n_threads, serial, return_value, status;
+    int** matrices[N_JOBS];
+    int* flats[N_JOBS];
+    int* packeds[N_JOBS];
+    int* tour;
+    double cost;
+    discorde_job jobs[N_JOBS];
+
+    srand(0);
+
+    /* Jobs of every size, alternating the solvers and the layouts */
+    for (i = 0; i < N_JOBS; ++i) {
+        n = sizes[i % (sizeof(sizes) / sizeof(sizes[0]))];
+        matrices[i] = (int**) malloc(sizeof(int*) * (size_t) n);
+        for (j = 0; j < n; ++j) {
+            matrices[i][j] = (int*) malloc(sizeof(int) * (size_t) n);
+        }
+        flats[i] = (int*) malloc(sizeof(int) * (size_t) n * n);
+        packeds[i] = (int*) malloc(sizeof(int) * (size_t) n * (n - 1) / 2);
+        circle_instance(n, matrices[i], flats[i], packeds[i]);
+
+        discorde_job_init(&jobs[i]);
+        jobs[i].n_nodes = n;
+        jobs[i].solver = (i % 2 == 0) ? DISCORDE_SOLVER_CONCORDE : DISCORDE_SOLVER_LINKERNIGHAN;
+        jobs[i].matrix_layout = (i / 2) % 3 == 0 ? DISCORDE_MATRIX_ROWS
+                                : (i / 2) % 3 == 1 ? DISCORDE_MATRIX_FLAT : DISCORDE_MATRIX_PACKED;
+        jobs[i].cost_matrix = matrices[i];
+        jobs[i].cost_buffer = (jobs[i].matrix_layout == DISCORDE_MATRIX_FLAT) ? flats[i] : packeds[i];
+        jobs[i].out_tour = (int*) malloc(sizeof(int) * (size_t) n);
+    }
+
+    for (n_threads = 1; n_threads <= 4; n_threads += 3) {
+        for (serial = 0; serial <= 1; ++serial) {
+
+            /* The batch restores the setting of the calling thread, whatever it was */
+            discorde_parallel_set_serial(serial);
+            return_value = discorde_solve_batch(jobs, N_JOBS, n_threads);
+            check(discorde_parallel_set_serial(0) == serial, "the serial setting of the caller is restored", -1);
+            check(return_value == DISCORDE_RETURN_OK, "the batch is solved", -1);
+
+            /* Each job matches a direct call of its solver */
+            for (i = 0; i < N_JOBS; ++i) {
+                n = jobs[i].n_nodes;
+                tour = (int*) malloc(sizeof(int) * (size_t) n);
+                status = DISCORDE_STATUS_UNKNOWN;
+                if (jobs[i].solver == DISCORDE_SOLVER_CONCORDE) {
+                    return_value = concorde_full(n, matrices[i], tour, &cost, &status, NULL, false, NULL, NULL);
+                } else {
+                    return_value = linkernighan_full_monitored(n, matrices[i], NULL, tour, &cost, NULL, false, NULL,
+                                                               NULL);
+                }
+                check(jobs[i].return_value == return_value, "the job returns as the direct call", i);
+                check(jobs[i].out_status == status, "the job has the status of the direct call", i);
+                check(tour_cost(n, matrices[i], jobs[i].out_tour) == jobs[i].out_cost,
+                      "the cost of the job is the cost of its tour", i);
+                check(tour_cost(n, matrices[i], tour) == cost, "the cost of the direct call is the cost of its tour",
+                      i);
+                check(jobs[i].out_cost == cost, "the job finds the tour of the direct call", i);
+                free(tour);
+            }
+        }
+    }
+
+    for (i = 0; i < N_JOBS; ++i) {
+        for (j = 0; j < jobs[i].n_nodes; ++j) {
+            free(matrices[i][j]);
+        }
+        free(matrices[i]);
+        free(flats[i]);
+        free(packeds[i]);
+        free(jobs[i].out_tour);
+    }
+
+    if (n_failures > 0) {
+        fprintf(stderr, "%d checks failed\n", n_failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
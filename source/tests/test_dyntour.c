@@ -0,0 +1,195 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <discorde.h>
+
+/*
+ * Check a dynamic tour after each change of a random sequence of insertions and removals: the tour holds exactly the
+ * nodes inserted and not removed, each node is known to be in the tour or out of it, the cost is the cost of the tour,
+ * and a repair only reorders the window of the change, whose endpoints stay in place.
+ */
+
+#define N_NODES     150
+#define K_NEAREST   8
+#define RADIUS      5
+#define N_CHANGES   3000
+
+static int n_failures = 0;
+
+static void check(int condition, const char* what, int change)
+{
+    if (!condition) {
+        fprintf(stderr, "FAILED: %s (change %d)\n", what, change);
+        ++n_failures;
+    }
+}
+
+/*
+ * Return whether the edges of {@code tour} that are not edges of the previous tour (given by the neighbors of each node
+ * in it, or -1 for the nodes out of it) lie within 2 * RADIUS consecutive edges, i.e., within the window of a single
+ * repair, whose endpoints are kept. Tours short enough to be repaired as a whole are not checked.
+ */
+static int changes_in_window(int length, const int* tour, const int* prev_next, const int* prev_prev)
+{
+    int i, u, v, first, last, gap, max_gap;
+
+    if (length <= 2 * RADIUS + 2) {
+        return 1;
+    }
+
+    first = -1;
+    last = -1;
+    max_gap = 0;
+    for (i = 0; i < length; ++i) {
+        u = tour[i];
+        v = tour[(i + 1) % length];
+        if (prev_next[u] == v || prev_prev[u] == v) {
+            continue;
+        }
+        if (first < 0) {
+            first = i;
+        } else if (i - last > max_gap) {
+            max_gap = i - last;
+        }
+        last = i;
+    }
+    if (first < 0) {
+        return 1;
+    }
+    gap = first + length - last;
+    max_gap = (gap > max_gap) ? gap : max_gap;
+
+    /* The changed edges span the tour but for its largest run of unchanged edges */
+    return length - max_gap + 1 <= 2 * RADIUS;
+}
+
+int main(void)
+{
+    int i, j, change, node, length, prev_length, n_insert, single, return_value;
+    int** cost_matrix;
+    double x[N_NODES], y[N_NODES];
+    int in_tour[N_NODES];           /* Whether each node should be in the tour */
+    int prev_next[N_NODES];         /* Neighbors of each node in the tour before the change, or -1 */
+    int prev_prev[N_NODES];
+    int tour[N_NODES];
+    int seen[N_NODES];
+    int batch[4];
+    double dx, dy, cost, recomputed;
+    discorde_dyntour* dyntour;
+
+    srand(0);
+
+    /* Random points in the plane, with rounded Euclidean costs */
+    cost_matrix = (int**) malloc(sizeof(int*) * N_NODES);
+    for (i = 0; i < N_NODES; ++i) {
+        x[i] = rand() % 1000;
+        y[i] = rand() % 1000;
+        cost_matrix[i] = (int*) malloc(sizeof(int) * N_NODES);
+    }
+    for (i = 0; i < N_NODES; ++i) {
+        for (j = 0; j < N_NODES; ++j) {
+            dx = x[i] - x[j];
+            dy = y[i] - y[j];
+            cost_matrix[i][j] = (int) (sqrt(dx * dx + dy * dy) + 0.5);
+        }
+    }
+
+    if (discorde_dyntour_create(N_NODES, cost_matrix, 0, NULL, K_NEAREST, RADIUS, &dyntour) != DISCORDE_RETURN_OK) {
+        fprintf(stderr, "FAILED: the dynamic tour is created\n");
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < N_NODES; ++i) {
+        in_tour[i] = 0;
+    }
+
+    length = 0;
+    for (change = 0; change < N_CHANGES; ++change) {
+
+        /* Neighbors of each node in the tour before the change */
+        for (i = 0; i < N_NODES; ++i) {
+            prev_next[i] = -1;
+            prev_prev[i] = -1;
+        }
+        discorde_dyntour_get(dyntour, tour, &cost);
+        for (i = 0; i < length; ++i) {
+            prev_next[tour[i]] = tour[(i + 1) % length];
+            prev_prev[tour[(i + 1) % length]] = tour[i];
+        }
+        prev_length = length;
+
+        /* Insert a batch of nodes out of the tour, or remove a node of the tour */
+        if (length == 0 || (length < N_NODES && rand() % 2 == 0)) {
+            n_insert = (rand() % 3 == 0) ? 1 + rand() % 4 : 1;
+            for (i = 0; i < n_insert && length + i < N_NODES; ++i) {
+                do {
+                    node = rand() % N_NODES;
+                } while (in_tour[node]);
+                in_tour[node] = 1;
+                batch[i] = node;
+            }
+            n_insert = i;
+            return_value = discorde_dyntour_insert(dyntour, n_insert, batch, rand() % 2 == 0);
+            check(return_value == DISCORDE_RETURN_OK, "the nodes are inserted", change);
+            length += n_insert;
+            single = n_insert == 1;
+        } else {
+            do {
+                node = rand() % N_NODES;
+            } while (!in_tour[node]);
+            in_tour[node] = 0;
+            return_value = discorde_dyntour_remove(dyntour, node);
+            check(return_value == DISCORDE_RETURN_OK, "the node is removed", change);
+            --length;
+            single = 1;
+        }
+
+        /* The tour holds the nodes inserted and not removed, each once */
+        check(discorde_dyntour_length(dyntour) == length, "the length is the number of nodes", change);
+        if (discorde_dyntour_length(dyntour) != length) {
+            break;
+        }
+        discorde_dyntour_get(dyntour, tour, &cost);
+        for (i = 0; i < N_NODES; ++i) {
+            seen[i] = 0;
+        }
+        recomputed = 0;
+        for (i = 0; i < length; ++i) {
+            check(tour[i] >= 0 && tour[i] < N_NODES && in_tour[tour[i]] && !seen[tour[i]],
+                  "the tour holds the nodes inserted and not removed, each once", change);
+            if (tour[i] >= 0 && tour[i] < N_NODES) {
+                seen[tour[i]] = 1;
+            }
+            recomputed += cost_matrix[tour[i]][tour[(i + 1) % length]];
+        }
+        check(cost == recomputed, "the cost is the cost of the tour", change);
+
+        /* Each node is found in the tour or out of it (a node of the tour cannot be inserted, one out of it removed) */
+        node = rand() % N_NODES;
+        if (in_tour[node]) {
+            check(discorde_dyntour_insert(dyntour, 1, &node, false) == DISCORDE_RETURN_FAILURE,
+                  "a node of the tour cannot be inserted", change);
+        } else {
+            check(discorde_dyntour_remove(dyntour, node) == DISCORDE_RETURN_FAILURE,
+                  "a node out of the tour cannot be removed", change);
+        }
+
+        /* A single change only reorders the window around it */
+        if (single && prev_length > 0) {
+            check(changes_in_window(length, tour, prev_next, prev_prev), "the endpoints of the window stay in place",
+                  change);
+        }
+    }
+
+    discorde_dyntour_free(dyntour);
+    for (i = 0; i < N_NODES; ++i) {
+        free(cost_matrix[i]);
+    }
+    free(cost_matrix);
+
+    if (n_failures > 0) {
+        fprintf(stderr, "%d checks failed\n", n_failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
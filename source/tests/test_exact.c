@@ -0,0 +1,154 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <discorde.h>
+
+/*
+ * Check the instances of at most 12 nodes, which concorde solves by a dynamic program, against a brute-force
+ * enumeration of their tours: complete lists of edges and sparse ones, some of which have no tour at all.
+ */
+
+#define MAX_NODES   12
+#define NO_EDGE     -1      /* Cost of a pair of nodes that is not an edge of the list (costs are non-negative) */
+
+static int n_failures = 0;
+
+static void check(int condition, const char* what, int n_nodes, int instance)
+{
+    if (!condition) {
+        fprintf(stderr, "FAILED: %s (%d nodes, instance %d)\n", what, n_nodes, instance);
+        ++n_failures;
+    }
+}
+
+/*
+ * Enumerate the tours that extend a path of {@code depth} nodes from node 0 to {@code last} of cost {@code length},
+ * keeping the cost of the cheapest in {@code best} (-1 while none is known). Costs are non-negative, so a path that
+ * already costs as much as the best tour is not extended.
+ */
+static void brute_force(int n_nodes, int costs[MAX_NODES][MAX_NODES], int* visited, int depth, int last,
+                        long length, long* best)
+{
+    int v;
+
+    if (*best >= 0 && length >= *best) {
+        return;
+    }
+    if (depth == n_nodes) {
+        if (costs[last][0] != NO_EDGE && (*best < 0 || length + costs[last][0] < *best)) {
+            *best = length + costs[last][0];
+        }
+        return;
+    }
+
+    for (v = 1; v < n_nodes; ++v) {
+        if (!visited[v] && costs[last][v] != NO_EDGE) {
+            visited[v] = 1;
+            brute_force(n_nodes, costs, visited, depth + 1, v, length + costs[last][v], best);
+            visited[v] = 0;
+        }
+    }
+}
+
+/*
+ * Cost of a tour over the edges of the instance, or -1 if it is not a permutation of the nodes or uses a pair of nodes
+ * that is not an edge.
+ */
+static long tour_cost(int n_nodes, int costs[MAX_NODES][MAX_NODES], const int* tour)
+{
+    int i, u, v;
+    int seen[MAX_NODES];
+    long cost;
+
+    for (i = 0; i < n_nodes; ++i) {
+        seen[i] = 0;
+    }
+    cost = 0;
+    for (i = 0; i < n_nodes; ++i) {
+        u = tour[i];
+        v = tour[(i + 1) % n_nodes];
+        if (u < 0 || u >= n_nodes || seen[u] || v < 0 || v >= n_nodes || costs[u][v] == NO_EDGE) {
+            return -1;
+        }
+        seen[u] = 1;
+        cost += costs[u][v];
+    }
+
+    return cost;
+}
+
+/*
+ * Solve one random instance of {@code n_nodes} nodes whose pairs are edges with probability {@code density} percent,
+ * and compare the result of concorde with the brute-force optimum.
+ */
+static void check_instance(int n_nodes, int density, int instance)
+{
+    int i, j, n_edges, status, return_value;
+    int costs[MAX_NODES][MAX_NODES];
+    int visited[MAX_NODES];
+    int edges[MAX_NODES * (MAX_NODES - 1)];
+    int edges_costs[MAX_NODES * (MAX_NODES - 1) / 2];
+    int tour[MAX_NODES];
+    long optimum;
+    double cost;
+
+    /* Random edges, listed with their endpoints in either order */
+    n_edges = 0;
+    for (i = 0; i < n_nodes; ++i) {
+        costs[i][i] = NO_EDGE;
+        for (j = i + 1; j < n_nodes; ++j) {
+            costs[i][j] = NO_EDGE;
+            if (rand() % 100 < density) {
+                costs[i][j] = rand() % 1000;
+                edges[2 * n_edges] = (rand() % 2 == 0) ? i : j;
+                edges[2 * n_edges + 1] = (edges[2 * n_edges] == i) ? j : i;
+                edges_costs[n_edges] = costs[i][j];
+                ++n_edges;
+            }
+            costs[j][i] = costs[i][j];
+        }
+    }
+
+    for (i = 0; i < n_nodes; ++i) {
+        visited[i] = 0;
+    }
+    optimum = -1;
+    brute_force(n_nodes, costs, visited, 1, 0, 0, &optimum);
+
+    status = DISCORDE_STATUS_UNKNOWN;
+    return_value = concorde(n_nodes, n_edges, edges, edges_costs, tour, &cost, &status, NULL, false, NULL, NULL);
+
+    if (optimum < 0) {
+        check(return_value == DISCORDE_RETURN_FAILURE, "an instance without tour is rejected", n_nodes, instance);
+        return;
+    }
+    check(return_value == DISCORDE_RETURN_OK, "a tour is found", n_nodes, instance);
+    if (return_value != DISCORDE_RETURN_OK) {
+        return;
+    }
+    check(status == DISCORDE_STATUS_OPTIMAL, "the tour is proven optimal", n_nodes, instance);
+    check(tour_cost(n_nodes, costs, tour) >= 0, "the tour is a permutation over the edges", n_nodes, instance);
+    check(tour_cost(n_nodes, costs, tour) == (long) cost, "the cost is the cost of the tour", n_nodes, instance);
+    check((long) cost == optimum, "the cost is the brute-force optimum", n_nodes, instance);
+}
+
+int main(void)
+{
+    int n_nodes, instance;
+
+    srand(0);
+
+    for (n_nodes = 3; n_nodes <= MAX_NODES; ++n_nodes) {
+        for (instance = 0; instance < 20; ++instance) {
+            check_instance(n_nodes, 100, instance);
+            check_instance(n_nodes, 60, instance);
+            check_instance(n_nodes, 30, instance);
+        }
+    }
+
+    if (n_failures > 0) {
+        fprintf(stderr, "%d checks failed\n", n_failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
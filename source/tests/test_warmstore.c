@@ -0,0 +1,240 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <discorde.h>
+
+/*
+ * Check the projection of a warm-start store onto new node sets, given by a cost matrix and by a sparse list of edges:
+ * the result is a permutation of the new nodes and the nodes kept from the saved tour keep their cyclic order, whether
+ * the nodes are all kept, all new (every node of the saved tour gone) or mixed, and whether the saved tour repeats IDs.
+ * Invalid projections (empty store, no nodes, repeated IDs in the new node set) fail.
+ */
+
+#define MAX_NODES   60
+#define N_TRIALS    200
+
+static int n_failures = 0;
+
+static void check(int condition, const char* what, int trial)
+{
+    if (!condition) {
+        fprintf(stderr, "FAILED: %s (trial %d)\n", what, trial);
+        ++n_failures;
+    }
+}
+
+/*
+ * Return whether {@code tour} is a permutation of the {@code n_nodes} nodes.
+ */
+static int is_permutation(int n_nodes, const int* tour)
+{
+    int i;
+    int seen[MAX_NODES];
+
+    for (i = 0; i < n_nodes; ++i) {
+        seen[i] = 0;
+    }
+    for (i = 0; i < n_nodes; ++i) {
+        if (tour[i] < 0 || tour[i] >= n_nodes || seen[tour[i]]) {
+            return 0;
+        }
+        seen[tour[i]] = 1;
+    }
+
+    return 1;
+}
+
+/*
+ * Return whether the IDs of the nodes of {@code tour} that are in the saved tour appear in the cyclic order of the
+ * saved tour (of the first occurrence of a repeated ID), starting anywhere.
+ */
+static int keeps_order(int n_saved, const long* saved_ids, int n_nodes, const long* node_ids, const int* tour)
+{
+    int i, j, n_kept, start;
+    long kept[MAX_NODES];       /* IDs of the saved tour still present, in its order */
+    long projected[MAX_NODES];  /* IDs of the projected tour that were in the saved tour, in its order */
+    int n_projected;
+
+    n_kept = 0;
+    for (i = 0; i < n_saved; ++i) {
+        for (j = 0; j < n_kept && kept[j] != saved_ids[i]; ++j);
+        if (j < n_kept) {
+            continue;
+        }
+        for (j = 0; j < n_nodes && node_ids[j] != saved_ids[i]; ++j);
+        if (j < n_nodes) {
+            kept[n_kept++] = saved_ids[i];
+        }
+    }
+    n_projected = 0;
+    for (i = 0; i < n_nodes; ++i) {
+        for (j = 0; j < n_saved && saved_ids[j] != node_ids[tour[i]]; ++j);
+        if (j < n_saved) {
+            projected[n_projected++] = node_ids[tour[i]];
+        }
+    }
+    if (n_kept != n_projected) {
+        return 0;
+    }
+    if (n_kept == 0) {
+        return 1;
+    }
+
+    for (start = 0; start < n_kept && kept[start] != projected[0]; ++start);
+    for (i = 0; i < n_kept; ++i) {
+        if (start == n_kept || kept[(start + i) % n_kept] != projected[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/*
+ * Project the store onto a node set through a random cost matrix and through a random sparse list of edges, and check
+ * both results. The same node set with a repeated ID is rejected by both.
+ */
+static void check_projection(const discorde_warmstore* store, int n_saved, const long* saved_ids, int n_nodes,
+                             long* node_ids, int trial)
+{
+    int i, j, n_edges;
+    long id;
+    int** cost_matrix;
+    int edges[MAX_NODES * (MAX_NODES - 1)];
+    int edges_costs[MAX_NODES * (MAX_NODES - 1) / 2];
+    int tour[MAX_NODES];
+
+    cost_matrix = (int**) malloc(sizeof(int*) * n_nodes);
+    for (i = 0; i < n_nodes; ++i) {
+        cost_matrix[i] = (int*) malloc(sizeof(int) * n_nodes);
+    }
+    n_edges = 0;
+    for (i = 0; i < n_nodes; ++i) {
+        cost_matrix[i][i] = 0;
+        for (j = i + 1; j < n_nodes; ++j) {
+            cost_matrix[i][j] = rand() % 1000;
+            cost_matrix[j][i] = cost_matrix[i][j];
+            if (rand() % 4 == 0) {
+                edges[2 * n_edges] = i;
+                edges[2 * n_edges + 1] = j;
+                edges_costs[n_edges] = cost_matrix[i][j];
+                ++n_edges;
+            }
+        }
+    }
+
+    check(discorde_warmstore_project_full(store, n_nodes, node_ids, cost_matrix, tour) == DISCORDE_RETURN_OK,
+          "the tour is projected onto a matrix", trial);
+    check(is_permutation(n_nodes, tour), "the projection onto a matrix is a permutation", trial);
+    check(keeps_order(n_saved, saved_ids, n_nodes, node_ids, tour), "the projection onto a matrix keeps the order",
+          trial);
+
+    check(discorde_warmstore_project(store, n_nodes, node_ids, n_edges, edges, edges_costs, tour) == DISCORDE_RETURN_OK,
+          "the tour is projected onto a list of edges", trial);
+    check(is_permutation(n_nodes, tour), "the projection onto a list of edges is a permutation", trial);
+    check(keeps_order(n_saved, saved_ids, n_nodes, node_ids, tour),
+          "the projection onto a list of edges keeps the order", trial);
+
+    if (n_nodes > 1) {
+        id = node_ids[n_nodes - 1];
+        node_ids[n_nodes - 1] = node_ids[0];
+        check(discorde_warmstore_project_full(store, n_nodes, node_ids, cost_matrix, tour) == DISCORDE_RETURN_FAILURE,
+              "repeated IDs are rejected with a matrix", trial);
+        check(discorde_warmstore_project(store, n_nodes, node_ids, n_edges, edges, edges_costs, tour)
+              == DISCORDE_RETURN_FAILURE, "repeated IDs are rejected with a list of edges", trial);
+        node_ids[n_nodes - 1] = id;
+    }
+
+    for (i = 0; i < n_nodes; ++i) {
+        free(cost_matrix[i]);
+    }
+    free(cost_matrix);
+}
+
+int main(void)
+{
+    int i, j, trial, n_saved, n_nodes, n_kept, n_new, swap;
+    long id;
+    long ids[MAX_NODES];        /* IDs of the nodes of the saved instance */
+    long saved_ids[MAX_NODES];  /* IDs of the saved tour, in its order */
+    long node_ids[MAX_NODES];   /* IDs of the nodes of the new instance */
+    int tour[MAX_NODES];
+    int single_cost[1];
+    int* single_row[1];         /* Cost matrix of a single node */
+    discorde_warmstore* store;
+
+    srand(0);
+
+    if (discorde_warmstore_create(&store) != DISCORDE_RETURN_OK) {
+        fprintf(stderr, "FAILED: the store is created\n");
+        return EXIT_FAILURE;
+    }
+
+    /* An empty store has nothing to project */
+    node_ids[0] = 1;
+    single_cost[0] = 0;
+    single_row[0] = single_cost;
+    check(discorde_warmstore_project_full(store, 1, node_ids, single_row, tour) == DISCORDE_RETURN_FAILURE,
+          "an empty store is not projected", -1);
+
+    for (trial = 0; trial < N_TRIALS; ++trial) {
+
+        /* Save a random tour of a random instance (some trials repeat IDs in it) */
+        n_saved = 1 + rand() % MAX_NODES;
+        for (i = 0; i < n_saved; ++i) {
+            ids[i] = 1000 + 7 * i;
+            tour[i] = i;
+        }
+        if (trial % 10 == 0 && n_saved > 1) {
+            ids[n_saved - 1] = ids[0];
+        }
+        for (i = n_saved - 1; i > 0; --i) {
+            j = rand() % (i + 1);
+            swap = tour[i];
+            tour[i] = tour[j];
+            tour[j] = swap;
+        }
+        check(discorde_warmstore_save(store, n_saved, ids, tour) == DISCORDE_RETURN_OK, "the tour is saved", trial);
+        for (i = 0; i < n_saved; ++i) {
+            saved_ids[i] = ids[tour[i]];
+        }
+
+        /* New node set: all the saved nodes, none of them (all new) or a random part, plus new nodes */
+        n_nodes = 0;
+        n_kept = (trial % 3 == 0) ? n_saved : (trial % 3 == 1) ? 0 : rand() % (n_saved + 1);
+        for (i = 0; i < n_saved && n_nodes < n_kept; ++i) {
+            if ((i > 0 && ids[i] == ids[0]) || (n_kept < n_saved && rand() % 2 == 0)) {
+                continue;
+            }
+            node_ids[n_nodes++] = ids[i];
+        }
+        n_new = (trial % 3 == 0) ? 0 : rand() % (MAX_NODES - n_nodes + 1);
+        if (n_nodes + n_new == 0) {
+            n_new = 1;
+        }
+        for (i = 0; i < n_new; ++i) {
+            node_ids[n_nodes] = 5000 + n_nodes;
+            ++n_nodes;
+        }
+        for (i = n_nodes - 1; i > 0; --i) {
+            j = rand() % (i + 1);
+            id = node_ids[i];
+            node_ids[i] = node_ids[j];
+            node_ids[j] = id;
+        }
+
+        check_projection(store, n_saved, saved_ids, n_nodes, node_ids, trial);
+
+        /* A projection needs at least one node */
+        check(discorde_warmstore_project_full(store, 0, node_ids, single_row, tour) == DISCORDE_RETURN_FAILURE,
+              "an empty node set is rejected", trial);
+    }
+
+    discorde_warmstore_free(store);
+
+    if (n_failures > 0) {
+        fprintf(stderr, "%d checks failed\n", n_failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}